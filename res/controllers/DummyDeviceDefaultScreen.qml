@@ -39,7 +39,9 @@ Mixxx.ControllerScreen {
         loader.sourceComponent = splash
     }
 
-    // function transformFrame(input: ArrayBuffer, timestamp: date) {
+    // function transformFrame(input: ArrayBuffer, timestamp: date, region: object) {
+    // The region ({x, y, width, height}) is only passed to screens declared
+    // with partialUpdate="true". The input then only contains its pixels.
     transformFrame: function(input, timestamp) {
         return new ArrayBuffer(0);
     }
@@ -35,6 +35,25 @@ class Analyzer {
     // but not finalize()!
     virtual bool processSamples(const CSAMPLE* pIn, SINT count) = 0;
 
+    // Analyzers that return true are initialized with the channel count of
+    // multichannel (stem) sources and receive all channels together with
+    // their stereo mix in processStemSamples(). All other analyzers are
+    // initialized with a stereo channel count and only receive the stereo
+    // mix, which is mixed down once per chunk for all analyzers.
+    virtual bool supportsStems() const {
+        return false;
+    }
+
+    // Analyze the next chunk of a multichannel (stem) source. pStereoMix
+    // contains the stereo mix of all channels in pIn, i.e. count divided
+    // by the channel count stereo frames.
+    virtual bool processStemSamples(const CSAMPLE* pIn,
+            SINT count,
+            const CSAMPLE* pStereoMix) {
+        Q_UNUSED(pStereoMix);
+        return processSamples(pIn, count);
+    }
+
     // Update the track object with the analysis results after
     // processing finished successfully, i.e. all available audio
     // samples have been processed.
@@ -52,7 +71,8 @@ class AnalyzerWithState final {
   public:
     explicit AnalyzerWithState(AnalyzerPtr analyzer)
             : m_analyzer(std::move(analyzer)),
-              m_active(false) {
+              m_active(false),
+              m_supportsStems(false) {
         DEBUG_ASSERT(m_analyzer);
     }
     AnalyzerWithState(const AnalyzerWithState&) = delete;
@@ -72,6 +92,12 @@ class AnalyzerWithState final {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) {
         DEBUG_ASSERT(!m_active);
+        // Might depend on the settings that could change during the analysis
+        m_supportsStems = m_analyzer->supportsStems();
+        if (channelCount > mixxx::audio::ChannelCount::stereo() && !m_supportsStems) {
+            // Only receives the stereo mix
+            channelCount = mixxx::audio::ChannelCount::stereo();
+        }
         return m_active = m_analyzer->initialize(track, sampleRate, channelCount, frameLength);
     }
 
@@ -86,6 +112,24 @@ class AnalyzerWithState final {
         }
     }
 
+    void processStemSamples(const CSAMPLE* pIn,
+            const int count,
+            const CSAMPLE* pStereoMix,
+            const int stereoCount) {
+        if (m_active) {
+            if (m_supportsStems) {
+                m_active = m_analyzer->processStemSamples(pIn, count, pStereoMix);
+            } else {
+                m_active = m_analyzer->processSamples(pStereoMix, stereoCount);
+            }
+            if (!m_active) {
+                // Ensure that cleanup() is invoked after processing
+                // failed and the analyzer became inactive!
+                m_analyzer->cleanup();
+            }
+        }
+    }
+
     void finish(const AnalyzerTrack& track) {
         if (m_active) {
             m_analyzer->storeResults(track.getTrack());
@@ -104,4 +148,5 @@ class AnalyzerWithState final {
   private:
     AnalyzerPtr m_analyzer;
     bool m_active;
+    bool m_supportsStems;
 };
@@ -24,6 +24,12 @@ class AnalyzerBeats : public Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool supportsStems() const override {
+        // Only the drum stem is analyzed if enforced, otherwise the stereo mix of
+        // all stems is sufficient
+        return m_bpmSettings.getStemStrategy() ==
+                BeatDetectionSettings::StemStrategy::Enforced;
+    }
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
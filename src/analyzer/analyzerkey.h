@@ -23,6 +23,12 @@ class AnalyzerKey : public Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* pIn, SINT count) override;
+    bool supportsStems() const override {
+        // The drum stem is excluded if enforced, otherwise the stereo mix of
+        // all stems is sufficient
+        return m_keySettings.getStemStrategy() ==
+                KeyDetectionSettings::StemStrategy::Enforced;
+    }
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
@@ -8,15 +8,19 @@
 #include "analyzer/analyzerkey.h"
 #include "analyzer/analyzersilence.h"
 #include "analyzer/analyzerwaveform.h"
+#include "analyzer/audiodigest.h"
 #include "analyzer/constants.h"
 #include "library/dao/analysisdao.h"
 #include "moc_analyzerthread.cpp"
 #include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
+#include "track/beats.h"
+#include "track/keyfactory.h"
 #include "track/track.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
+#include "util/sample.h"
 
 namespace {
 
@@ -83,24 +87,26 @@ AnalyzerThread::AnalyzerThread(
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
           m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
+          m_stereoMixBuffer(mixxx::kAnalysisFramesPerChunk * mixxx::kAnalysisChannels),
           m_emittedState(AnalyzerThreadState::Void) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
 
 void AnalyzerThread::doRun() {
-    std::unique_ptr<AnalysisDao> pAnalysisDao;
     // The thread-local database connection  must not be closed
-    // before returning from this function.
-    mixxx::DbConnectionPooler dbConnectionPooler;
+    // before returning from this function. It is needed for storing
+    // waveforms and for looking up tracks by their audio digest.
+    mixxx::DbConnectionPooler dbConnectionPooler(m_dbConnectionPool);
+    if (!dbConnectionPooler.isPooling()) {
+        kLogger.warning()
+                << "Failed to obtain database connection for analyzer thread";
+        return;
+    }
+    QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
+    AnalysisDao analysisDao(m_pConfig);
+    analysisDao.initialize(dbConnection);
 
     if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
-        dbConnectionPooler = mixxx::DbConnectionPooler(m_dbConnectionPool); // move assignment
-        if (!dbConnectionPooler.isPooling()) {
-            kLogger.warning()
-                    << "Failed to obtain database connection for analyzer thread";
-            return;
-        }
-        QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
         m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
     }
     if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
@@ -145,6 +151,12 @@ void AnalyzerThread::doRun() {
                     mixxx::kAnalysisFramesPerChunk);
         }
 
+        // Analysis results of previously analyzed tracks with the same
+        // audio content are restored before initializing the analyzers.
+        // Those will then skip the analysis if the restored results are
+        // still valid.
+        restoreAnalysisResultsByAudioDigest(audioSource, &analysisDao);
+
         bool processTrack = false;
         for (auto&& analyzer : m_analyzers) {
             // Make sure not to short-circuit initialize(...)
@@ -208,6 +220,98 @@ bool AnalyzerThread::submitNextTrack(const AnalyzerTrack& nextTrack) {
     return false;
 }
 
+void AnalyzerThread::restoreAnalysisResultsByAudioDigest(
+        const mixxx::AudioSourcePointer& audioSource,
+        AnalysisDao* pAnalysisDao) {
+    DEBUG_ASSERT(m_currentTrack.has_value());
+    const TrackPointer& pTrack = m_currentTrack->getTrack();
+    const TrackId trackId = pTrack->getId();
+    if (!trackId.isValid()) {
+        return;
+    }
+    // Tracks that already have a digest are known to the index and
+    // their results are missing intentionally, e.g. after the user
+    // cleared the beats for reanalysis. Only newly added tracks need
+    // to be looked up.
+    if (mixxx::isValidCacheKey(pAnalysisDao->getAudioDigest(trackId))) {
+        return;
+    }
+
+    PerformanceTimer timer;
+    timer.start();
+    const mixxx::cache_key_t audioDigest =
+            mixxx::calculateAudioDigest(audioSource, &m_sampleBuffer);
+    if (!mixxx::isValidCacheKey(audioDigest)) {
+        kLogger.warning()
+                << "Failed to calculate audio digest of"
+                << pTrack->getLocation();
+        return;
+    }
+    const auto results =
+            pAnalysisDao->findTrackAnalysisResultsByAudioDigest(
+                    audioDigest, trackId);
+    pAnalysisDao->saveAudioDigest(trackId, audioDigest);
+    if (!results) {
+        kLogger.debug()
+                << "Calculated audio digest of"
+                << pTrack->getLocation()
+                << "in"
+                << timer.elapsed().debugMillisWithUnit();
+        return;
+    }
+    kLogger.info()
+            << "Restoring analysis results of track"
+            << results->trackId
+            << "for"
+            << pTrack->getLocation();
+
+    restoreTrackAnalysisResults(pTrack.get(),
+            audioSource->getSignalInfo().getSampleRate(),
+            *results);
+    if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
+        pAnalysisDao->copyAnalyses(results->trackId, trackId);
+    }
+}
+
+//static
+void AnalyzerThread::restoreTrackAnalysisResults(
+        Track* pTrack,
+        mixxx::audio::SampleRate sampleRate,
+        const AnalysisDao::TrackAnalysisResults& results) {
+    if (!pTrack->getBeats() && !results.beatsVersion.isEmpty()) {
+        const mixxx::BeatsPointer pBeats = mixxx::Beats::fromByteArray(
+                sampleRate,
+                results.beatsVersion,
+                results.beatsSubVersion,
+                results.beatsBlob);
+        if (pBeats) {
+            if (results.bpmLocked) {
+                pTrack->trySetAndLockBeats(pBeats);
+            } else {
+                pTrack->trySetBeats(pBeats);
+            }
+        }
+    }
+    if (pTrack->getKeys().getGlobalKey() == mixxx::track::io::key::INVALID &&
+            !results.keysVersion.isEmpty()) {
+        QByteArray keysBlob = results.keysBlob;
+        pTrack->setKeys(KeyFactory::loadKeysFromByteArray(
+                results.keysVersion,
+                results.keysSubVersion,
+                &keysBlob));
+    }
+    mixxx::ReplayGain replayGain = pTrack->getReplayGain();
+    if (!replayGain.hasRatio() &&
+            mixxx::ReplayGain::isValidRatio(results.replayGainRatio)) {
+        replayGain.setRatio(results.replayGainRatio);
+        if (mixxx::ReplayGain::isValidPeak(
+                    static_cast<CSAMPLE>(results.replayGainPeak))) {
+            replayGain.setPeak(static_cast<CSAMPLE>(results.replayGainPeak));
+        }
+        pTrack->setReplayGain(replayGain);
+    }
+}
+
 WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     DEBUG_ASSERT(!m_currentTrack.has_value());
     AnalyzerTrack* pFront = m_nextTrack.front();
@@ -299,10 +403,27 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
-            for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
+            const auto channelCount = audioSource->getSignalInfo().getChannelCount();
+            if (channelCount > mixxx::kAnalysisChannels) {
+                // Mix down the stems only once for all analyzers
+                const SINT frameCount = readableSampleFrames.frameIndexRange().length();
+                SampleUtil::mixMultichannelToStereo(m_stereoMixBuffer.data(),
                         readableSampleFrames.readableData(),
-                        readableSampleFrames.readableLength());
+                        frameCount,
+                        channelCount);
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processStemSamples(
+                            readableSampleFrames.readableData(),
+                            readableSampleFrames.readableLength(),
+                            m_stereoMixBuffer.data(),
+                            frameCount * mixxx::kAnalysisChannels);
+                }
+            } else {
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processSamples(
+                            readableSampleFrames.readableData(),
+                            readableSampleFrames.readableLength());
+                }
             }
         }
 
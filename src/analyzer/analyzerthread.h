@@ -7,6 +7,7 @@
 #include "analyzer/analyzer.h"
 #include "analyzer/analyzerprogress.h"
 #include "analyzer/analyzertrack.h"
+#include "library/dao/analysisdao.h"
 #include "preferences/usersettings.h"
 #include "rigtorp/SPSCQueue.h"
 #include "sources/audiosource.h"
@@ -61,6 +62,14 @@ class AnalyzerThread : public WorkerThread {
             UserSettingsPointer pConfig,
             AnalyzerModeFlags modeFlags);
 
+    /// Restores the analysis results of a different track with the same
+    /// audio digest. Only results that are missing are restored, i.e.
+    /// existing beats, keys and ReplayGain are never replaced.
+    static void restoreTrackAnalysisResults(
+            Track* pTrack,
+            mixxx::audio::SampleRate sampleRate,
+            const AnalysisDao::TrackAnalysisResults& results);
+
     /*private*/ AnalyzerThread(
             int id,
             mixxx::DbConnectionPoolPtr dbConnectionPool,
@@ -119,6 +128,8 @@ class AnalyzerThread : public WorkerThread {
     std::vector<AnalyzerWithState> m_analyzers;
 
     mixxx::SampleBuffer m_sampleBuffer;
+    // The stereo mix of multichannel (stem) sources
+    mixxx::SampleBuffer m_stereoMixBuffer;
 
     std::optional<AnalyzerTrack> m_currentTrack;
 
@@ -134,6 +145,13 @@ class AnalyzerThread : public WorkerThread {
     AnalysisResult analyzeAudioSource(
             const mixxx::AudioSourcePointer& audioSource);
 
+    // Calculates and stores the audio digest of the current track if
+    // it doesn't have one yet. Missing analysis results are restored
+    // from a different track in the library with the same digest.
+    void restoreAnalysisResultsByAudioDigest(
+            const mixxx::AudioSourcePointer& audioSource,
+            AnalysisDao* pAnalysisDao);
+
     // Blocks the worker thread until a next track becomes available
     TrackPointer receiveNextTrack();
 
@@ -48,7 +48,9 @@ bool AnalyzerWaveform::initialize(const AnalyzerTrack& track,
     }
 
     // If we don't need to calculate the waveform/wavesummary, skip.
-    if (!shouldAnalyze(track.getTrack())) {
+    QList<AnalysisDao::AnalysisInfo> upgradedAnalyses;
+    if (!shouldAnalyze(track.getTrack(), &upgradedAnalyses)) {
+        saveUpgradedAnalyses(upgradedAnalyses);
         return false;
     }
 
@@ -99,7 +101,8 @@ bool AnalyzerWaveform::initialize(const AnalyzerTrack& track,
     return true;
 }
 
-bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
+bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack,
+        QList<AnalysisDao::AnalysisInfo>* pUpgradedAnalyses) const {
     ConstWaveformPointer pTrackWaveform = pTrack->getWaveform();
     ConstWaveformPointer pTrackWaveformSummary = pTrack->getWaveformSummary();
     ConstWaveformPointer pLoadedTrackWaveform;
@@ -123,9 +126,15 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
 
             if (analysis.type == AnalysisDao::TYPE_WAVEFORM) {
                 vc = WaveformFactory::waveformVersionToVersionClass(analysis.version);
-                if (missingWaveform && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveform = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
+                if (missingWaveform &&
+                        (vc == WaveformFactory::VC_USE ||
+                                vc == WaveformFactory::VC_UPGRADE)) {
+                    pLoadedTrackWaveform = ConstWaveformPointer(loadStoredAnalysis(
+                            analysis,
+                            vc,
+                            WaveformFactory::currentWaveformVersion(),
+                            WaveformFactory::currentWaveformDescription(),
+                            pUpgradedAnalyses));
                     missingWaveform = false;
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
@@ -134,9 +143,15 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
             }
             if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
                 vc = WaveformFactory::waveformSummaryVersionToVersionClass(analysis.version);
-                if (missingWavesummary && vc == WaveformFactory::VC_USE) {
-                    pLoadedTrackWaveformSummary = ConstWaveformPointer(
-                            WaveformFactory::loadWaveformFromAnalysis(analysis));
+                if (missingWavesummary &&
+                        (vc == WaveformFactory::VC_USE ||
+                                vc == WaveformFactory::VC_UPGRADE)) {
+                    pLoadedTrackWaveformSummary = ConstWaveformPointer(loadStoredAnalysis(
+                            analysis,
+                            vc,
+                            WaveformFactory::currentWaveformSummaryVersion(),
+                            WaveformFactory::currentWaveformSummaryDescription(),
+                            pUpgradedAnalyses));
                     missingWavesummary = false;
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
@@ -172,6 +187,41 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer pTrack) const {
     return true;
 }
 
+// static
+Waveform* AnalyzerWaveform::loadStoredAnalysis(
+        const AnalysisDao::AnalysisInfo& analysis,
+        WaveformFactory::VersionClass versionClass,
+        const QString& currentVersion,
+        const QString& currentDescription,
+        QList<AnalysisDao::AnalysisInfo>* pUpgradedAnalyses) {
+    Waveform* pWaveform = WaveformFactory::loadWaveformFromAnalysis(analysis);
+    if (versionClass != WaveformFactory::VC_UPGRADE || pWaveform->getDataSize() == 0) {
+        return pWaveform;
+    }
+    // Mixxx versions that only support the old format will analyze the
+    // track again.
+    pWaveform->setVersion(currentVersion);
+    pWaveform->setDescription(currentDescription);
+    AnalysisDao::AnalysisInfo upgradedAnalysis = analysis;
+    upgradedAnalysis.version = currentVersion;
+    upgradedAnalysis.description = currentDescription;
+    upgradedAnalysis.data = pWaveform->toByteArray();
+    pUpgradedAnalyses->append(std::move(upgradedAnalysis));
+    return pWaveform;
+}
+
+void AnalyzerWaveform::saveUpgradedAnalyses(
+        const QList<AnalysisDao::AnalysisInfo>& upgradedAnalyses) {
+    for (auto upgradedAnalysis : upgradedAnalyses) {
+        if (!m_analysisDao.saveAnalysis(&upgradedAnalysis)) {
+            kLogger.warning()
+                    << "Failed to upgrade stored analysis"
+                    << upgradedAnalysis.analysisId
+                    << upgradedAnalysis.version;
+        }
+    }
+}
+
 void AnalyzerWaveform::createFilters(mixxx::audio::SampleRate sampleRate) {
     // m_filter[Low] = new EngineFilterButterworth8Low(sampleRate, kLowMidFreqHz);
     // m_filter[Mid] = new EngineFilterButterworth8Band(sampleRate, kLowMidFreqHz, kMidHighFreqHz);
@@ -192,6 +242,30 @@ void AnalyzerWaveform::destroyFilters() {
 }
 
 bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
+    if (m_channelCount <= mixxx::audio::ChannelCount::stereo()) {
+        return analyzeSamples(pIn, count, pIn);
+    }
+    DEBUG_ASSERT(0 == m_channelCount % mixxx::audio::ChannelCount::stereo());
+
+    const SINT numFrames = count / m_channelCount;
+    CSAMPLE* pMixedChannel = SampleUtil::alloc(numFrames * mixxx::audio::ChannelCount::stereo());
+    VERIFY_OR_DEBUG_ASSERT(pMixedChannel) {
+        return false;
+    }
+    SampleUtil::mixMultichannelToStereo(pMixedChannel, pIn, numFrames, m_channelCount);
+    const bool ret = analyzeSamples(pIn, count, pMixedChannel);
+    SampleUtil::free(pMixedChannel);
+    return ret;
+}
+
+bool AnalyzerWaveform::processStemSamples(
+        const CSAMPLE* pIn, SINT count, const CSAMPLE* pStereoMix) {
+    DEBUG_ASSERT(m_channelCount > mixxx::audio::ChannelCount::stereo());
+    return analyzeSamples(pIn, count, pStereoMix);
+}
+
+bool AnalyzerWaveform::analyzeSamples(
+        const CSAMPLE* pIn, SINT count, const CSAMPLE* pStereoMix) {
     VERIFY_OR_DEBUG_ASSERT(m_waveform) {
         return false;
     }
@@ -201,22 +275,11 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
 
     SINT numFrames = count / m_channelCount;
     count = numFrames * mixxx::audio::ChannelCount::stereo();
-    int stemCount = 0;
+    const int stemCount = m_channelCount > mixxx::audio::ChannelCount::stereo()
+            ? m_channelCount / mixxx::audio::ChannelCount::stereo()
+            : 0;
 
-    const CSAMPLE* pWaveformInput = pIn;
-    CSAMPLE* pMixedChannel = nullptr;
-
-    if (m_channelCount > mixxx::audio::ChannelCount::stereo()) {
-        DEBUG_ASSERT(0 == m_channelCount % mixxx::audio::ChannelCount::stereo());
-
-        pMixedChannel = SampleUtil::alloc(count);
-        VERIFY_OR_DEBUG_ASSERT(pMixedChannel) {
-            return false;
-        }
-        SampleUtil::mixMultichannelToStereo(pMixedChannel, pIn, numFrames, m_channelCount);
-        stemCount = m_channelCount / mixxx::audio::ChannelCount::stereo();
-        pWaveformInput = pMixedChannel;
-    }
+    const CSAMPLE* pWaveformInput = pStereoMix;
 
     // This should only append once if count is constant
     if (count > m_buffers.size) {
@@ -306,9 +369,6 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* pIn, SINT count) {
 
     //kLogger.debug() << "process - m_waveform->getCompletion()" << m_waveform->getCompletion() << "off" << m_waveform->getDataSize();
     //kLogger.debug() << "process - m_waveformSummary->getCompletion()" << m_waveformSummary->getCompletion() << "off" << m_waveformSummary->getDataSize();
-    if (pMixedChannel) {
-        SampleUtil::free(pMixedChannel);
-    }
     return true;
 }
 
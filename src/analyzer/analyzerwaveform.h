@@ -8,6 +8,7 @@
 #include "util/performancetimer.h"
 #include "util/sample.h"
 #include "waveform/waveform.h"
+#include "waveform/waveformfactory.h"
 
 //NOTS vrince some test to segment sound, to apply color in the waveform
 //#define TEST_HEAT_MAP
@@ -146,11 +147,34 @@ class AnalyzerWaveform : public Analyzer {
             mixxx::audio::ChannelCount channelCount,
             SINT frameLength) override;
     bool processSamples(const CSAMPLE* buffer, SINT count) override;
+    bool supportsStems() const override {
+        return true;
+    }
+    bool processStemSamples(const CSAMPLE* pIn,
+            SINT count,
+            const CSAMPLE* pStereoMix) override;
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
   private:
-    bool shouldAnalyze(TrackPointer tio) const;
+    /// Loads the stored waveforms of the track if they are missing.
+    /// Analyses that have been stored in an outdated format are returned
+    /// in pUpgradedAnalyses, converted to the current format.
+    bool shouldAnalyze(TrackPointer tio,
+            QList<AnalysisDao::AnalysisInfo>* pUpgradedAnalyses) const;
+    /// Replaces the stored analyses, they will be loaded faster next time.
+    void saveUpgradedAnalyses(const QList<AnalysisDao::AnalysisInfo>& upgradedAnalyses);
+    /// Fills the filtered bands from the stereo mix and the stems
+    /// from the individual channels of pIn.
+    bool analyzeSamples(const CSAMPLE* pIn, SINT count, const CSAMPLE* pStereoMix);
+    /// Loads a stored analysis and appends it to pUpgradedAnalyses in
+    /// the current format if needed.
+    static Waveform* loadStoredAnalysis(
+            const AnalysisDao::AnalysisInfo& analysis,
+            WaveformFactory::VersionClass versionClass,
+            const QString& currentVersion,
+            const QString& currentDescription,
+            QList<AnalysisDao::AnalysisInfo>* pUpgradedAnalyses);
 
     void storeCurrentStridePower();
     void resetCurrentStride();
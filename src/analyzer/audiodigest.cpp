@@ -0,0 +1,107 @@
+#include "analyzer/audiodigest.h"
+
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <cmath>
+
+#include "analyzer/constants.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+// The number of evenly distributed ranges, each with a length of
+// kAnalysisFramesPerChunk, that are decoded for the digest. The first
+// and the last range are aligned with the start and the end of the track.
+constexpr SINT kAudioDigestRangeCount = 4;
+
+constexpr QCryptographicHash::Algorithm kAudioDigestHashAlgorithm =
+        QCryptographicHash::Sha256;
+
+template<typename T>
+void addValueToHash(QCryptographicHash* pHash, T value) {
+    const T littleEndianValue = qToLittleEndian(value);
+    pHash->addData(QByteArray::fromRawData(
+            reinterpret_cast<const char*>(&littleEndianValue),
+            sizeof(littleEndianValue)));
+}
+
+// Decoders might produce slightly different floating point values
+// on different platforms. Only the 16-bit PCM representation of the
+// signal is hashed to compensate for tiny rounding errors.
+void addSamplesToHash(
+        QCryptographicHash* pHash,
+        const CSAMPLE* pSamples,
+        SINT sampleCount) {
+    constexpr SINT kBlockSize = 1024;
+    qint16 block[kBlockSize];
+    while (sampleCount > 0) {
+        const SINT blockCount = math_min(sampleCount, kBlockSize);
+        for (SINT i = 0; i < blockCount; ++i) {
+            const CSAMPLE sample = math_clamp(pSamples[i], -1.0f, 1.0f);
+            block[i] = qToLittleEndian(static_cast<qint16>(std::lround(sample * 32767.0f)));
+        }
+        pHash->addData(QByteArray::fromRawData(
+                reinterpret_cast<const char*>(block),
+                static_cast<int>(blockCount * sizeof(block[0]))));
+        pSamples += blockCount;
+        sampleCount -= blockCount;
+    }
+}
+
+} // anonymous namespace
+
+cache_key_t calculateAudioDigest(
+        const AudioSourcePointer& pAudioSource,
+        SampleBuffer* pSampleBuffer) {
+    VERIFY_OR_DEBUG_ASSERT(pAudioSource) {
+        return invalidCacheKey();
+    }
+    const IndexRange frameIndexRange = pAudioSource->frameIndexRange();
+    if (frameIndexRange.empty()) {
+        return invalidCacheKey();
+    }
+    const auto channelCount = pAudioSource->getSignalInfo().getChannelCount();
+    const SINT rangeLength = math_min(
+            kAnalysisFramesPerChunk,
+            pSampleBuffer->size() / static_cast<SINT>(channelCount));
+    VERIFY_OR_DEBUG_ASSERT(rangeLength > 0) {
+        return invalidCacheKey();
+    }
+
+    QCryptographicHash hash(kAudioDigestHashAlgorithm);
+    addValueToHash(&hash, static_cast<quint32>(channelCount));
+    addValueToHash(&hash,
+            static_cast<quint32>(pAudioSource->getSignalInfo().getSampleRate()));
+    addValueToHash(&hash, static_cast<qint64>(frameIndexRange.length()));
+
+    // The distance between the start positions of subsequent ranges
+    const SINT rangeDistance =
+            math_max(rangeLength,
+                    (frameIndexRange.length() - rangeLength) /
+                            (kAudioDigestRangeCount - 1));
+    for (SINT rangeStart = frameIndexRange.start();
+            rangeStart < frameIndexRange.end();
+            rangeStart += rangeDistance) {
+        const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                WritableSampleFrames(
+                        intersect(IndexRange::forward(rangeStart, rangeLength),
+                                frameIndexRange),
+                        SampleBuffer::WritableSlice(
+                                pSampleBuffer->data(),
+                                rangeLength * channelCount)));
+        if (readableSampleFrames.frameIndexRange().empty()) {
+            // Corrupt or unreadable file
+            return invalidCacheKey();
+        }
+        addValueToHash(&hash,
+                static_cast<qint64>(readableSampleFrames.frameIndexRange().start()));
+        addSamplesToHash(&hash,
+                readableSampleFrames.readableData(),
+                readableSampleFrames.readableLength());
+    }
+    return cacheKeyFromMessageDigest(hash.result());
+}
+
+} // namespace mixxx
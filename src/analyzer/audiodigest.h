@@ -0,0 +1,25 @@
+#pragma once
+
+#include "sources/audiosource.h"
+#include "util/cache.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+/// Calculates a digest of the decoded audio signal, independent of
+/// the file name, the file location, and any metadata tags.
+///
+/// Only a few evenly distributed ranges of the signal are decoded and
+/// hashed, together with the signal properties. This is cheap compared
+/// to a full analysis and sufficient to recognize files that have been
+/// moved, copied, or re-tagged.
+///
+/// The sample buffer is used for decoding and must be large enough to
+/// hold kAnalysisFramesPerChunk frames of the audio source.
+///
+/// Returns an invalid cache key if the audio source could not be read.
+cache_key_t calculateAudioDigest(
+        const AudioSourcePointer& pAudioSource,
+        SampleBuffer* pSampleBuffer);
+
+} // namespace mixxx
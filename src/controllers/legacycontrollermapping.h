@@ -122,6 +122,10 @@ class LegacyControllerMapping {
         bool reversedColor;         // Whether or not the RGB is swapped BGR.
         bool rawData;               // Whether or not the screen is allowed to receive bare
                                     // data, not transformed.
+        bool partialUpdate;         // Whether or not the screen accepts transformed
+                                    // updates of the changed regions only.
+        bool skipUnchangedFrames;   // Whether or not the screen keeps displaying the
+                                    // last frame while the scene is unchanged.
     };
 #endif
 
@@ -218,6 +222,10 @@ class LegacyControllerMapping {
     /// @param endian the pixel endian format
     /// @param reversedColor whether or not the RGB is swapped BGR
     /// @param rawData whether or not the screen is allowed to reserve bare data, not transformed
+    /// @param partialUpdate whether or not the screen accepts transformed updates of the
+    /// changed regions only
+    /// @param skipUnchangedFrames whether or not the screen keeps displaying the last
+    /// frame while the scene is unchanged
     virtual void addScreenInfo(ScreenInfo info) {
         m_screens.append(std::move(info));
         setDirty(true);
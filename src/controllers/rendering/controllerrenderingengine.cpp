@@ -42,6 +42,7 @@ ControllerRenderingEngine::ControllerRenderingEngine(
         gsl::not_null<ControllerEngineThreadControl*> engineThreadControl)
         : QObject(),
           m_screenInfo(info),
+          m_sceneChanged(true),
           m_GLDataFormat(GL_RGBA),
           m_GLDataType(GL_UNSIGNED_BYTE),
           m_isValid(true),
@@ -170,7 +171,12 @@ void ControllerRenderingEngine::requestEngineSetup(std::shared_ptr<QQmlEngine> q
 
 void ControllerRenderingEngine::requestSendingFrameData(
         Controller* controller, const QByteArray& frame) {
-    emit sendFrameDataRequested(controller, frame);
+    emit sendFrameDataRequested(controller, QList<QByteArray>{frame});
+}
+
+void ControllerRenderingEngine::requestSendingFrameRegions(
+        Controller* controller, const QList<QByteArray>& regions) {
+    emit sendFrameDataRequested(controller, regions);
 }
 
 void ControllerRenderingEngine::setup(std::shared_ptr<QQmlEngine> qmlEngine) {
@@ -213,6 +219,20 @@ void ControllerRenderingEngine::setup(std::shared_ptr<QQmlEngine> qmlEngine) {
     }
 
     m_renderControl = std::make_unique<QQuickRenderControl>(this);
+    // Items are modified from the thread of the QML engine
+    const auto markSceneChanged = [this]() {
+        m_sceneChanged.store(true);
+    };
+    connect(m_renderControl.get(),
+            &QQuickRenderControl::renderRequested,
+            this,
+            markSceneChanged,
+            Qt::DirectConnection);
+    connect(m_renderControl.get(),
+            &QQuickRenderControl::sceneChanged,
+            this,
+            markSceneChanged,
+            Qt::DirectConnection);
     m_quickWindow = std::make_unique<QQuickWindow>(m_renderControl.get());
 
     if (!qmlEngine->incubationController()) {
@@ -292,6 +312,18 @@ void ControllerRenderingEngine::renderFrame() {
 
     m_nextFrameStart = Clock::now();
 
+    // Reading back and converting the pixels and sending them to the device
+    // costs much more than rendering the scene. Screens that opted in skip
+    // all of it while the device is still displaying the current scene, but
+    // still get a complete frame periodically.
+    const bool sceneChanged = m_sceneChanged.exchange(false);
+    if (canSkipFrame(m_screenInfo, sceneChanged, m_nextFrameStart - m_lastSentFrameStart)) {
+        m_context->doneCurrent();
+        scheduleNextFrame();
+        return;
+    }
+    m_lastSentFrameStart = m_nextFrameStart;
+
     m_renderControl->beginFrame();
 
     if (m_pEngineThreadControl) {
@@ -310,7 +342,9 @@ void ControllerRenderingEngine::renderFrame() {
     if (m_pEngineThreadControl) {
         m_pEngineThreadControl->resume();
     }
-    QImage fboImage(m_screenInfo.size, m_screenInfo.pixelFormat);
+    if (m_frame.isNull()) {
+        m_frame = QImage(m_screenInfo.size, m_screenInfo.pixelFormat);
+    }
 
     VERIFY_OR_DEBUG_ASSERT(m_fbo->bind()) {
         kLogger.warning() << "Couldn't bind the FBO.";
@@ -348,20 +382,20 @@ void ControllerRenderingEngine::renderFrame() {
                 m_screenInfo.size.height(),
                 m_GLDataFormat,
                 m_GLDataType,
-                fboImage.bits());
+                m_frame.bits());
     }
     glError = m_context->functions()->glGetError();
     VERIFY_OR_TERMINATE(glError == GL_NO_ERROR, "GLError: " << glError);
-    VERIFY_OR_DEBUG_ASSERT(!fboImage.isNull()) {
+    VERIFY_OR_DEBUG_ASSERT(!m_frame.isNull()) {
         kLogger.warning() << "Screen frame is null!";
     }
     VERIFY_OR_DEBUG_ASSERT(m_fbo->release()) {
         kLogger.debug() << "Couldn't release the FBO.";
     }
 
-    fboImage.mirror(false, true);
+    m_frame.mirror(false, true);
 
-    emit frameRendered(m_screenInfo, fboImage.copy(), timestamp);
+    emit frameRendered(m_screenInfo, m_frame, timestamp);
 
     m_context->doneCurrent();
 }
@@ -371,11 +405,16 @@ bool ControllerRenderingEngine::stop() {
     return m_pThread->wait();
 }
 
-void ControllerRenderingEngine::send(Controller* controller, const QByteArray& frame) {
+void ControllerRenderingEngine::send(Controller* controller, const QList<QByteArray>& frames) {
     DEBUG_ASSERT_THIS_QOBJECT_THREAD_AFFINITY();
     ScopedTimer t(QStringLiteral("ControllerRenderingEngine::send"));
-    if (!frame.isEmpty()) {
+    qsizetype frameSize = 0;
+    for (const auto& frame : frames) {
+        if (frame.isEmpty()) {
+            continue;
+        }
         VERIFY_OR_TERMINATE(controller->sendBytes(frame), "Unable to send frame to device");
+        frameSize += frame.size();
     }
 
     if (CmdlineArgs::Instance()
@@ -386,9 +425,14 @@ void ControllerRenderingEngine::send(Controller* controller, const QByteArray& f
                 << std::chrono::duration_cast<std::chrono::milliseconds>(
                            endOfFrameCycle - m_nextFrameStart)
                            .count()
-                << "milliseconds and frame has" << frame.size() << "bytes";
+                << "milliseconds and frame has" << frameSize << "bytes in"
+                << frames.size() << "transfers";
     }
 
+    scheduleNextFrame();
+}
+
+void ControllerRenderingEngine::scheduleNextFrame() {
     m_nextFrameStart += std::chrono::microseconds(1000000 / m_screenInfo.target_fps);
 
     auto durationToWaitBeforeFrame =
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <QImage>
+#include <QList>
 #include <QObject>
 #include <QOpenGLContext>
 #include <QOpenGLFramebufferObject>
+#include <atomic>
 #include <chrono>
 #include <gsl/pointers>
 
@@ -25,6 +28,11 @@ class QThread;
 class ControllerRenderingEngine : public QObject {
     Q_OBJECT
   public:
+    /// Frames of screens that skip unchanged frames are still sent at least
+    /// this often, e.g. to restore the screen after the device lost its
+    /// frame buffer, and to call the transform function of the mapping.
+    static constexpr std::chrono::milliseconds kMaxSkippedFramesDuration{1000};
+
     ControllerRenderingEngine(const LegacyControllerMapping::ScreenInfo& info,
             gsl::not_null<ControllerEngineThreadControl*> engineThreadControl);
     // Destructor will wait for the ControllerRenderingEngine's thread to
@@ -52,11 +60,25 @@ class ControllerRenderingEngine : public QObject {
         return m_screenInfo;
     }
 
+    /// Whether or not rendering and sending the frame can be skipped
+    /// because the device is still displaying the current scene. This is
+    /// only the case if the screen opted in with `skipUnchangedFrames`.
+    static bool canSkipFrame(const LegacyControllerMapping::ScreenInfo& info,
+            bool sceneChanged,
+            std::chrono::steady_clock::duration sinceLastSentFrame) {
+        return info.skipUnchangedFrames && !sceneChanged &&
+                sinceLastSentFrame < kMaxSkippedFramesDuration;
+    }
+
   public slots:
     // Request sending frame data to the device. The task will be run in the
     // rendering event loop. This method should only be called once received the
     // `frameRendered` signal.
     virtual void requestSendingFrameData(Controller* controller, const QByteArray& frame);
+    // Like `requestSendingFrameData`, but for a partial update. Each of the
+    // transformed regions is sent to the device with a separate transfer.
+    virtual void requestSendingFrameRegions(
+            Controller* controller, const QList<QByteArray>& regions);
     // Request setting up the rendering context for QML engine and wait till it
     // is completed. The task will be run in the rendering event loop to ensure
     // thread affinity of engine components. `isValid` can be used to ensure
@@ -69,7 +91,7 @@ class ControllerRenderingEngine : public QObject {
     void finish();
     void renderFrame();
     void setup(std::shared_ptr<QQmlEngine> qmlEngine);
-    void send(Controller* controller, const QByteArray& frame);
+    void send(Controller* controller, const QList<QByteArray>& frames);
 
   signals:
     void frameRendered(const LegacyControllerMapping::ScreenInfo& screeninfo,
@@ -78,13 +100,16 @@ class ControllerRenderingEngine : public QObject {
     void stopping();
     /// @brief Request the screen thread to send a frame to the device.
     /// @param controller the controller to send the frame to.
-    /// @param frame the frame data, ready to be sent.
-    void sendFrameDataRequested(Controller* controller, const QByteArray& frame);
+    /// @param frames the frame data, ready to be sent. Partial updates may
+    /// consist of multiple transfers.
+    void sendFrameDataRequested(Controller* controller, const QList<QByteArray>& frames);
 
   private:
     virtual void prepare();
+    void scheduleNextFrame();
 
     std::chrono::time_point<std::chrono::steady_clock> m_nextFrameStart;
+    std::chrono::time_point<std::chrono::steady_clock> m_lastSentFrameStart;
 
     LegacyControllerMapping::ScreenInfo m_screenInfo;
 
@@ -97,6 +122,15 @@ class ControllerRenderingEngine : public QObject {
 
     std::unique_ptr<QOpenGLFramebufferObject> m_fbo;
 
+    // The frame buffer is reused for reading back the pixels of every
+    // frame. It is implicitly shared with the receivers of frameRendered()
+    // and only detached if a receiver still holds the previous frame.
+    QImage m_frame;
+
+    // Set by QQuickRenderControl whenever the scene needs to be rendered
+    // again. This may happen on any thread that modifies the scene.
+    std::atomic<bool> m_sceneChanged;
+
     GLenum m_GLDataFormat;
     GLenum m_GLDataType;
 
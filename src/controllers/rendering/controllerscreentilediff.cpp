@@ -0,0 +1,99 @@
+#include "controllers/rendering/controllerscreentilediff.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/assert.h"
+
+namespace {
+
+void appendRegion(QList<QRect>* pRegions, const QRect& region) {
+    // Extend a region of the previous tile row that spans the same columns
+    for (auto it = pRegions->rbegin(); it != pRegions->rend(); ++it) {
+        if (it->bottom() == region.top() - 1 &&
+                it->left() == region.left() &&
+                it->width() == region.width()) {
+            it->setBottom(region.bottom());
+            return;
+        }
+    }
+    pRegions->append(region);
+}
+
+} // anonymous namespace
+
+ControllerScreenTileDiff::ControllerScreenTileDiff(int tileSize)
+        : m_tileSize(tileSize) {
+    DEBUG_ASSERT(m_tileSize > 0);
+}
+
+void ControllerScreenTileDiff::reset() {
+    m_previousFrame = QImage();
+}
+
+QList<QRect> ControllerScreenTileDiff::update(const QImage& frame) {
+    if (frame.isNull()) {
+        return {};
+    }
+    if (m_previousFrame.size() != frame.size() ||
+            m_previousFrame.format() != frame.format()) {
+        // Deep copy, the frame buffer is reused by the renderer
+        m_previousFrame = frame.copy();
+        return {frame.rect()};
+    }
+
+    const int bytesPerPixel = frame.depth() / 8;
+    const int bytesPerLine = frame.width() * bytesPerPixel;
+    const int columns = (frame.width() + m_tileSize - 1) / m_tileSize;
+    QList<QRect> regions;
+    for (int y = 0; y < frame.height(); y += m_tileSize) {
+        const int height = std::min(m_tileSize, frame.height() - y);
+        m_changedTiles.assign(columns, false);
+        int changedTiles = 0;
+        for (int line = y; line < y + height && changedTiles < columns; ++line) {
+            const uchar* pLine = frame.constScanLine(line);
+            const uchar* pPreviousLine = m_previousFrame.constScanLine(line);
+            // Most lines are usually unchanged
+            if (std::memcmp(pLine, pPreviousLine, bytesPerLine) == 0) {
+                continue;
+            }
+            for (int column = 0; column < columns; ++column) {
+                if (m_changedTiles[column]) {
+                    continue;
+                }
+                const int offset = column * m_tileSize * bytesPerPixel;
+                const int length = std::min(m_tileSize * bytesPerPixel, bytesPerLine - offset);
+                if (std::memcmp(pLine + offset, pPreviousLine + offset, length) != 0) {
+                    m_changedTiles[column] = true;
+                    ++changedTiles;
+                }
+            }
+        }
+        for (int column = 0; column < columns;) {
+            if (!m_changedTiles[column]) {
+                ++column;
+                continue;
+            }
+            int endColumn = column + 1;
+            while (endColumn < columns && m_changedTiles[endColumn]) {
+                ++endColumn;
+            }
+            const int x = column * m_tileSize;
+            const int width = std::min(endColumn * m_tileSize, frame.width()) - x;
+            appendRegion(&regions, QRect(x, y, width, height));
+            column = endColumn;
+        }
+    }
+
+    // Only the changed regions need to be updated for the next comparison
+    for (const QRect& region : std::as_const(regions)) {
+        const int offset = region.x() * bytesPerPixel;
+        const int length = region.width() * bytesPerPixel;
+        for (int line = region.top(); line <= region.bottom(); ++line) {
+            std::memcpy(m_previousFrame.scanLine(line) + offset,
+                    frame.constScanLine(line) + offset,
+                    length);
+        }
+    }
+    return regions;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <vector>
+
+/// @brief Finds the regions of a controller screen frame that have changed
+/// since the previous frame.
+///
+/// The frame is divided into square tiles which are compared with the
+/// previous frame. Adjacent changed tiles of a tile row are merged into a
+/// single region, as well as regions of consecutive tile rows that span the
+/// same columns. This keeps the number of transfers low for devices that
+/// support partial updates.
+class ControllerScreenTileDiff {
+  public:
+    static constexpr int kDefaultTileSize = 16;
+
+    explicit ControllerScreenTileDiff(int tileSize = kDefaultTileSize);
+
+    /// Returns the changed regions of the frame, ordered from top to bottom,
+    /// and keeps the frame for the next comparison. The whole frame is
+    /// returned for the first frame and whenever the size or the pixel format
+    /// changes. An empty list is returned if nothing changed.
+    QList<QRect> update(const QImage& frame);
+
+    /// Forget the previous frame, so that the next frame is sent completely.
+    void reset();
+
+    int tileSize() const {
+        return m_tileSize;
+    }
+
+  private:
+    int m_tileSize;
+    QImage m_previousFrame;
+    // The changed tiles of the current tile row, reused for all rows
+    std::vector<bool> m_changedTiles;
+};
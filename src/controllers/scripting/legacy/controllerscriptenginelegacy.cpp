@@ -9,6 +9,7 @@
 #include <QQuickWindow>
 #include <QtEndian>
 #include <algorithm>
+#include <cstring>
 #endif
 
 #include "control/controlobject.h"
@@ -19,11 +20,29 @@
 #include "mixer/playermanager.h"
 #include "moc_controllerscriptenginelegacy.cpp"
 #ifdef MIXXX_USE_QML
+#include "controllers/rendering/controllerrenderingengine.h"
 #include "qml/qmlmixxxcontrollerscreen.h"
 #include "util/assert.h"
 #include "util/cmdlineargs.h"
 
 using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Copies the pixels of a region of the frame line by line into the buffer
+void copyScreenRegion(QByteArray* pBuffer, const QImage& frame, const QRect& region) {
+    const int bytesPerPixel = frame.depth() / 8;
+    const int offset = region.x() * bytesPerPixel;
+    const int length = region.width() * bytesPerPixel;
+    pBuffer->resize(static_cast<qsizetype>(length) * region.height());
+    char* pOut = pBuffer->data();
+    for (int line = region.top(); line <= region.bottom(); ++line) {
+        std::memcpy(pOut, frame.constScanLine(line) + offset, length);
+        pOut += length;
+    }
+}
+
+} // anonymous namespace
 #endif
 
 ControllerScriptEngineLegacy::ControllerScriptEngineLegacy(
@@ -540,9 +559,18 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         emit previewRenderedScreen(screenInfo, screenDebug);
     }
 
-    // TODO: Refactor this to a `std::bit_cast` once we drop support for older
-    // compilers that don't support it (e.g. older than Xcode 14.3/macOS 13)
-    QByteArray input(reinterpret_cast<const char*>(frame.constBits()), frame.sizeInBytes());
+    // Partial updates only need the pixels of the changed regions
+    const bool partialUpdate = screenInfo.partialUpdate && pScreen->getTransform().isCallable();
+
+    // The buffer is only detached and reallocated if the previous frame is
+    // still referenced, e.g. while it is sent to the device.
+    QByteArray& input = m_screenFrameBuffers[screenInfo.identifier];
+    if (!partialUpdate) {
+        input.resize(frame.sizeInBytes());
+        if (!input.isEmpty()) {
+            std::memcpy(input.data(), frame.constBits(), input.size());
+        }
+    }
 
     if (!pScreen->getTransform().isCallable() && screenInfo.rawData) {
         m_renderingScreens[screenInfo.identifier]->requestSendingFrameData(m_pController, input);
@@ -561,11 +589,69 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         qCWarning(m_logger) << "Controller JS engine has an unhandled error. Discarding.";
         qCDebug(m_logger) << "Controller JS error is:" << m_pJSEngine->catchError().toString();
     }
-    // During the frame transformation, any QML errors are considered fatal.
-    setErrorsAreFatal(true);
-    auto result = pScreen->getTransform().call(
+
+    if (partialUpdate) {
+        ControllerScreenTileDiff& tileDiff = m_screenTileDiffs[screenInfo.identifier];
+        QDateTime& lastCompleteFrame = m_screenCompleteFrameTimestamps[screenInfo.identifier];
+        // The device might have lost its frame buffer, e.g. after waking up.
+        // Frames are sent completely as often as unchanged frames are sent
+        // to screens that skip them.
+        if (lastCompleteFrame.isValid() &&
+                lastCompleteFrame.msecsTo(timestamp) >=
+                        ControllerRenderingEngine::kMaxSkippedFramesDuration.count()) {
+            tileDiff.reset();
+        }
+        const QList<QRect> regions = tileDiff.update(frame);
+        if (regions.size() == 1 && regions.first() == frame.rect()) {
+            lastCompleteFrame = timestamp;
+        }
+        QList<QByteArray> transformedRegions;
+        transformedRegions.reserve(regions.size());
+        for (const QRect& region : regions) {
+            copyScreenRegion(&input, frame, region);
+            QJSValue jsRegion = m_pJSEngine->newObject();
+            jsRegion.setProperty(QStringLiteral("x"), region.x());
+            jsRegion.setProperty(QStringLiteral("y"), region.y());
+            jsRegion.setProperty(QStringLiteral("width"), region.width());
+            jsRegion.setProperty(QStringLiteral("height"), region.height());
+            const auto transformedRegion = transformScreenFrame(screenInfo,
+                    pScreen->getTransform(),
+                    QJSValueList{m_pJSEngine->toScriptValue(input),
+                            m_pJSEngine->toScriptValue(timestamp),
+                            jsRegion});
+            if (!transformedRegion) {
+                // The regions have not been sent and the next frame must be
+                // sent completely. The screen might have been shut down.
+                m_screenTileDiffs.remove(screenInfo.identifier);
+                return;
+            }
+            transformedRegions.append(*transformedRegion);
+        }
+        // Also requested if nothing has changed to continue rendering
+        m_renderingScreens[screenInfo.identifier]->requestSendingFrameRegions(
+                m_pController, transformedRegions);
+        return;
+    }
+
+    const auto transformedFrame = transformScreenFrame(screenInfo,
+            pScreen->getTransform(),
             QJSValueList{m_pJSEngine->toScriptValue(input),
                     m_pJSEngine->toScriptValue(timestamp)});
+    if (!transformedFrame) {
+        return;
+    }
+
+    m_renderingScreens[screenInfo.identifier]->requestSendingFrameData(
+            m_pController, *transformedFrame);
+}
+
+std::optional<QByteArray> ControllerScriptEngineLegacy::transformScreenFrame(
+        const LegacyControllerMapping::ScreenInfo& screenInfo,
+        const QJSValue& transform,
+        const QJSValueList& args) {
+    // During the frame transformation, any QML errors are considered fatal.
+    setErrorsAreFatal(true);
+    auto result = transform.call(args);
     if (result.isError()) {
         qCWarning(m_logger) << "Could not transform rendering buffer for screen"
                             << screenInfo.identifier;
@@ -575,7 +661,7 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         // screen splash off.
         showScriptExceptionDialog(result, true);
         shutdown();
-        return;
+        return std::nullopt;
     }
     QVariant returnedValue = result.toVariant();
     setErrorsAreFatal(false);
@@ -584,7 +670,7 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         qCWarning(m_logger) << "Could not transform rendering buffer. The transform "
                                "function didn't return the expected Array. Stopping "
                                "rendering on this screen";
-        return;
+        return std::nullopt;
     }
 
     QByteArray transformedFrame;
@@ -595,7 +681,7 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         transformedFrame = returnedValue.toByteArray();
     } else {
         qCWarning(m_logger) << "Unable to interpret the returned data " << returnedValue;
-        return;
+        return std::nullopt;
     }
 
     if (CmdlineArgs::Instance().getControllerDebug()) {
@@ -605,8 +691,7 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         m_pController->sendBytes(returnedValue.view<QByteArray>());
     }
 
-    m_renderingScreens[screenInfo.identifier]->requestSendingFrameData(
-            m_pController, transformedFrame);
+    return transformedFrame;
 }
 #endif
 
@@ -644,6 +729,9 @@ void ControllerScriptEngineLegacy::shutdown() {
         };
     }
     m_renderingScreens.clear();
+    m_screenFrameBuffers.clear();
+    m_screenTileDiffs.clear();
+    m_screenCompleteFrameTimestamps.clear();
 #endif
     m_scriptWrappedFunctionCache.clear();
     m_incomingDataFunctions.clear();
@@ -5,7 +5,9 @@
 #include <QJSValue>
 #include <QMessageBox>
 #include <memory>
+#include <optional>
 #ifdef MIXXX_USE_QML
+#include <QDateTime>
 #include <QMetaMethod>
 #include <unordered_map>
 #endif
@@ -14,6 +16,8 @@
 #include "controllers/scripting/controllerscriptenginebase.h"
 
 #ifdef MIXXX_USE_QML
+#include "controllers/rendering/controllerscreentilediff.h"
+
 class QQuickItem;
 class ControllerRenderingEngine;
 namespace mixxx {
@@ -113,11 +117,26 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
             const QJSValueList& args = {},
             bool bFatalError = false);
     void watchFilePath(const QString& path);
+#ifdef MIXXX_USE_QML
+    /// Calls the transform function of a screen with the given arguments.
+    /// Returns std::nullopt if the function failed or returned invalid data.
+    std::optional<QByteArray> transformScreenFrame(
+            const LegacyControllerMapping::ScreenInfo& screenInfo,
+            const QJSValue& transform,
+            const QJSValueList& args);
+#endif
 
     QJSValue m_makeArrayBufferWrapperFunction;
     QList<QString> m_scriptFunctionPrefixes;
 #ifdef MIXXX_USE_QML
     QHash<QString, std::shared_ptr<ControllerRenderingEngine>> m_renderingScreens;
+    // The frame data of each screen is copied into the same buffer for every
+    // frame, instead of allocating a new one.
+    QHash<QString, QByteArray> m_screenFrameBuffers;
+    // Finds the changed regions of screens that support partial updates
+    QHash<QString, ControllerScreenTileDiff> m_screenTileDiffs;
+    // When a complete frame has last been sent to these screens
+    QHash<QString, QDateTime> m_screenCompleteFrameTimestamps;
     // Contains all the scenes loaded for this mapping. Key is the scene
     // identifier (LegacyControllerMapping::ScreenInfo::identifier), value in
     // the QML root item.
@@ -49,6 +49,7 @@
 #include "qml/qmlplayerproxy.h"
 #endif
 #include "soundio/soundmanager.h"
+#include "sources/seekindexcache.h"
 #include "sources/soundsourceproxy.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
@@ -239,6 +240,9 @@ void CoreServices::initialize(QApplication* pApp) {
         qCritical() << "Failed to register any SoundSource providers";
         return;
     }
+    mixxx::SeekIndexCache::setDirectory(
+            QDir(m_pSettingsManager->settings()->getSettingsPath())
+                    .filePath(QStringLiteral("seekindex")));
 
     VersionStore::logBuildDetails();
 
@@ -358,7 +362,8 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("covers")));
     Clipboard::createInstance();
 
     m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
@@ -605,7 +610,12 @@ bool CoreServices::initializeDatabase() {
     }
 
     kLogger.info() << "Initializing or upgrading database schema";
-    return MixxxDb::initDatabaseSchema(dbConnection);
+    if (!MixxxDb::initDatabaseSchema(dbConnection)) {
+        return false;
+    }
+    // Optional, the database still works without
+    MixxxDb::initWriteAheadLogging(dbConnection);
+    return true;
 }
 
 std::shared_ptr<QDialog> CoreServices::makeDlgPreferences() const {
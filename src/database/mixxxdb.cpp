@@ -1,6 +1,8 @@
 #include "database/mixxxdb.h"
 
 #include <QDir>
+#include <QSqlError>
+#include <QSqlQuery>
 
 #include "database/schemamanager.h"
 #include "moc_mixxxdb.cpp"
@@ -12,7 +14,7 @@
 const QString MixxxDb::kDefaultSchemaFile(":/schema.xml");
 
 //static
-const int MixxxDb::kRequiredSchemaVersion = 39;
+const int MixxxDb::kRequiredSchemaVersion = 40;
 
 namespace {
 
@@ -69,6 +71,27 @@ MixxxDb::MixxxDb(
     : m_pDbConnectionPool(std::make_shared<mixxx::DbConnectionPool>(dbConnectionParams(pConfig, inMemoryConnection), "MIXXX")) {
 }
 
+//static
+bool MixxxDb::initWriteAheadLogging(
+        const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA journal_mode=WAL")) || !query.next()) {
+        kLogger.warning()
+                << "Failed to enable write-ahead logging"
+                << query.lastError();
+        return false;
+    }
+    // The resulting journal mode is returned
+    const QString journalMode = query.value(0).toString();
+    if (journalMode.compare(QStringLiteral("wal"), Qt::CaseInsensitive) != 0) {
+        kLogger.info()
+                << "Write-ahead logging is not supported, using journal mode"
+                << journalMode;
+        return false;
+    }
+    return true;
+}
+
 bool MixxxDb::initDatabaseSchema(
         const QSqlDatabase& database,
         int schemaVersion,
@@ -18,6 +18,16 @@ class MixxxDb : public QObject {
             int schemaVersion = kRequiredSchemaVersion,
             const QString& schemaFile = kDefaultSchemaFile);
 
+    /// Switches the database file to write-ahead logging. Readers
+    /// then work on a consistent snapshot and don't have to wait until
+    /// a long running write transaction, e.g. while scanning or
+    /// analyzing, has been committed. The journal mode is persistent.
+    ///
+    /// Returns false if WAL is not supported, e.g. for in-memory
+    /// databases, and the previous journal mode is kept.
+    static bool initWriteAheadLogging(
+            const QSqlDatabase& database);
+
     explicit MixxxDb(
             const UserSettingsPointer& pConfig,
             bool inMemoryConnection = false);
@@ -1,5 +1,6 @@
 #include "library/basesqltablemodel.h"
 
+#include <QTimer>
 #include <QUrl>
 #include <QtDebug>
 #include <algorithm>
@@ -31,6 +32,10 @@ const bool sDebug = false;
 constexpr int kIdColumn = 0;
 constexpr int kMaxSortColumns = 3;
 
+// The values of the table columns are fetched in pages of rows
+constexpr int kRowsPerPage = 256;
+constexpr int kMaxCachedRowPages = 32;
+
 // Constant for getModelSetting(name)
 const QString COLUMNS_SORTING = QStringLiteral("ColumnsSorting");
 
@@ -45,6 +50,7 @@ BaseSqlTableModel::BaseSqlTableModel(
         : BaseTrackTableModel(parent, pTrackCollectionManager, settingsNamespace),
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
+          m_lastAccessedRowPage(-1),
           m_bInitialized(false) {
 }
 
@@ -165,6 +171,7 @@ void BaseSqlTableModel::clearRows() {
         m_rowInfo.clear();
         m_trackIdToRows.clear();
         m_trackPosToRow.clear();
+        clearRowPages();
         endRemoveRows();
     }
     DEBUG_ASSERT(m_rowInfo.isEmpty());
@@ -195,10 +202,116 @@ void BaseSqlTableModel::replaceRows(
         m_rowInfo = rows;
         m_trackIdToRows = trackIdToRows;
         m_trackPosToRow = trackPosToRows;
+        clearRowPages();
         endInsertRows();
     }
 }
 
+void BaseSqlTableModel::clearRowPages() {
+    m_rowPages.clear();
+    m_recentRowPages.clear();
+    m_lastAccessedRowPage = -1;
+}
+
+const QVector<QVariant>& BaseSqlTableModel::rowPage(int page) const {
+    if (page != m_lastAccessedRowPage) {
+        // Prefetch the next page in scroll direction
+        const int direction = page - m_lastAccessedRowPage;
+        m_lastAccessedRowPage = page;
+        if (direction == 1 || direction == -1) {
+            const int nextPage = page + direction;
+            QTimer::singleShot(0, this, [this, nextPage] {
+                prefetchRowPage(nextPage);
+            });
+        }
+    }
+    if (!m_rowPages.contains(page)) {
+        fetchRowPage(page);
+    } else if (m_recentRowPages.last() != page) {
+        m_recentRowPages.removeOne(page);
+        m_recentRowPages.append(page);
+    }
+    return m_rowPages[page];
+}
+
+void BaseSqlTableModel::prefetchRowPage(int page) const {
+    if (page < 0 || page * kRowsPerPage >= m_rowInfo.size()) {
+        return;
+    }
+    if (m_rowPages.contains(page)) {
+        return;
+    }
+    fetchRowPage(page);
+}
+
+void BaseSqlTableModel::fetchRowPage(int page) const {
+    DEBUG_ASSERT(!m_rowPages.contains(page));
+    while (m_rowPages.size() >= kMaxCachedRowPages) {
+        m_rowPages.remove(m_recentRowPages.takeFirst());
+    }
+
+    const int firstRow = page * kRowsPerPage;
+    const int numRows = std::min(kRowsPerPage,
+            static_cast<int>(m_rowInfo.size()) - firstRow);
+    const int numColumns = m_tableColumns.size();
+    QVector<QVariant> columnValues(std::max(numRows, 0) * numColumns);
+
+    // Playlists might contain the same track multiple times. Their rows
+    // are identified by position instead of by track id.
+    const int keyColumn = hasPositionColumn()
+            ? fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)
+            : kIdColumn;
+    QStringList keys;
+    keys.reserve(std::max(numRows, 0));
+    for (int row = firstRow; row < firstRow + numRows; ++row) {
+        const RowInfo& rowInfo = m_rowInfo[row];
+        keys.append(keyColumn == kIdColumn
+                        ? rowInfo.trackId.toString()
+                        : QString::number(rowInfo.position));
+    }
+    if (!keys.isEmpty()) {
+        QSqlQuery query(m_database);
+        query.setForwardOnly(true);
+        const QString queryString = QStringLiteral("SELECT %1 FROM %2 WHERE %3 IN (%4)")
+                                            .arg(m_tableColumns.join(","),
+                                                    m_tableName,
+                                                    m_tableColumns[keyColumn],
+                                                    keys.join(","));
+        if (!query.exec(queryString)) {
+            LOG_FAILED_QUERY(query);
+        }
+        while (query.next()) {
+            const TrackId trackId(query.value(kIdColumn));
+            QVector<int> rows;
+            if (keyColumn == kIdColumn) {
+                rows = m_trackIdToRows.value(trackId);
+            } else {
+                rows.append(m_trackPosToRow.value(query.value(keyColumn).toInt(), -1));
+            }
+            for (int row : std::as_const(rows)) {
+                if (row < firstRow || row >= firstRow + numRows) {
+                    continue;
+                }
+                // The table might have been modified since the rows
+                // have been selected.
+                if (m_rowInfo[row].trackId != trackId) {
+                    continue;
+                }
+                const int offset = (row - firstRow) * numColumns;
+                for (int column = 0; column < numColumns; ++column) {
+                    columnValues[offset + column] = query.value(column);
+                }
+            }
+        }
+    }
+    if (sDebug) {
+        qDebug() << this << "fetched" << numRows << "rows of page" << page;
+    }
+
+    m_rowPages.insert(page, std::move(columnValues));
+    m_recentRowPages.append(page);
+}
+
 void BaseSqlTableModel::select() {
     if (!m_bInitialized) {
         return;
@@ -221,9 +334,15 @@ void BaseSqlTableModel::select() {
     PerformanceTimer time;
     time.start();
 
-    // Prepare query for id and all columns not in m_trackSource
+    // Only the id and the position of all rows are needed for sorting and
+    // mapping tracks to rows. All other table columns are fetched lazily.
+    const int posColumn = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+    QStringList selectColumns = {m_tableColumns[kIdColumn]};
+    if (hasPositionColumn()) {
+        selectColumns.append(m_tableColumns[posColumn]);
+    }
     QString queryString = QString("SELECT %1 FROM %2 %3")
-                                  .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+                                  .arg(selectColumns.join(","), m_tableName, m_tableOrderBy);
 
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
@@ -252,40 +371,17 @@ void BaseSqlTableModel::select() {
     // in advance.
     QVector<RowInfo> rowInfos;
     QSet<TrackId> trackIds;
-    int idColumn = -1;
-    int posColumn = -1;
     while (query.next()) {
-        QSqlRecord sqlRecord = query.record();
-
-        if (idColumn < 0) {
-            idColumn = sqlRecord.indexOf(m_idColumn);
-        }
-
-        if (posColumn == -1 && hasPositionColumn()) {
-            posColumn = sqlRecord.indexOf(PLAYLISTTABLE_POSITION);
-        }
-
-        // TODO(XXX): Can we get rid of the hard-coded assumption that
-        // the the first column always contains the id?
-        DEBUG_ASSERT(idColumn == kIdColumn);
-
-        VERIFY_OR_DEBUG_ASSERT(idColumn != -1) {
-            qCritical()
-                    << "ID column not available in database query results:"
-                    << m_idColumn;
-            return;
-        }
-
-        TrackId trackId(sqlRecord.value(idColumn));
+        TrackId trackId(query.value(kIdColumn));
         trackIds.insert(trackId);
 
         RowInfo rowInfo;
         rowInfo.trackId = trackId;
         rowInfo.row = rowInfos.size();
-
-        rowInfo.columnValues.reserve(sqlRecord.count());
-        for (int i = 0; i < m_tableColumns.size(); ++i) {
-            rowInfo.columnValues.push_back(sqlRecord.value(i));
+        if (hasPositionColumn()) {
+            bool ok = false;
+            const int position = query.value(1).toInt(&ok);
+            rowInfo.position = ok ? position : -1;
         }
         rowInfos.push_back(rowInfo);
     }
@@ -347,7 +443,7 @@ void BaseSqlTableModel::select() {
         trackPosToRows.reserve(rowInfos.size());
         for (int i = 0; i < rowInfos.size(); ++i) {
             const RowInfo& rowInfo = rowInfos[i];
-            trackPosToRows.insert(rowInfo.getPosition(posColumn), i);
+            trackPosToRows.insert(rowInfo.position, i);
         }
         DEBUG_ASSERT(trackPosToRows.size() == rowInfos.size());
     }
@@ -674,13 +770,21 @@ QVariant BaseSqlTableModel::rawValue(
             return previewDeckTrackId() == trackId;
         }
 
-        const QVector<QVariant>& columnValues = rowInfo.columnValues;
+        if (column == kIdColumn) {
+            return trackId.toVariant();
+        }
+
+        const QVector<QVariant>& columnValues = rowPage(row / kRowsPerPage);
+        const int offset = (row % kRowsPerPage) * m_tableColumns.size() + column;
+        if (offset >= columnValues.size()) {
+            return QVariant();
+        }
         if (sDebug) {
             qDebug() << "Returning table-column value"
-                     << columnValues.at(column)
+                     << columnValues.at(offset)
                      << "for column" << column;
         }
-        return columnValues[column];
+        return columnValues.at(offset);
     }
 
     // Otherwise, return the information from the track record cache for the
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QHash>
+#include <QList>
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackdao.h"
@@ -12,6 +13,11 @@ class TrackCollectionManager;
 
 // BaseSqlTableModel is a custom-written SQL-backed table which aggressively
 // caches the contents of the table and supports lightweight updates.
+//
+// Only the ids of all rows are loaded by select(). The remaining values
+// of the table columns are fetched in pages of consecutive rows when they
+// are accessed for the first time, i.e. usually only for the rows that
+// are visible. The next page in scroll direction is prefetched.
 class BaseSqlTableModel : public BaseTrackTableModel {
     Q_OBJECT
   public:
@@ -101,7 +107,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     QList<TrackRef> getTrackRefs(const QModelIndexList& indices) const;
 
-    bool hasPositionColumn() {
+    bool hasPositionColumn() const {
         return fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION) >= 0;
     }
 
@@ -127,19 +133,8 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     struct RowInfo {
         TrackId trackId;
         int row;
-        QVector<QVariant> columnValues;
-
-        int getPosition(int posCol) const {
-            if (posCol < 0) {
-                return -1;
-            }
-            bool ok = false;
-            int pos = columnValues.at(posCol).toInt(&ok);
-            if (ok) {
-                return pos;
-            }
-            return -1;
-        }
+        // Only valid if the table has a position column
+        int position = -1;
 
         bool operator<(const RowInfo& other) const {
             // -1 is greater than anything
@@ -161,8 +156,20 @@ class BaseSqlTableModel : public BaseTrackTableModel {
             TrackId2Rows&& trackIdToRows,
             TrackPos2Row&& trackPosToRows);
 
+    /// Returns the values of all table columns for the rows of the
+    /// given page. Fetches the page on demand.
+    const QVector<QVariant>& rowPage(int page) const;
+    void fetchRowPage(int page) const;
+    void prefetchRowPage(int page) const;
+    void clearRowPages();
+
     QVector<RowInfo> m_rowInfo;
 
+    // Cached pages of table column values, the most recently used last
+    mutable QHash<int, QVector<QVariant>> m_rowPages;
+    mutable QList<int> m_recentRowPages;
+    mutable int m_lastAccessedRowPage;
+
     QString m_idColumn;
     QSharedPointer<BaseTrackCache> m_trackSource;
     QStringList m_tableColumns;
@@ -176,5 +183,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     QVector<QHash<int, QVariant>> m_headerInfo;
     QString m_trackSourceOrderBy;
 
+    friend class BaseSqlTableModelTest;
+
     DISALLOW_COPY_AND_ASSIGN(BaseSqlTableModel);
 };
@@ -29,7 +29,9 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
           m_columnCache(std::move(columns)),
           m_pQueryParser(std::make_unique<SearchQueryParser>(
                   pTrackCollection, std::move(searchColumns))),
+          m_columnarIndex(m_columnCache, m_collator),
           m_bIndexBuilt(false),
+          m_bLastSearchValid(false),
           m_bIsCaching(isCaching),
           m_database(pTrackCollection->database()) {
 }
@@ -63,6 +65,7 @@ void BaseTrackCache::slotTracksAddedOrChanged(const QSet<TrackId>& trackIds) {
     if (sDebug) {
         qDebug() << this << "slotTracksAddedOrChanged" << trackIds.size();
     }
+    m_bLastSearchValid = false;
     updateTracksInIndex(trackIds);
 }
 
@@ -70,6 +73,7 @@ void BaseTrackCache::slotScanTrackAdded(TrackPointer pTrack) {
     if (sDebug) {
         qDebug() << this << "slotScanTrackAdded";
     }
+    m_bLastSearchValid = false;
     updateTrackInIndex(pTrack);
 }
 
@@ -77,12 +81,22 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
     if (sDebug) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
+    m_bLastSearchValid = false;
     for (const auto& trackId : std::as_const(trackIds)) {
         m_trackInfo.remove(trackId);
+        m_columnarIndex.removeRow(trackId);
         m_dirtyTracks.remove(trackId);
     }
 }
 
+void BaseTrackCache::slotTrackMembershipChanged() {
+    if (sDebug) {
+        qDebug() << this << "slotTrackMembershipChanged";
+    }
+    // The previous results can't be refined
+    m_bLastSearchValid = false;
+}
+
 void BaseTrackCache::slotTrackDirty(TrackId trackId) {
     if (sDebug) {
         qDebug() << this << "slotTrackDirty" << trackId;
@@ -95,10 +109,15 @@ void BaseTrackCache::slotTrackClean(TrackId trackId) {
         qDebug() << this << "slotTrackClean" << trackId;
     }
     m_dirtyTracks.remove(trackId);
+    m_bLastSearchValid = false;
     // The track might have been reloaded from the database
     updateTrackInIndex(trackId);
 }
 
+void BaseTrackCache::enableSearchIndex() {
+    m_pQueryParser->setSearchIndexIdColumn(m_idColumn);
+}
+
 bool BaseTrackCache::isCached(TrackId trackId) const {
     return m_trackInfo.contains(trackId);
 }
@@ -116,7 +135,7 @@ const TrackPointer& BaseTrackCache::getCachedTrack(TrackId trackId) const {
     if (m_recentTrackId != trackId) {
         if (trackId.isValid()) {
             TrackPointer trackPtr =
-                    GlobalTrackCacheLocker().lookupTrackById(trackId);
+                    GlobalTrackCache::lookupTrackById(trackId);
             if (!trackPtr) {
                 resetRecentTrack();
             } else {
@@ -172,6 +191,7 @@ bool BaseTrackCache::updateTrackInIndex(
         for (int i = 0; i < numColumns; ++i) {
             record[i] = getTrackValueForColumn(pTrack, i);
         }
+        m_columnarIndex.updateRow(trackId, record);
         if (m_bIsCaching) {
             replaceRecentTrack(trackId, pTrack);
         }
@@ -223,6 +243,7 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
                 record[i] = query.value(i);
             }
         }
+        m_columnarIndex.updateRow(trackId, record);
     }
 
     qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
@@ -245,6 +266,8 @@ void BaseTrackCache::buildIndex() {
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
     m_trackInfo.clear();
+    m_columnarIndex.clear();
+    m_bLastSearchValid = false;
     if (m_bIsCaching) {
         resetRecentTrack();
     }
@@ -455,72 +478,127 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         buildIndex();
     }
 
-    QStringList idStrings;
-    // TODO(rryan) consider making this the data passed in and a separate
-    // QVector for output
     QSet<TrackId> dirtyTracks;
-    for (const auto& trackId: trackIds) {
-        idStrings << trackId.toString();
+    for (const auto& trackId : trackIds) {
         if (m_dirtyTracks.contains(trackId)) {
             dirtyTracks.insert(trackId);
         }
     }
 
-    QStringList queryFragments;
-    if (!extraFilter.isNull() && extraFilter != "") {
-        queryFragments << QString("(%1)").arg(extraFilter);
+    // If the query has only been extended since the previous search, e.g.
+    // while typing, only the previous results need to be filtered. Dirty
+    // tracks might match now even if they didn't before.
+    QSet<TrackId> refinedTrackIds;
+    const QSet<TrackId>* pCandidateTrackIds = &trackIds;
+    if (m_bLastSearchValid &&
+            extraFilter == m_lastSearchExtraFilter &&
+            trackIds == m_lastSearchTrackIds &&
+            SearchQueryParser::queryIsMoreSpecific(m_lastSearchQuery, searchQuery)) {
+        refinedTrackIds = m_lastSearchResult;
+        refinedTrackIds.unite(dirtyTracks);
+        pCandidateTrackIds = &refinedTrackIds;
+        if (sDebug) {
+            qDebug() << this << "Refining previous search results:"
+                     << refinedTrackIds.size() << "of" << trackIds.size();
+        }
     }
-    if (idStrings.size() > 0) {
-        queryFragments << QString("%1 in (%2)")
-                .arg(m_idColumn, idStrings.join(","));
+    m_lastSearchQuery = searchQuery;
+    m_lastSearchExtraFilter = extraFilter;
+    m_lastSearchTrackIds = trackIds;
+    m_bLastSearchValid = false;
+
+    if (pCandidateTrackIds->isEmpty()) {
+        // Nothing matched the previous search and there are no dirty tracks
+        m_trackOrder.resize(0); // keeps allocated memory
+        trackToIndex->clear();
+        m_lastSearchResult.clear();
+        m_bLastSearchValid = true;
+        return;
     }
 
-    const std::unique_ptr<QueryNode> pQuery =
-            m_pQueryParser->parseQuery(
-                    searchQuery,
-                    queryFragments.join(" AND "));
-
-    QString filter = pQuery->toSql();
-    if (!filter.isEmpty()) {
-        filter.prepend("WHERE ");
+    std::unique_ptr<QueryNode> pQuery;
+    if (extraFilter.isEmpty()) {
+        // Avoid querying the database if possible
+        pQuery = m_pQueryParser->parseQuery(searchQuery, QString());
+        if (!filterAndSortIndexed(*pCandidateTrackIds,
+                    *pQuery,
+                    orderByClause,
+                    sortColumns,
+                    columnOffset,
+                    trackToIndex)) {
+            pQuery.reset();
+        }
     }
 
-    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
+    if (!pQuery) {
+        QStringList idStrings;
+        idStrings.reserve(pCandidateTrackIds->size());
+        for (const auto& trackId : *pCandidateTrackIds) {
+            idStrings << trackId.toString();
+        }
 
-    if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
-    }
+        QStringList queryFragments;
+        if (!extraFilter.isEmpty()) {
+            queryFragments << QString("(%1)").arg(extraFilter);
+        }
+        if (idStrings.size() > 0) {
+            queryFragments << QString("%1 in (%2)")
+                                      .arg(m_idColumn, idStrings.join(","));
+        }
 
-    QSqlQuery query(m_database);
-    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
-    // won't allocate a giant in-memory table that we won't use at all.
-    query.setForwardOnly(true);
-    query.prepare(queryString);
+        pQuery = m_pQueryParser->parseQuery(
+                searchQuery,
+                queryFragments.join(" AND "));
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
+        QString filter = pQuery->toSql();
+        if (!filter.isEmpty()) {
+            filter.prepend("WHERE ");
+        }
 
-    int idColumn = query.record().indexOf(m_idColumn);
-    int rows = query.size();
+        QString queryString = QString("SELECT %1 FROM %2 %3 %4")
+                                      .arg(m_idColumn, m_tableName, filter, orderByClause);
 
-    if (sDebug) {
-        qDebug() << "Rows returned:" << rows;
-    }
+        if (sDebug) {
+            qDebug() << this << "select() executing:" << queryString;
+        }
 
-    m_trackOrder.resize(0); // keeps allocated memory
-    trackToIndex->clear();
-    if (rows > 0) {
-        trackToIndex->reserve(rows);
-        m_trackOrder.reserve(rows);
+        QSqlQuery query(m_database);
+        // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
+        // won't allocate a giant in-memory table that we won't use at all.
+        query.setForwardOnly(true);
+        query.prepare(queryString);
+
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+        }
+
+        int idColumn = query.record().indexOf(m_idColumn);
+        int rows = query.size();
+
+        if (sDebug) {
+            qDebug() << "Rows returned:" << rows;
+        }
+
+        m_trackOrder.resize(0); // keeps allocated memory
+        trackToIndex->clear();
+        if (rows > 0) {
+            trackToIndex->reserve(rows);
+            m_trackOrder.reserve(rows);
+        }
+
+        while (query.next()) {
+            TrackId trackId(query.value(idColumn));
+            (*trackToIndex)[trackId] = m_trackOrder.size();
+            m_trackOrder.append(trackId);
+        }
     }
 
-    while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+    m_lastSearchResult.clear();
+    m_lastSearchResult.reserve(trackToIndex->size());
+    for (auto it = trackToIndex->constBegin(); it != trackToIndex->constEnd(); ++it) {
+        m_lastSearchResult.insert(it.key());
     }
+    m_bLastSearchValid = true;
 
     // At this point, the original set of tracks have been divided into two
     // pieces: those that should be in the result set and those that should
@@ -539,7 +617,7 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         // Only get the track if it is in the cache. Tracks that
         // are not cached in memory cannot be dirty.
         // Bypass getCachedTrack() to not invalidate m_recentTrackId
-        TrackPointer pTrack = GlobalTrackCacheLocker().lookupTrackById(trackId);
+        TrackPointer pTrack = GlobalTrackCache::lookupTrackById(trackId);
         if (!pTrack) {
             continue;
         }
@@ -597,6 +675,59 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     }
 }
 
+bool BaseTrackCache::filterAndSortIndexed(const QSet<TrackId>& trackIds,
+        const QueryNode& query,
+        const QString& orderByClause,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        QHash<TrackId, int>* trackToIndex) {
+    PerformanceTimer timer;
+    timer.start();
+
+    // The order is only relevant if the results are sorted by track columns
+    const bool sorted = !orderByClause.isEmpty();
+    if (sorted && !m_columnarIndex.canSort(sortColumns, columnOffset)) {
+        return false;
+    }
+    std::vector<uint8_t> matches;
+    if (!query.matchIndexed(m_columnarIndex, &matches)) {
+        return false;
+    }
+
+    std::vector<int> rows;
+    rows.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        const int row = m_columnarIndex.rowOf(trackId);
+        if (row < 0) {
+            // Not yet indexed
+            return false;
+        }
+        if (matches[row] == ColumnarTrackIndex::kRowTrue) {
+            rows.push_back(row);
+        }
+    }
+    // Without sort columns the rows are only ordered by track id
+    m_columnarIndex.sortRows(&rows,
+            sorted ? sortColumns : QList<SortColumn>(),
+            columnOffset);
+
+    m_trackOrder.resize(0); // keeps allocated memory
+    m_trackOrder.reserve(static_cast<int>(rows.size()));
+    trackToIndex->clear();
+    trackToIndex->reserve(static_cast<int>(rows.size()));
+    for (const int row : rows) {
+        const TrackId trackId = m_columnarIndex.trackIdAt(row);
+        (*trackToIndex)[trackId] = m_trackOrder.size();
+        m_trackOrder.append(trackId);
+    }
+
+    if (sDebug) {
+        qDebug() << this << "filterAndSortIndexed took"
+                 << timer.elapsed().debugMillisWithUnit();
+    }
+    return true;
+}
+
 int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         const QList<SortColumn>& sortColumns,
         const int columnOffset,
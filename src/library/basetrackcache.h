@@ -10,12 +10,14 @@
 #include <QVector>
 #include <memory>
 
+#include "library/columnartrackindex.h"
 #include "library/columncache.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
 #include "util/string.h"
 
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
 
@@ -71,6 +73,10 @@ class BaseTrackCache : public QObject {
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                QHash<TrackId, int>* trackToIndex);
+    /// Narrow down text searches with the TrackSearchIndex. Only
+    /// applicable if the id column contains the library ids.
+    void enableSearchIndex();
+
     virtual bool isCached(TrackId trackId) const;
     virtual void ensureCached(TrackId trackId);
 
@@ -84,6 +90,9 @@ class BaseTrackCache : public QObject {
     void slotTracksRemoved(const QSet<TrackId>& trackId);
     void slotTrackDirty(TrackId trackId);
     void slotTrackClean(TrackId trackId);
+    /// Invoked when tracks have been added to or removed from a track
+    /// set that could be referenced by a search query, e.g. a crate.
+    void slotTrackMembershipChanged();
 
   private:
     const TrackPointer& getCachedTrack(TrackId trackId) const;
@@ -97,6 +106,15 @@ class BaseTrackCache : public QObject {
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
     QVariant getTrackValueForColumn(TrackPointer pTrack, int column) const;
 
+    // Filter and sort the tracks without querying the database. Returns
+    // false if the query or the sort columns are not covered by the index.
+    bool filterAndSortIndexed(const QSet<TrackId>& trackIds,
+            const QueryNode& query,
+            const QString& orderByClause,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset,
+            QHash<TrackId, int>* trackToIndex);
+
     int findSortInsertionPoint(TrackPointer pTrack,
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
@@ -124,9 +142,16 @@ class BaseTrackCache : public QObject {
 
     const mixxx::StringCollator m_collator;
 
+    // Mirrors the indexed columns of m_trackInfo
+    ColumnarTrackIndex m_columnarIndex;
+
     // Temporary storage for filterAndSort()
 
     QVector<TrackId> m_trackOrder;
+    QString m_lastSearchQuery;
+    QString m_lastSearchExtraFilter;
+    QSet<TrackId> m_lastSearchTrackIds;
+    QSet<TrackId> m_lastSearchResult;
 
     // Remember key and value of the most recent cache lookup to avoid querying
     // the global track cache again and again while populating the columns
@@ -141,6 +166,9 @@ class BaseTrackCache : public QObject {
     mutable QSet<TrackId> m_dirtyTracks;
 
     bool m_bIndexBuilt;
+    // The previous search of filterAndSort() that might be refined by
+    // the next search
+    bool m_bLastSearchValid;
     bool m_bIsCaching;
     QHash<TrackId, QVector<QVariant>> m_trackInfo;
     QSqlDatabase m_database;
@@ -0,0 +1,338 @@
+#include "library/columnartrackindex.h"
+
+#include <QDir>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "library/basetrackcache.h"
+#include "util/db/dbconnection.h"
+
+namespace {
+
+// Text columns that are either collated in ORDER BY clauses or are
+// only matched with LIKE, see also ColumnCache.
+const ColumnCache::Column kSortableStringColumns[] = {
+        ColumnCache::COLUMN_LIBRARYTABLE_ARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_TITLE,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUM,
+        ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST,
+        ColumnCache::COLUMN_LIBRARYTABLE_GENRE,
+        ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER,
+        ColumnCache::COLUMN_LIBRARYTABLE_GROUPING,
+        ColumnCache::COLUMN_LIBRARYTABLE_COMMENT,
+};
+
+const ColumnCache::Column kSearchableStringColumns[] = {
+        ColumnCache::COLUMN_LIBRARYTABLE_FILETYPE,
+        ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION,
+};
+
+// Numeric columns that are sorted by their plain or integer value
+const ColumnCache::Column kNumberColumns[] = {
+        ColumnCache::COLUMN_LIBRARYTABLE_DURATION,
+        ColumnCache::COLUMN_LIBRARYTABLE_BITRATE,
+        ColumnCache::COLUMN_LIBRARYTABLE_BPM,
+        ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN,
+        ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE,
+        ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS,
+        ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED,
+        ColumnCache::COLUMN_LIBRARYTABLE_RATING,
+};
+
+constexpr double kNullNumber = -std::numeric_limits<double>::infinity();
+
+} // anonymous namespace
+
+ColumnarTrackIndex::ColumnarTrackIndex(
+        const ColumnCache& columnCache,
+        const mixxx::StringCollator& collator)
+        : m_collator(collator),
+          m_locationFieldIndex(columnCache.fieldIndex(
+                  ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION)) {
+    const auto addStringColumn = [this, &columnCache](
+                                         ColumnCache::Column column,
+                                         bool sortable) {
+        const int fieldIndex = columnCache.fieldIndex(column);
+        if (fieldIndex < 0) {
+            return;
+        }
+        StringColumn stringColumn;
+        stringColumn.name = columnCache.columnNameForFieldIndex(fieldIndex);
+        stringColumn.fieldIndex = fieldIndex;
+        stringColumn.sortable = sortable;
+        stringColumn.ranksValid = false;
+        m_stringColumns.push_back(std::move(stringColumn));
+    };
+    for (const auto column : kSortableStringColumns) {
+        addStringColumn(column, true);
+    }
+    for (const auto column : kSearchableStringColumns) {
+        addStringColumn(column, false);
+    }
+    for (const auto column : kNumberColumns) {
+        const int fieldIndex = columnCache.fieldIndex(column);
+        if (fieldIndex >= 0) {
+            m_numberColumns.push_back(NumberColumn{fieldIndex, {}});
+        }
+    }
+}
+
+void ColumnarTrackIndex::clear() {
+    for (auto& column : m_stringColumns) {
+        column.idsByValue.clear();
+        column.likeValues.clear();
+        column.sortKeys.clear();
+        column.ranks.clear();
+        column.ranksValid = false;
+        column.rows.clear();
+    }
+    for (auto& column : m_numberColumns) {
+        column.rows.clear();
+    }
+    m_trackIds.clear();
+    m_rowsByTrackId.clear();
+}
+
+int ColumnarTrackIndex::internString(
+        StringColumn* pColumn,
+        const QVariant& value) {
+    if (value.isNull()) {
+        return kNullString;
+    }
+    QString string = value.toString();
+    if (pColumn->fieldIndex == m_locationFieldIndex) {
+        // The cache contains the display string with native separators,
+        // the database the location with Qt separators.
+        string = QDir::fromNativeSeparators(string);
+    }
+    const auto it = pColumn->idsByValue.constFind(string);
+    if (it != pColumn->idsByValue.constEnd()) {
+        return it.value();
+    }
+    const int id = static_cast<int>(pColumn->likeValues.size());
+    pColumn->idsByValue.insert(string, id);
+    if (pColumn->sortable) {
+        pColumn->sortKeys.push_back(m_collator.sortKey(string));
+        pColumn->ranksValid = false;
+    }
+    mixxx::DbConnection::makeStringLatinLow(&string);
+    pColumn->likeValues.push_back(std::move(string));
+    return id;
+}
+
+void ColumnarTrackIndex::updateRow(
+        TrackId trackId,
+        const QVector<QVariant>& record) {
+    int row = rowOf(trackId);
+    if (row < 0) {
+        row = rowCount();
+        m_trackIds.push_back(trackId);
+        m_rowsByTrackId.insert(trackId, row);
+        for (auto& column : m_stringColumns) {
+            column.rows.push_back(kNullString);
+        }
+        for (auto& column : m_numberColumns) {
+            column.rows.push_back(kNullNumber);
+        }
+    }
+    for (auto& column : m_stringColumns) {
+        column.rows[row] = internString(
+                &column, record.value(column.fieldIndex));
+    }
+    for (auto& column : m_numberColumns) {
+        const QVariant value = record.value(column.fieldIndex);
+        bool ok = false;
+        const double number = value.toDouble(&ok);
+        column.rows[row] = (value.isNull() || !ok) ? kNullNumber : number;
+    }
+}
+
+void ColumnarTrackIndex::removeRow(TrackId trackId) {
+    const int row = rowOf(trackId);
+    if (row < 0) {
+        return;
+    }
+    // Fill the gap with the last row. Interned strings are only
+    // released when clearing the index.
+    const int lastRow = rowCount() - 1;
+    if (row != lastRow) {
+        m_trackIds[row] = m_trackIds[lastRow];
+        m_rowsByTrackId.insert(m_trackIds[row], row);
+        for (auto& column : m_stringColumns) {
+            column.rows[row] = column.rows[lastRow];
+        }
+        for (auto& column : m_numberColumns) {
+            column.rows[row] = column.rows[lastRow];
+        }
+    }
+    m_trackIds.pop_back();
+    m_rowsByTrackId.remove(trackId);
+    for (auto& column : m_stringColumns) {
+        column.rows.pop_back();
+    }
+    for (auto& column : m_numberColumns) {
+        column.rows.pop_back();
+    }
+}
+
+const ColumnarTrackIndex::StringColumn* ColumnarTrackIndex::findStringColumn(
+        const QString& columnName) const {
+    for (const auto& column : m_stringColumns) {
+        if (column.name == columnName) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+const ColumnarTrackIndex::StringColumn* ColumnarTrackIndex::findSortableStringColumn(
+        int fieldIndex) const {
+    for (const auto& column : m_stringColumns) {
+        if (column.fieldIndex == fieldIndex) {
+            return column.sortable ? &column : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+const ColumnarTrackIndex::NumberColumn* ColumnarTrackIndex::findNumberColumn(
+        int fieldIndex) const {
+    for (const auto& column : m_numberColumns) {
+        if (column.fieldIndex == fieldIndex) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+bool ColumnarTrackIndex::matchLike(
+        const QString& columnName,
+        const QString& pattern,
+        RowMask* pMatches) const {
+    const StringColumn* pColumn = findStringColumn(columnName);
+    if (!pColumn) {
+        return false;
+    }
+    DEBUG_ASSERT(pMatches->size() == m_trackIds.size());
+    // Each distinct value only needs to be matched once
+    RowMask valueMatches(pColumn->likeValues.size());
+    for (std::size_t id = 0; id < pColumn->likeValues.size(); ++id) {
+        valueMatches[id] = mixxx::DbConnection::likeCompareLatinLowConverted(
+                                   pattern, pColumn->likeValues[id])
+                ? kRowTrue
+                : kRowFalse;
+    }
+    for (std::size_t row = 0; row < pColumn->rows.size(); ++row) {
+        const int id = pColumn->rows[row];
+        // LIKE evaluates to NULL for NULL values
+        const uint8_t match = id == kNullString ? kRowNull : valueMatches[id];
+        (*pMatches)[row] = std::max((*pMatches)[row], match);
+    }
+    return true;
+}
+
+bool ColumnarTrackIndex::matchNullOrEmpty(
+        const QString& columnName,
+        RowMask* pMatches) const {
+    const StringColumn* pColumn = findStringColumn(columnName);
+    if (!pColumn) {
+        return false;
+    }
+    DEBUG_ASSERT(pMatches->size() == m_trackIds.size());
+    const int emptyId = pColumn->idsByValue.value(QString(""), kNullString);
+    for (std::size_t row = 0; row < pColumn->rows.size(); ++row) {
+        const int id = pColumn->rows[row];
+        if (id == kNullString || id == emptyId) {
+            (*pMatches)[row] = kRowTrue;
+        }
+    }
+    return true;
+}
+
+void ColumnarTrackIndex::updateRanks(const StringColumn& column) const {
+    DEBUG_ASSERT(column.sortable);
+    if (column.ranksValid) {
+        return;
+    }
+    // Values that are equal according to the collation get the same rank
+    std::vector<int> order(column.sortKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&column](int lhs, int rhs) {
+        return column.sortKeys[lhs].compare(column.sortKeys[rhs]) < 0;
+    });
+    column.ranks.resize(order.size());
+    int rank = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 &&
+                column.sortKeys[order[i - 1]].compare(column.sortKeys[order[i]]) != 0) {
+            ++rank;
+        }
+        column.ranks[order[i]] = rank;
+    }
+    column.ranksValid = true;
+}
+
+bool ColumnarTrackIndex::canSort(
+        const QList<SortColumn>& sortColumns,
+        int columnOffset) const {
+    for (const auto& sortColumn : sortColumns) {
+        const int fieldIndex = sortColumn.m_column - columnOffset;
+        if (!findSortableStringColumn(fieldIndex) && !findNumberColumn(fieldIndex)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnarTrackIndex::sortRows(
+        std::vector<int>* pRows,
+        const QList<SortColumn>& sortColumns,
+        int columnOffset) const {
+    DEBUG_ASSERT(canSort(sortColumns, columnOffset));
+    // Resolve the columns once instead of for each comparison
+    struct SortKey {
+        const StringColumn* pStringColumn;
+        const NumberColumn* pNumberColumn;
+        bool descending;
+    };
+    std::vector<SortKey> sortKeys;
+    sortKeys.reserve(sortColumns.size());
+    for (const auto& sortColumn : sortColumns) {
+        const int fieldIndex = sortColumn.m_column - columnOffset;
+        SortKey sortKey{findSortableStringColumn(fieldIndex),
+                findNumberColumn(fieldIndex),
+                sortColumn.m_order == Qt::DescendingOrder};
+        if (sortKey.pStringColumn) {
+            updateRanks(*sortKey.pStringColumn);
+        }
+        sortKeys.push_back(sortKey);
+    }
+    std::sort(pRows->begin(), pRows->end(), [this, &sortKeys](int lhs, int rhs) {
+        for (const auto& sortKey : sortKeys) {
+            int result;
+            if (sortKey.pStringColumn) {
+                const int lhsId = sortKey.pStringColumn->rows[lhs];
+                const int rhsId = sortKey.pStringColumn->rows[rhs];
+                // NULL values are sorted first like in SQL
+                const int lhsRank = lhsId == kNullString
+                        ? -1
+                        : sortKey.pStringColumn->ranks[lhsId];
+                const int rhsRank = rhsId == kNullString
+                        ? -1
+                        : sortKey.pStringColumn->ranks[rhsId];
+                result = (lhsRank > rhsRank) - (lhsRank < rhsRank);
+            } else {
+                const double lhsValue = sortKey.pNumberColumn->rows[lhs];
+                const double rhsValue = sortKey.pNumberColumn->rows[rhs];
+                result = (lhsValue > rhsValue) - (lhsValue < rhsValue);
+            }
+            if (result != 0) {
+                return sortKey.descending ? result > 0 : result < 0;
+            }
+        }
+        // The order of the given rows is arbitrary, e.g. the iteration
+        // order of a QSet
+        return m_trackIds[lhs] < m_trackIds[rhs];
+    });
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QCollator>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <cstdint>
+#include <vector>
+
+#include "library/columncache.h"
+#include "track/trackid.h"
+#include "util/string.h"
+
+class SortColumn;
+
+/// A column-oriented copy of the rows cached by BaseTrackCache.
+///
+/// Only a subset of the columns is stored: Text columns with interned
+/// strings and precomputed collation keys, and numeric columns as plain
+/// arrays. This allows to filter and sort tracks by these columns without
+/// querying the database. Callers need to fall back to SQL for all other
+/// columns.
+class ColumnarTrackIndex {
+  public:
+    /// The result of a condition for a row with the three-valued logic
+    /// of SQL, e.g. a LIKE comparison with a NULL value is NULL. The
+    /// values are ordered such that AND and OR correspond to the minimum
+    /// and maximum and NOT to the difference from kRowTrue. Only rows
+    /// that evaluate to kRowTrue match a query.
+    enum RowMatch : uint8_t {
+        kRowFalse = 0,
+        kRowNull = 1,
+        kRowTrue = 2,
+    };
+    /// One RowMatch value per row
+    using RowMask = std::vector<uint8_t>;
+
+    ColumnarTrackIndex(
+            const ColumnCache& columnCache,
+            const mixxx::StringCollator& collator);
+
+    void clear();
+
+    /// Insert or replace the values of a track. The record contains the
+    /// values of all columns of the ColumnCache.
+    void updateRow(TrackId trackId, const QVector<QVariant>& record);
+    void removeRow(TrackId trackId);
+
+    int rowCount() const {
+        return static_cast<int>(m_trackIds.size());
+    }
+    /// Returns -1 if the track is not indexed.
+    int rowOf(TrackId trackId) const {
+        return m_rowsByTrackId.value(trackId, -1);
+    }
+    TrackId trackIdAt(int row) const {
+        return m_trackIds[row];
+    }
+
+    /// Combine the matches of a LIKE pattern with the given column by OR,
+    /// i.e. rows with a matching value are set to kRowTrue and rows with
+    /// a NULL value that did not match before are set to kRowNull. The
+    /// pattern must have been converted by DbConnection::makeStringLatinLow().
+    ///
+    /// Returns false if the column is not indexed.
+    bool matchLike(
+            const QString& columnName,
+            const QString& pattern,
+            RowMask* pMatches) const;
+    /// Set all rows with a NULL or empty value in the given column to
+    /// kRowTrue. Other rows are not modified.
+    ///
+    /// Returns false if the column is not indexed.
+    bool matchNullOrEmpty(
+            const QString& columnName,
+            RowMask* pMatches) const;
+
+    /// Check if all sort columns are covered by the index. The column
+    /// numbers are shifted by columnOffset like for
+    /// BaseTrackCache::filterAndSort().
+    bool canSort(
+            const QList<SortColumn>& sortColumns,
+            int columnOffset) const;
+    /// Sort the given rows like ORDER BY with the collation of string
+    /// columns that is used by the database. Rows with equal values are
+    /// ordered by their track id to get a deterministic order.
+    void sortRows(
+            std::vector<int>* pRows,
+            const QList<SortColumn>& sortColumns,
+            int columnOffset) const;
+
+  private:
+    static constexpr int kNullString = -1;
+
+    struct StringColumn {
+        QString name;
+        int fieldIndex;
+        bool sortable;
+        // Distinct values, converted for LIKE matching
+        QHash<QString, int> idsByValue;
+        std::vector<QString> likeValues;
+        // Only available if sortable
+        std::vector<QCollatorSortKey> sortKeys;
+        mutable std::vector<int> ranks;
+        mutable bool ranksValid;
+        // Value id per row
+        std::vector<int> rows;
+    };
+
+    struct NumberColumn {
+        int fieldIndex;
+        // NULL values are stored as -infinity to sort them first
+        std::vector<double> rows;
+    };
+
+    int internString(StringColumn* pColumn, const QVariant& value);
+    void updateRanks(const StringColumn& column) const;
+
+    const StringColumn* findStringColumn(const QString& columnName) const;
+    const StringColumn* findSortableStringColumn(int fieldIndex) const;
+    const NumberColumn* findNumberColumn(int fieldIndex) const;
+
+    const mixxx::StringCollator& m_collator;
+    const int m_locationFieldIndex;
+
+    std::vector<StringColumn> m_stringColumns;
+    std::vector<NumberColumn> m_numberColumns;
+
+    std::vector<TrackId> m_trackIds;
+    QHash<TrackId, int> m_rowsByTrackId;
+};
@@ -2,9 +2,13 @@
 
 #include <QFutureWatcher>
 #include <QPixmapCache>
+#include <QThread>
+#include <QThreadPool>
 #include <QtConcurrentRun>
 #include <QtDebug>
+#include <algorithm>
 
+#include "library/coverthumbnailcache.h"
 #include "moc_coverartcache.cpp"
 #include "track/track.h"
 #include "util/logger.h"
@@ -27,9 +31,44 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
     return image.scaledToWidth(width, kTransformationMode);
 }
 
+// The file that contains the cover. Its modification time is compared
+// with that of the thumbnail to detect modified covers.
+QDateTime coverSourceLastModified(const CoverInfo& coverInfo) {
+    auto fileInfo = mixxx::FileInfo(coverInfo.trackLocation);
+    if (coverInfo.type == CoverInfo::FILE) {
+        fileInfo = mixxx::FileInfo(coverInfo.coverLocation);
+        if (fileInfo.isRelative()) {
+            fileInfo = mixxx::FileInfo(
+                    mixxx::FileInfo(coverInfo.trackLocation).locationPath(),
+                    coverInfo.coverLocation);
+        }
+    } else if (coverInfo.type != CoverInfo::METADATA) {
+        return QDateTime();
+    }
+    const auto pToken = Sandbox::openSecurityToken(&fileInfo, true);
+    return fileInfo.lastModified();
+}
+
+// Limits the number of worker threads that are occupied by loading
+// covers. Otherwise all visible covers would be loaded in random order
+// when scrolling through the library and requests for covers that are
+// no longer displayed could not be canceled.
+int maxRunningLoads() {
+    return math_max(2, QThread::idealThreadCount() / 2);
+}
+
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
+CoverArtCache::CoverArtCache(const QString& thumbnailDirPath)
+        : m_nextSequence(0) {
+    if (!thumbnailDirPath.isEmpty()) {
+        m_pThumbnailCache = std::make_shared<const CoverThumbnailCache>(thumbnailDirPath);
+        // Thumbnails of all widths that have ever been displayed would
+        // accumulate otherwise
+        QThreadPool::globalInstance()->start([pThumbnailCache = m_pThumbnailCache] {
+            pThumbnailCache->prune();
+        });
+    }
 }
 
 //static
@@ -51,7 +90,8 @@ void CoverArtCache::requestCoverImpl(
             pRequester,
             pTrack,
             coverInfo,
-            desiredWidth);
+            desiredWidth,
+            Priority::Normal);
 }
 
 //static
@@ -99,7 +139,8 @@ QPixmap CoverArtCache::getCachedCover(
 void CoverArtCache::requestUncachedCover(
         const QObject* pRequester,
         const CoverInfo& coverInfo,
-        int desiredWidth) {
+        int desiredWidth,
+        Priority priority) {
     CoverArtCache* pCache = CoverArtCache::instance();
     VERIFY_OR_DEBUG_ASSERT(pCache) {
         return;
@@ -108,14 +149,16 @@ void CoverArtCache::requestUncachedCover(
             pRequester,
             TrackPointer(),
             coverInfo,
-            desiredWidth);
+            desiredWidth,
+            priority);
 }
 
 // static
 void CoverArtCache::requestUncachedCover(
         const QObject* pRequester,
         const TrackPointer& pTrack,
-        int desiredWidth) {
+        int desiredWidth,
+        Priority priority) {
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
         return;
     }
@@ -128,14 +171,43 @@ void CoverArtCache::requestUncachedCover(
             pRequester,
             pTrack,
             pTrack->getCoverInfoWithLocation(),
-            desiredWidth);
+            desiredWidth,
+            priority);
+}
+
+// static
+void CoverArtCache::cancelCoverRequest(
+        const QObject* pRequester,
+        mixxx::cache_key_t requestedCacheKey) {
+    CoverArtCache* pCache = CoverArtCache::instance();
+    VERIFY_OR_DEBUG_ASSERT(pCache) {
+        return;
+    }
+    auto i = pCache->m_runningRequests.find(requestedCacheKey);
+    while (i != pCache->m_runningRequests.end() && i.key() == requestedCacheKey) {
+        if (i.value().pRequester == pRequester) {
+            i = pCache->m_runningRequests.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    if (pCache->m_runningRequests.contains(requestedCacheKey)) {
+        return;
+    }
+    if (pCache->m_pendingLoads.remove(requestedCacheKey) > 0 &&
+            kLogger.traceEnabled()) {
+        kLogger.trace()
+                << "requestCover canceled"
+                << requestedCacheKey;
+    }
 }
 
 void CoverArtCache::tryLoadCover(
         const QObject* pRequester,
         const TrackPointer& pTrack,
         const CoverInfo& coverInfo,
-        int desiredWidth) {
+        int desiredWidth,
+        Priority priority) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "requestCover"
@@ -156,38 +228,70 @@ void CoverArtCache::tryLoadCover(
     // to avoid loading the same picture again while we are loading it.
     // This fixes also https://github.com/mixxxdj/mixxx/issues/11131 on
     // Windows where simultaneous open the same file from two threads fails.
-    bool requestPending = m_runningRequests.contains(requestedCacheKey);
-    m_runningRequests.insert(requestedCacheKey, {pRequester, desiredWidth});
-    if (requestPending) {
+    m_runningRequests.insert(requestedCacheKey, {pRequester, desiredWidth, priority});
+    if (m_runningLoads.contains(requestedCacheKey)) {
         return;
     }
-
-    if (kLogger.traceEnabled()) {
-        kLogger.trace()
-                << "requestCover starting future for"
-                << coverInfo;
+    const auto pendingLoad = m_pendingLoads.find(requestedCacheKey);
+    if (pendingLoad != m_pendingLoads.end()) {
+        // Repeated requests move the pending load to the front
+        if (pendingLoad.value().priority <= priority) {
+            pendingLoad.value().priority = priority;
+            pendingLoad.value().sequence = m_nextSequence++;
+        }
+        return;
     }
+    m_pendingLoads.insert(requestedCacheKey,
+            {pTrack, coverInfo, desiredWidth, priority, m_nextSequence++});
+    startPendingLoads();
+}
 
-    // The watcher will be deleted in coverLoaded()
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
-            pTrack,
-            coverInfo,
-            desiredWidth);
-    connect(watcher,
-            &QFutureWatcher<FutureResult>::finished,
-            this,
-            &CoverArtCache::coverLoaded);
-    watcher->setFuture(future);
-    return;
+void CoverArtCache::startPendingLoads() {
+    while (m_runningLoads.size() < maxRunningLoads() && !m_pendingLoads.isEmpty()) {
+        const auto nextLoad = std::max_element(
+                m_pendingLoads.begin(),
+                m_pendingLoads.end(),
+                [](const PendingLoad& lhs, const PendingLoad& rhs) {
+                    if (lhs.priority != rhs.priority) {
+                        return lhs.priority < rhs.priority;
+                    }
+                    return lhs.sequence < rhs.sequence;
+                });
+        const mixxx::cache_key_t requestedCacheKey = nextLoad.key();
+        PendingLoad load = std::move(nextLoad.value());
+        m_pendingLoads.erase(nextLoad);
+        m_runningLoads.insert(requestedCacheKey);
+
+        if (kLogger.traceEnabled()) {
+            kLogger.trace()
+                    << "requestCover starting future for"
+                    << load.coverInfo;
+        }
+
+        // The watcher will be deleted in coverLoaded()
+        QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+        QFuture<FutureResult> future = QtConcurrent::run(
+                [pThumbnailCache = m_pThumbnailCache, load = std::move(load)]() {
+                    return loadCover(
+                            load.pTrack,
+                            load.coverInfo,
+                            load.desiredWidth,
+                            pThumbnailCache.get());
+                });
+        connect(watcher,
+                &QFutureWatcher<FutureResult>::finished,
+                this,
+                &CoverArtCache::coverLoaded);
+        watcher->setFuture(future);
+    }
 }
 
 //static
 CoverArtCache::FutureResult CoverArtCache::loadCover(
         TrackPointer pTrack,
         CoverInfo coverInfo,
-        int desiredWidth) {
+        int desiredWidth,
+        const CoverThumbnailCache* pThumbnailCache) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -200,9 +304,42 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     auto res = FutureResult(
             coverInfo.cacheKey());
 
+    // The digest is copied, because the track might update it below
+    const QByteArray imageDigest = coverInfo.imageDigest();
+    const bool thumbnailCacheable = pThumbnailCache &&
+            CoverThumbnailCache::isCacheable(imageDigest, desiredWidth);
+    if (thumbnailCacheable) {
+        QImage thumbnail = pThumbnailCache->load(
+                imageDigest, desiredWidth, coverSourceLastModified(coverInfo));
+        if (!thumbnail.isNull()) {
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.image = std::move(thumbnail);
+            loadedImage.location = pThumbnailCache->filePath(imageDigest, desiredWidth);
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
     CoverInfo::LoadedImage loadedImage = coverInfo.loadImage(pTrack);
     if (!loadedImage.image.isNull()) {
-        if (coverInfo.imageDigest().isEmpty()) {
+        QByteArray loadedImageDigest = imageDigest;
+        if (thumbnailCacheable) {
+            // The cover might have been modified by another application.
+            // The thumbnail must be stored with the digest of the image
+            // that has actually been loaded.
+            loadedImageDigest = CoverImageUtils::calculateDigest(loadedImage.image);
+            if (loadedImageDigest != imageDigest && pTrack) {
+                CoverInfo updatedCoverInfo = coverInfo;
+                updatedCoverInfo.setImageDigest(loadedImage.image);
+                kLogger.info()
+                        << "Updating outdated cover info of track"
+                        << coverInfo.trackLocation;
+                pTrack->setCoverInfo(updatedCoverInfo);
+            }
+        } else if (coverInfo.imageDigest().isEmpty()) {
             // This happens if we have loaded the cover art via the legacy hash
             // and during tests.
             // Refresh hash before resizing the original image!
@@ -221,6 +358,9 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
             // Adjust the cover size according to the request
             // or downsize the image for efficiency.
             loadedImage.image = resizeImageWidth(loadedImage.image, desiredWidth);
+            if (thumbnailCacheable) {
+                pThumbnailCache->save(loadedImageDigest, desiredWidth, loadedImage.image);
+            }
         }
     }
 
@@ -243,6 +383,7 @@ void CoverArtCache::coverLoaded() {
         res = pFutureWatcher->result();
         pFutureWatcher->deleteLater();
     }
+    m_runningLoads.remove(res.requestedCacheKey);
 
     if (kLogger.traceEnabled()) {
         kLogger.trace() << "coverLoaded" << res.coverArt;
@@ -306,8 +447,10 @@ void CoverArtCache::coverLoaded() {
                     i.value().pRequester,
                     nullptr,
                     res.coverArt,
-                    i.value().desiredWidth);
+                    i.value().desiredWidth,
+                    i.value().priority);
         }
         ++i;
     }
+    startPendingLoads();
 }
@@ -1,18 +1,37 @@
 #pragma once
 
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
 #include <QtDebug>
+#include <memory>
 
 #include "library/coverart.h"
 #include "track/track_decl.h"
 #include "util/singleton.h"
 
+class CoverThumbnailCache;
+
+/// Loads cover images asynchronously in worker threads and caches
+/// them in memory as pixmaps. Resized covers are additionally stored
+/// in a persistent CoverThumbnailCache on disk, if available.
+///
+/// Only a limited number of covers is loaded concurrently. Pending
+/// requests are served by priority and the most recent requests
+/// first, because they are most likely still visible. Requests that
+/// are no longer needed, e.g. for table rows that have been scrolled
+/// out of view, can be canceled while they are pending.
 class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     Q_OBJECT
   public:
+    enum class Priority {
+        Normal,
+        /// Covers that are currently displayed in the library table
+        Visible,
+    };
+
     static void requestCover(
             const QObject* pRequester,
             const CoverInfo& coverInfo) {
@@ -30,12 +49,22 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     static void requestUncachedCover(
             const QObject* pRequester,
             const CoverInfo& coverInfo,
-            int desiredWidth);
+            int desiredWidth,
+            Priority priority = Priority::Normal);
 
     static void requestUncachedCover(
             const QObject* pRequester,
             const TrackPointer& pTrack,
-            int desiredWidth);
+            int desiredWidth,
+            Priority priority = Priority::Normal);
+
+    /// Cancels all requests of the requester for the cover. The cover
+    /// is not loaded if no other requests for it are pending. Covers
+    /// that are already being loaded are still cached when finished,
+    /// but the requester is not notified.
+    static void cancelCoverRequest(
+            const QObject* pRequester,
+            mixxx::cache_key_t requestedCacheKey);
 
     // Only public for testing
     struct FutureResult {
@@ -49,12 +78,13 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
         mixxx::cache_key_t requestedCacheKey;
         CoverArt coverArt;
     };
-    // Load cover from path indicated in coverInfo. WARNING: This is run in a
-    // worker thread.
+    // Load cover from path indicated in coverInfo or from the optional
+    // thumbnail cache. WARNING: This is run in a worker thread.
     static FutureResult loadCover(
             TrackPointer pTrack,
             CoverInfo coverInfo,
-            int desiredWidth);
+            int desiredWidth,
+            const CoverThumbnailCache* pThumbnailCache = nullptr);
 
   private slots:
     // Called when loadCover is complete in the main thread.
@@ -67,7 +97,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const QPixmap& pixmap);
 
   protected:
-    CoverArtCache();
+    /// Resized covers are not cached on disk if the path is empty.
+    explicit CoverArtCache(const QString& thumbnailDirPath = QString());
     ~CoverArtCache() override = default;
     friend class Singleton<CoverArtCache>;
 
@@ -82,11 +113,29 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const QObject* pRequester,
             const TrackPointer& pTrack,
             const CoverInfo& info,
-            int desiredWidth);
+            int desiredWidth,
+            Priority priority);
+    void startPendingLoads();
 
     struct RequestData {
         const QObject* pRequester;
         int desiredWidth;
+        Priority priority;
     };
+    // All requests for covers that are either pending or loading
     QMultiHash<mixxx::cache_key_t, RequestData> m_runningRequests;
+
+    struct PendingLoad {
+        TrackPointer pTrack;
+        CoverInfo coverInfo;
+        int desiredWidth;
+        Priority priority;
+        // Monotonically increasing, the most recent load is started first
+        quint64 sequence;
+    };
+    QHash<mixxx::cache_key_t, PendingLoad> m_pendingLoads;
+    QSet<mixxx::cache_key_t> m_runningLoads;
+    quint64 m_nextSequence;
+
+    std::shared_ptr<const CoverThumbnailCache> m_pThumbnailCache;
 };
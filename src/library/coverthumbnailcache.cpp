@@ -0,0 +1,180 @@
+#include "library/coverthumbnailcache.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <algorithm>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CoverThumbnailCache");
+
+const char* const kImageFormat = "JPG";
+
+// Good enough for thumbnails that are only displayed downscaled
+constexpr int kImageQuality = 90;
+
+// The modification time of thumbnails that are used is only updated
+// after this interval to avoid writing on every access. This is good
+// enough for finding the least recently used thumbnails.
+constexpr qint64 kTouchIntervalSecs = 24 * 60 * 60;
+
+// Prune more than necessary to avoid pruning again in every session
+constexpr qint64 kPruneTargetPercent = 75;
+
+} // anonymous namespace
+
+CoverThumbnailCache::CoverThumbnailCache(const QString& dirPath)
+        : m_dirPath(dirPath) {
+}
+
+QString CoverThumbnailCache::filePath(
+        const QByteArray& imageDigest,
+        int width) const {
+    const QString digest = QString::fromLatin1(imageDigest.toHex());
+    // Spread the files over subdirectories to keep directories small
+    return QStringLiteral("%1/%2/%3_%4.jpg")
+            .arg(m_dirPath,
+                    digest.left(2),
+                    digest,
+                    QString::number(width));
+}
+
+QImage CoverThumbnailCache::load(
+        const QByteArray& imageDigest,
+        int width,
+        const QDateTime& sourceLastModified) const {
+    VERIFY_OR_DEBUG_ASSERT(isCacheable(imageDigest, width)) {
+        return QImage();
+    }
+    const QString path = filePath(imageDigest, width);
+    const QDateTime lastModified = QFileInfo(path).lastModified();
+    if (!lastModified.isValid()) {
+        // Not cached
+        return QImage();
+    }
+    if (!sourceLastModified.isValid() || sourceLastModified > lastModified) {
+        // The cover might have been modified without updating the
+        // digest in the library. The caller needs to load the cover
+        // from the source and verify the digest.
+        return QImage();
+    }
+    QImageReader reader(path, kImageFormat);
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return QImage();
+    }
+    if (image.width() != width) {
+        // Should never happen unless the file has been modified
+        kLogger.warning()
+                << "Discarding thumbnail with unexpected width"
+                << image.width()
+                << "instead of"
+                << width;
+        return QImage();
+    }
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (lastModified.secsTo(now) > kTouchIntervalSecs) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadWrite) ||
+                !file.setFileTime(now, QFileDevice::FileModificationTime)) {
+            kLogger.debug()
+                    << "Failed to update modification time of thumbnail"
+                    << path
+                    << file.errorString();
+        }
+    }
+    return image;
+}
+
+bool CoverThumbnailCache::save(
+        const QByteArray& imageDigest,
+        int width,
+        const QImage& image) const {
+    VERIFY_OR_DEBUG_ASSERT(isCacheable(imageDigest, width)) {
+        return false;
+    }
+    VERIFY_OR_DEBUG_ASSERT(image.width() == width) {
+        return false;
+    }
+    if (image.hasAlphaChannel()) {
+        // JPEG doesn't support transparency
+        return false;
+    }
+    const QString path = filePath(imageDigest, width);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        kLogger.warning()
+                << "Failed to create directory for"
+                << path;
+        return false;
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) ||
+            !image.save(&file, kImageFormat, kImageQuality) ||
+            !file.commit()) {
+        kLogger.warning()
+                << "Failed to save thumbnail"
+                << path
+                << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+int CoverThumbnailCache::prune(qint64 maxTotalSize) const {
+    struct Thumbnail {
+        QString path;
+        QDateTime lastModified;
+        qint64 size;
+    };
+    std::vector<Thumbnail> thumbnails;
+    qint64 totalSize = 0;
+    QDirIterator it(m_dirPath,
+            QStringList{QStringLiteral("*.jpg")},
+            QDir::Files,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fileInfo = it.fileInfo();
+        thumbnails.push_back({fileInfo.filePath(), fileInfo.lastModified(), fileInfo.size()});
+        totalSize += fileInfo.size();
+    }
+    if (totalSize <= maxTotalSize) {
+        return 0;
+    }
+
+    const qint64 targetSize = maxTotalSize * kPruneTargetPercent / 100;
+    std::sort(thumbnails.begin(),
+            thumbnails.end(),
+            [](const Thumbnail& lhs, const Thumbnail& rhs) {
+                return lhs.lastModified < rhs.lastModified;
+            });
+    int removed = 0;
+    for (const auto& thumbnail : thumbnails) {
+        if (totalSize <= targetSize) {
+            break;
+        }
+        if (!QFile::remove(thumbnail.path)) {
+            kLogger.warning()
+                    << "Failed to remove thumbnail"
+                    << thumbnail.path;
+            continue;
+        }
+        totalSize -= thumbnail.size;
+        ++removed;
+        // Only succeeds if the subdirectory is empty
+        QDir().rmdir(QFileInfo(thumbnail.path).absolutePath());
+    }
+    kLogger.info()
+            << "Removed"
+            << removed
+            << "least recently used thumbnails";
+    return removed;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QImage>
+#include <QString>
+
+/// A persistent cache of decoded and resized cover images on disk.
+///
+/// Thumbnails are keyed by the digest of the original image and the
+/// width they have been resized to. The digest is calculated from the
+/// image contents, i.e. a thumbnail can be shared by all tracks with the
+/// same cover. Reading a small JPEG file is much cheaper than extracting
+/// the embedded image from an audio file and scaling it down again in
+/// every session.
+///
+/// The digest stored in the library might be outdated if the cover has
+/// been modified by another application. Thumbnails are therefore only
+/// used if they are newer than the file that contains the cover.
+///
+/// The modification time of a thumbnail is updated when it is used,
+/// and the least recently used thumbnails are removed when the total
+/// size exceeds a limit, e.g. after the displayed width has changed.
+///
+/// All functions are thread-safe and may be invoked from worker
+/// threads. Concurrent writes of the same thumbnail are harmless,
+/// because files are replaced atomically.
+class CoverThumbnailCache {
+  public:
+    /// Thumbnails are only cached up to this width. Larger images are
+    /// usually displayed rarely and would waste disk space.
+    static constexpr int kMaxWidth = 512;
+
+    static constexpr qint64 kDefaultMaxTotalSize = 128 * 1024 * 1024;
+
+    explicit CoverThumbnailCache(const QString& dirPath);
+
+    static bool isCacheable(
+            const QByteArray& imageDigest,
+            int width) {
+        return !imageDigest.isEmpty() && width > 0 && width <= kMaxWidth;
+    }
+
+    /// Returns a null image if the thumbnail is not cached or if it is
+    /// older than the file that contains the cover, i.e. if the digest
+    /// might be outdated.
+    QImage load(
+            const QByteArray& imageDigest,
+            int width,
+            const QDateTime& sourceLastModified) const;
+
+    bool save(
+            const QByteArray& imageDigest,
+            int width,
+            const QImage& image) const;
+
+    QString filePath(
+            const QByteArray& imageDigest,
+            int width) const;
+
+    /// Removes the least recently used thumbnails until their total size
+    /// doesn't exceed maxTotalSize anymore. Returns the number of removed
+    /// thumbnails.
+    int prune(qint64 maxTotalSize = kDefaultMaxTotalSize) const;
+
+  private:
+    const QString m_dirPath;
+};
@@ -4,6 +4,7 @@
 #include <QSqlRecord>
 #include <QtDebug>
 
+#include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "preferences/waveformsettings.h"
 #include "util/performancetimer.h"
@@ -17,6 +18,17 @@ const QString AnalysisDao::s_analysisTableName = "track_analysis";
 // CPU time so I think we should stick with the default. rryan 4/3/2012
 constexpr int kCompressionLevel = -1;
 
+namespace {
+
+// Store digests as a signed 64-bit integer. Otherwise values greater
+// than 2^63-1 would be converted into a floating point numbers while
+// losing precision!!
+inline constexpr mixxx::cache_key_signed_t dbAudioDigest(mixxx::cache_key_t audioDigest) {
+    return mixxx::signedCacheKey(audioDigest);
+}
+
+} // anonymous namespace
+
 AnalysisDao::AnalysisDao(UserSettingsPointer pConfig)
         : m_pConfig(pConfig) {
     QDir storagePath = getAnalysisStoragePath();
@@ -366,6 +378,165 @@ void AnalysisDao::saveTrackAnalyses(
              << "analysisId" << analysis.analysisId;
 }
 
+mixxx::cache_key_t AnalysisDao::getAudioDigest(TrackId trackId) const {
+    if (!m_database.isOpen() || !trackId.isValid()) {
+        return mixxx::invalidCacheKey();
+    }
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE %3=:trackId")
+                          .arg(LIBRARYTABLE_AUDIO_DIGEST,
+                                  LIBRARY_TABLE,
+                                  LIBRARYTABLE_ID));
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't get audio digest for track" << trackId;
+        return mixxx::invalidCacheKey();
+    }
+    if (!query.next()) {
+        return mixxx::invalidCacheKey();
+    }
+    // NULL is converted into 0 = invalidCacheKey()
+    return query.value(0).toULongLong();
+}
+
+bool AnalysisDao::saveAudioDigest(TrackId trackId, mixxx::cache_key_t audioDigest) {
+    if (!m_database.isOpen() || !trackId.isValid()) {
+        return false;
+    }
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral("UPDATE %1 SET %2=:audioDigest WHERE %3=:trackId")
+                          .arg(LIBRARY_TABLE,
+                                  LIBRARYTABLE_AUDIO_DIGEST,
+                                  LIBRARYTABLE_ID));
+    if (mixxx::isValidCacheKey(audioDigest)) {
+        query.bindValue(":audioDigest", dbAudioDigest(audioDigest));
+    } else {
+        query.bindValue(":audioDigest", QVariant());
+    }
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't save audio digest for track" << trackId;
+        return false;
+    }
+    return true;
+}
+
+std::optional<AnalysisDao::TrackAnalysisResults>
+AnalysisDao::findTrackAnalysisResultsByAudioDigest(
+        mixxx::cache_key_t audioDigest,
+        TrackId excludeTrackId) const {
+    if (!m_database.isOpen() || !mixxx::isValidCacheKey(audioDigest)) {
+        return std::nullopt;
+    }
+    // Tracks that have been removed from the library (mixxx_deleted=1)
+    // are included intentionally, because this is where the results of
+    // moved or purged files are kept. Duplicates that have not been
+    // analyzed yet are skipped.
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT id,"
+            "beats_version,beats_sub_version,beats,bpm_lock,"
+            "key,keys_version,keys_sub_version,keys,"
+            "replaygain,replaygain_peak "
+            "FROM %1 WHERE %2=:audioDigest AND %3!=:excludeTrackId "
+            "AND (beats IS NOT NULL OR keys IS NOT NULL OR replaygain!=0 "
+            "OR %3 IN (SELECT track_id FROM %4)) "
+            "ORDER BY %3 DESC LIMIT 1")
+                          .arg(LIBRARY_TABLE,
+                                  LIBRARYTABLE_AUDIO_DIGEST,
+                                  LIBRARYTABLE_ID,
+                                  s_analysisTableName));
+    query.bindValue(":audioDigest", dbAudioDigest(audioDigest));
+    query.bindValue(":excludeTrackId", excludeTrackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't find tracks by audio digest" << audioDigest;
+        return std::nullopt;
+    }
+    if (!query.next()) {
+        return std::nullopt;
+    }
+    TrackAnalysisResults results;
+    results.trackId = TrackId(query.value(0));
+    results.beatsVersion = query.value(1).toString();
+    results.beatsSubVersion = query.value(2).toString();
+    results.beatsBlob = query.value(3).toByteArray();
+    results.bpmLocked = query.value(4).toBool();
+    results.keyText = query.value(5).toString();
+    results.keysVersion = query.value(6).toString();
+    results.keysSubVersion = query.value(7).toString();
+    results.keysBlob = query.value(8).toByteArray();
+    results.replayGainRatio = query.value(9).toDouble();
+    results.replayGainPeak = query.value(10).toDouble();
+    return results;
+}
+
+int AnalysisDao::copyAnalyses(TrackId sourceTrackId, TrackId targetTrackId) {
+    if (!m_database.isOpen() || !sourceTrackId.isValid() || !targetTrackId.isValid()) {
+        return 0;
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+        "SELECT COUNT(*) FROM %1 WHERE track_id=:trackId").arg(s_analysisTableName));
+    query.bindValue(":trackId", targetTrackId.toVariant());
+    if (!query.exec() || !query.next()) {
+        LOG_FAILED_QUERY(query) << "couldn't count analyses for track" << targetTrackId;
+        return 0;
+    }
+    if (query.value(0).toInt() > 0) {
+        // Never overwrite existing analyses
+        return 0;
+    }
+
+    query.prepare(QString(
+        "SELECT id, type, description, version, data_checksum FROM %1 "
+        "WHERE track_id=:trackId").arg(s_analysisTableName));
+    query.bindValue(":trackId", sourceTrackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't get analyses for track" << sourceTrackId;
+        return 0;
+    }
+
+    // The compressed data files are copied as is without
+    // decompressing and recompressing their contents.
+    QDir analysisPath(getAnalysisStoragePath());
+    QSqlQuery insertQuery(m_database);
+    insertQuery.prepare(QString(
+        "INSERT INTO %1 (track_id, type, description, version, data_checksum) "
+        "VALUES (:trackId,:type,:description,:version,:data_checksum)")
+                      .arg(s_analysisTableName));
+    int copied = 0;
+    while (query.next()) {
+        const QString sourcePath = analysisPath.absoluteFilePath(
+                query.value(0).toString());
+        if (!QFile::exists(sourcePath)) {
+            continue;
+        }
+        insertQuery.bindValue(":trackId", targetTrackId.toVariant());
+        insertQuery.bindValue(":type", query.value(1));
+        insertQuery.bindValue(":description", query.value(2));
+        insertQuery.bindValue(":version", query.value(3));
+        insertQuery.bindValue(":data_checksum", query.value(4));
+        if (!insertQuery.exec()) {
+            LOG_FAILED_QUERY(insertQuery) << "couldn't copy analysis";
+            continue;
+        }
+        const int analysisId = insertQuery.lastInsertId().toInt();
+        const QString targetPath = analysisPath.absoluteFilePath(
+                QString::number(analysisId));
+        if (!QFile::copy(sourcePath, targetPath)) {
+            qDebug() << "WARNING: Couldn't copy analysis data file" << sourcePath
+                     << "to" << targetPath;
+            deleteAnalysis(analysisId);
+            continue;
+        }
+        ++copied;
+    }
+    qDebug() << "AnalysisDAO copied" << copied << "analyses from track"
+             << sourceTrackId << "to track" << targetTrackId;
+    return copied;
+}
+
 size_t AnalysisDao::getDiskUsageInBytes(
         const QSqlDatabase& database,
         AnalysisType type) const {
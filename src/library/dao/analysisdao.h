@@ -1,10 +1,12 @@
 #pragma once
 
 #include <QDir>
+#include <optional>
 
 #include "preferences/usersettings.h"
 #include "library/dao/dao.h"
 #include "track/trackid.h"
+#include "util/cache.h"
 #include "waveform/waveform.h"
 
 class QSqlDatabase;
@@ -32,6 +34,23 @@ class AnalysisDao : public DAO {
         QByteArray data;
     };
 
+    /// Analysis results of a track in the library, stored as
+    /// serialized in the library table. Used for restoring the
+    /// results of tracks with the same audio digest.
+    struct TrackAnalysisResults {
+        TrackId trackId;
+        QString beatsVersion;
+        QString beatsSubVersion;
+        QByteArray beatsBlob;
+        bool bpmLocked = false;
+        QString keyText;
+        QString keysVersion;
+        QString keysSubVersion;
+        QByteArray keysBlob;
+        double replayGainRatio = 0.0;
+        double replayGainPeak = 0.0;
+    };
+
     explicit AnalysisDao(UserSettingsPointer pConfig);
     ~AnalysisDao() override = default;
 
@@ -57,6 +76,24 @@ class AnalysisDao : public DAO {
             ConstWaveformPointer pWaveform,
             ConstWaveformPointer pWaveSummary);
 
+    /// The audio digest identifies the decoded audio signal of a track
+    /// independent of its location and metadata, see calculateAudioDigest().
+    /// Returns an invalid cache key if no digest has been stored yet.
+    mixxx::cache_key_t getAudioDigest(TrackId trackId) const;
+    bool saveAudioDigest(TrackId trackId, mixxx::cache_key_t audioDigest);
+
+    /// Looks up the most recently added track other than excludeTrackId
+    /// with the same audio digest and any analysis results and returns
+    /// those results.
+    std::optional<TrackAnalysisResults> findTrackAnalysisResultsByAudioDigest(
+            mixxx::cache_key_t audioDigest,
+            TrackId excludeTrackId) const;
+
+    /// Copies all stored analyses (waveforms) from one track to another.
+    /// Nothing is copied if the target track already has stored analyses.
+    /// Returns the number of copied analyses.
+    int copyAnalyses(TrackId sourceTrackId, TrackId targetTrackId);
+
   private:
     QDir getAnalysisStoragePath() const;
     QByteArray loadDataFromFile(const QString& fileName) const;
@@ -17,6 +17,7 @@
 #include "library/dao/libraryhashdao.h"
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackschema.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "moc_trackdao.cpp"
@@ -92,11 +93,13 @@ TrackDAO::TrackDAO(CueDAO& cueDao,
                    PlaylistDAO& playlistDao,
                    AnalysisDao& analysisDao,
                    LibraryHashDAO& libraryHashDao,
+                   TrackSearchIndex& searchIndex,
                    UserSettingsPointer pConfig)
         : m_cueDao(cueDao),
           m_playlistDao(playlistDao),
           m_analysisDao(analysisDao),
           m_libraryHashDao(libraryHashDao),
+          m_searchIndex(searchIndex),
           m_pConfig(pConfig),
           m_trackLocationIdColumn(UndefinedRecordIndex),
           m_queryLibraryIdColumn(UndefinedRecordIndex),
@@ -380,6 +383,7 @@ bool TrackDAO::saveTrack(Track* pTrack) const {
 
 void TrackDAO::slotDatabaseTracksChanged(const QSet<TrackId>& changedTrackIds) {
     if (!changedTrackIds.isEmpty()) {
+        m_searchIndex.updateTracks(changedTrackIds.values());
         emit tracksChanged(changedTrackIds);
     }
 }
@@ -400,6 +404,8 @@ void TrackDAO::slotDatabaseTracksRelocated(const QList<RelocatedTrack>& relocate
     }
     DEBUG_ASSERT(removedTrackIds.size() <= changedTrackIds.size());
     DEBUG_ASSERT(!removedTrackIds.intersects(changedTrackIds));
+    m_searchIndex.removeTracks(removedTrackIds.values());
+    m_searchIndex.updateTracks(changedTrackIds.values());
     if (!removedTrackIds.isEmpty()) {
         emit tracksRemoved(removedTrackIds);
     }
@@ -548,6 +554,10 @@ void TrackDAO::addTracksFinish(bool rollback) {
             m_pTransaction->rollback();
             m_tracksAddedSet.clear();
         } else {
+            // Deferred until all tracks have been inserted, which
+            // is much faster than updating the index per track
+            // during a library scan.
+            m_searchIndex.updateTracks(m_tracksAddedSet.values());
             m_pTransaction->commit();
         }
     }
@@ -858,6 +868,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
         m_cueDao.saveTrackCues(
                 trackId,
                 pTrack->getCuePoints());
+        // The search index is updated for all added tracks at once
+        // in addTracksFinish().
 
         DEBUG_ASSERT(!m_tracksAddedSet.contains(trackId));
         m_tracksAddedSet.insert(trackId);
@@ -868,7 +880,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const QString& filePath,
-        bool unremove) {
+        bool unremove,
+        const SoundSourceProxy::PreparedTrackImport* pPreparedImport) {
     const auto fileAccess = mixxx::FileAccess(mixxx::FileInfo(filePath));
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
@@ -936,7 +949,8 @@ TrackPointer TrackDAO::addTracksAddFile(
     // from the file.
     SoundSourceProxy(pTrack).updateTrackFromSource(
             SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig),
+            pPreparedImport);
     if (!pTrack->checkSourceSynchronized()) {
         kLogger.warning() << "addTracksAddFile:"
                           << "Failed to parse track metadata from file"
@@ -1112,6 +1126,9 @@ bool TrackDAO::onPurgingTracks(
             return false;
         }
     }
+    if (!m_searchIndex.removeTracks(trackIds)) {
+        return false;
+    }
     {
         // invalidate the hash in LibraryHash,
         // in case the file was not deleted to detect it on a rescan
@@ -1375,8 +1392,9 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return nullptr;
     }
 
-    // The GlobalTrackCache is only locked while executing the following line.
-    TrackPointer pTrack = GlobalTrackCacheLocker().lookupTrackById(trackId);
+    // Only a single shard of the GlobalTrackCache is locked while executing
+    // the following line.
+    TrackPointer pTrack = GlobalTrackCache::lookupTrackById(trackId);
     if (pTrack) {
         return pTrack;
     }
@@ -1659,7 +1677,7 @@ TrackPointer TrackDAO::getTrackByRef(
     if (!trackRef.isValid()) {
         return nullptr;
     }
-    const auto pTrack = GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    const auto pTrack = GlobalTrackCache::lookupTrackByRef(trackRef);
     if (pTrack) {
         return pTrack;
     }
@@ -1767,6 +1785,7 @@ bool TrackDAO::updateTrack(const Track& track) const {
             track.getWaveformSummary());
     m_cueDao.saveTrackCues(
             trackId, track.getCuePoints());
+    m_searchIndex.updateTracks({trackId});
     transaction.commit();
 
     // kLogger.debug() << "Update track in database took: " <<
@@ -1845,6 +1864,60 @@ void TrackDAO::markTracksInDirectoriesAsVerified(const QStringList& directories)
     }
 }
 
+QSet<TrackId> TrackDAO::updateTrackLocationsInDirectory(
+        const QString& directory,
+        const QSet<QString>& fileLocations,
+        QSet<QString>* pTrackLocations) const {
+    DEBUG_ASSERT(pTrackLocations);
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare(QStringLiteral(
+            "SELECT library.id,track_locations.location,track_locations.fs_deleted "
+            "FROM library INNER JOIN track_locations "
+            "ON library.location=track_locations.id "
+            "WHERE track_locations.directory=:directory"));
+    query.bindValue(":directory", directory);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query)
+                << "Couldn't select tracks in" << directory;
+        return {};
+    }
+    QSet<TrackId> changedTrackIds;
+    QStringList missingLocations;
+    QStringList rediscoveredLocations;
+    while (query.next()) {
+        const QString location = query.value(1).toString();
+        pTrackLocations->insert(location);
+        const bool missing = query.value(2).toBool();
+        const bool exists = fileLocations.contains(location);
+        if (missing != exists) {
+            continue;
+        }
+        changedTrackIds.insert(TrackId(query.value(0)));
+        if (exists) {
+            rediscoveredLocations.append(location);
+        } else {
+            missingLocations.append(location);
+        }
+    }
+    if (!missingLocations.isEmpty()) {
+        query.prepare(QStringLiteral(
+                "UPDATE track_locations "
+                "SET fs_deleted=1, needs_verification=0 "
+                "WHERE location IN (%1)")
+                        .arg(SqlStringFormatter::formatList(
+                                m_database, missingLocations)));
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query)
+                    << "Couldn't mark tracks in" << directory << "as deleted.";
+        }
+    }
+    if (!rediscoveredLocations.isEmpty()) {
+        markTrackLocationsAsVerified(rediscoveredLocations);
+    }
+    return changedTrackIds;
+}
+
 void TrackDAO::markUnverifiedTracksAsDeleted() {
     // kLogger.debug()<< "markUnverifiedTracksAsDeleted" <<
     // QThread::currentThread() << m_database.connectionName();
@@ -2311,7 +2384,7 @@ TrackPointer TrackDAO::getOrAddTrack(
     VERIFY_OR_DEBUG_ASSERT(trackRef.hasLocation()) {
         return {};
     }
-    TrackPointer pTrack = GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    TrackPointer pTrack = GlobalTrackCache::lookupTrackByRef(trackRef);
     if (!pTrack) {
         // track not cached
         const TrackId trackId = getTrackIdByLocation(trackRef.getLocation());
@@ -9,6 +9,7 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "sources/soundsourceproxy.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 
@@ -17,6 +18,7 @@ class PlaylistDAO;
 class AnalysisDao;
 class CueDAO;
 class LibraryHashDAO;
+class TrackSearchIndex;
 
 namespace mixxx {
 class FileInfo;
@@ -42,6 +44,7 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             PlaylistDAO& playlistDao,
             AnalysisDao& analysisDao,
             LibraryHashDAO& libraryHashDao,
+            TrackSearchIndex& searchIndex,
             UserSettingsPointer pConfig);
     ~TrackDAO() override;
 
@@ -74,6 +77,19 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             QList<RelocatedTrack>* pRelocatedTracks,
             const QStringList& addedTracks,
             volatile const bool* pCancel) const;
+    /// Updates the missing flags of all tracks in a single directory
+    /// according to the files that currently exist in this directory.
+    /// The locations of all tracks in the directory are stored in
+    /// pTrackLocations.
+    ///
+    /// Returns the ids of the tracks that have been marked as missing
+    /// or that have been rediscovered.
+    ///
+    /// Only used by friend class LibraryScanner, but public for testing!
+    QSet<TrackId> updateTrackLocationsInDirectory(
+            const QString& directory,
+            const QSet<QString>& fileLocations,
+            QSet<QString>* pTrackLocations) const;
 
     // Only used by friend class TrackCollection, but public for testing!
     bool saveTrack(Track* pTrack) const;
@@ -158,9 +174,13 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// Metadata of the file that has already been imported, e.g. by
+    /// a concurrent worker thread, is used instead of parsing the file
+    /// again.
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove);
+            bool unremove,
+            const SoundSourceProxy::PreparedTrackImport* pPreparedImport = nullptr);
     void addTracksFinish(bool rollback = false);
 
     bool updateTrack(const Track& track) const;
@@ -203,6 +223,7 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     PlaylistDAO& m_playlistDao;
     AnalysisDao& m_analysisDao;
     LibraryHashDAO& m_libraryHashDao;
+    TrackSearchIndex& m_searchIndex;
 
     const UserSettingsPointer m_pConfig;
 
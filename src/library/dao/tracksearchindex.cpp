@@ -0,0 +1,362 @@
+#include "library/dao/tracksearchindex.h"
+
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTimer>
+
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "moc_tracksearchindex.cpp"
+#include "util/db/dbconnection.h"
+#include "util/db/sqltransaction.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TrackSearchIndex");
+
+// The columns of the library_cache_view that are usually searched with
+// LIKE. The virtual table uses the same column names.
+const QStringList kIndexedColumns = {
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_ALBUM,
+        LIBRARYTABLE_ALBUMARTIST,
+        LIBRARYTABLE_GENRE,
+        LIBRARYTABLE_COMPOSER,
+        LIBRARYTABLE_GROUPING,
+        LIBRARYTABLE_COMMENT,
+        TRACKLOCATIONSTABLE_LOCATION,
+};
+
+// The ids of tracks that have been modified without updating the index
+const QString kPendingTableName = QStringLiteral("track_search_index_pending");
+
+// The trigram tokenizer is not able to find shorter substrings
+constexpr int kMinSubstringLength = 3;
+
+// Keeps the length of statements with an IN list well below
+// the limits of SQLite, e.g. after importing a whole library
+constexpr int kMaxTrackIdsPerStatement = 1000;
+
+const QRegularExpression kLikeWildcardsRegex(QStringLiteral("[%_]"));
+
+QString joinTrackIds(const QList<TrackId>& trackIds) {
+    QStringList idStrings;
+    idStrings.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        idStrings.append(trackId.toString());
+    }
+    return idStrings.join(QChar(','));
+}
+
+bool probeTable(const QSqlDatabase& database) {
+    // Fails if the virtual table doesn't exist or if this SQLite
+    // library doesn't support it
+    QSqlQuery query(database);
+    return query.exec(
+            QStringLiteral("SELECT rowid FROM %1 LIMIT 0")
+                    .arg(TrackSearchIndex::kTableName));
+}
+
+bool execStatements(const QSqlDatabase& database, const QStringList& statements) {
+    for (const auto& statement : statements) {
+        QSqlQuery query(database);
+        if (!query.exec(statement)) {
+            LOG_FAILED_QUERY(query);
+            return false;
+        }
+    }
+    return true;
+}
+
+/// The triggers don't depend on any custom SQL functions and are
+/// also executed by previous versions of Mixxx.
+bool createPendingTracksTriggers(const QSqlDatabase& database) {
+    const QString insertPendingTrack =
+            QStringLiteral("INSERT OR IGNORE INTO %1 (id) VALUES (%2.id);")
+                    .arg(kPendingTableName);
+    return execStatements(database,
+            {
+                    QStringLiteral("CREATE TABLE IF NOT EXISTS %1 "
+                                   "(id INTEGER PRIMARY KEY)")
+                            .arg(kPendingTableName),
+                    QStringLiteral("CREATE TRIGGER IF NOT EXISTS %1_insert "
+                                   "AFTER INSERT ON library BEGIN %2 END")
+                            .arg(kPendingTableName, insertPendingTrack.arg("NEW")),
+                    QStringLiteral("CREATE TRIGGER IF NOT EXISTS %1_update "
+                                   "AFTER UPDATE OF %2 ON library BEGIN %3 END")
+                            .arg(kPendingTableName,
+                                    kIndexedColumns.join(QChar(',')),
+                                    insertPendingTrack.arg("NEW")),
+                    QStringLiteral("CREATE TRIGGER IF NOT EXISTS %1_delete "
+                                   "AFTER DELETE ON library BEGIN %2 END")
+                            .arg(kPendingTableName, insertPendingTrack.arg("OLD")),
+                    QStringLiteral("CREATE TRIGGER IF NOT EXISTS %1_relocate "
+                                   "AFTER UPDATE OF location ON track_locations BEGIN "
+                                   "INSERT OR IGNORE INTO %1 (id) "
+                                   "SELECT id FROM library WHERE location=NEW.id; END")
+                            .arg(kPendingTableName),
+            });
+}
+
+/// Copy the indexed columns of all library tracks that match the
+/// WHERE clause into the index.
+bool insertTracks(const QSqlDatabase& database, const QString& whereClause) {
+    QStringList selectColumns;
+    selectColumns.reserve(kIndexedColumns.size() + 1);
+    selectColumns.append(QStringLiteral("library.") + LIBRARYTABLE_ID);
+    QStringList placeholders;
+    placeholders.reserve(kIndexedColumns.size());
+    for (const auto& column : kIndexedColumns) {
+        selectColumns.append(mixxx::trackschema::tableForColumn(column) +
+                QChar('.') + column);
+        placeholders.append(QChar(':') + column);
+    }
+    QSqlQuery selectQuery(database);
+    selectQuery.setForwardOnly(true);
+    if (!selectQuery.exec(QStringLiteral(
+                "SELECT %1 FROM library "
+                "INNER JOIN track_locations ON library.location = track_locations.id %2")
+                        .arg(selectColumns.join(QChar(',')), whereClause))) {
+        LOG_FAILED_QUERY(selectQuery);
+        return false;
+    }
+
+    QSqlQuery insertQuery(database);
+    if (!insertQuery.prepare(QStringLiteral(
+                "INSERT INTO %1 (rowid,%2) VALUES (:rowid,%3)")
+                        .arg(TrackSearchIndex::kTableName,
+                                kIndexedColumns.join(QChar(',')),
+                                placeholders.join(QChar(','))))) {
+        LOG_FAILED_QUERY(insertQuery);
+        return false;
+    }
+    while (selectQuery.next()) {
+        insertQuery.bindValue(QStringLiteral(":rowid"), selectQuery.value(0));
+        for (int i = 0; i < kIndexedColumns.size(); ++i) {
+            const QVariant value = selectQuery.value(i + 1);
+            if (value.isNull()) {
+                insertQuery.bindValue(placeholders[i], QVariant());
+                continue;
+            }
+            QString string = value.toString();
+            mixxx::DbConnection::makeStringLatinLow(&string);
+            insertQuery.bindValue(placeholders[i], string);
+        }
+        if (!insertQuery.exec()) {
+            LOG_FAILED_QUERY(insertQuery);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool deleteTracks(const QSqlDatabase& database,
+        const QString& tableName,
+        const QString& whereClause) {
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("DELETE FROM %1 %2")
+                            .arg(tableName, whereClause))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+const QString TrackSearchIndex::kTableName = QStringLiteral("track_search_index");
+
+void TrackSearchIndex::initialize(const QSqlDatabase& database) {
+    DAO::initialize(database);
+    m_state = probeTable(m_database) ? State::Pending : State::Unsupported;
+}
+
+bool TrackSearchIndex::createIfMissing() {
+    const bool created = m_state == State::Unsupported;
+    if (created) {
+        QSqlQuery query(m_database);
+        if (!query.exec(QStringLiteral(
+                    "CREATE VIRTUAL TABLE IF NOT EXISTS %1 USING fts5(%2,"
+                    "tokenize='trigram case_sensitive 1')")
+                                .arg(kTableName, kIndexedColumns.join(QChar(','))))) {
+            kLogger.info()
+                    << "Full-text search index is not supported:"
+                    << query.lastError().text();
+            return false;
+        }
+        // The table might have existed already without being usable
+        if (!probeTable(m_database)) {
+            kLogger.warning() << "Full-text search index is not usable";
+            return false;
+        }
+    }
+    if (!createPendingTracksTriggers(m_database)) {
+        m_state = State::Unsupported;
+        return false;
+    }
+    m_state = State::Pending;
+    if (created) {
+        return rebuild();
+    }
+    // Tracks that have been added or removed while the triggers did
+    // not exist yet, e.g. after restoring a backup of the library
+    if (!execStatements(m_database,
+                {QStringLiteral("INSERT OR IGNORE INTO %1 (id) "
+                                "SELECT id FROM library "
+                                "WHERE id NOT IN (SELECT rowid FROM %2)")
+                                .arg(kPendingTableName, kTableName),
+                        QStringLiteral("INSERT OR IGNORE INTO %1 (id) "
+                                       "SELECT rowid FROM %2 "
+                                       "WHERE rowid NOT IN (SELECT id FROM library)")
+                                .arg(kPendingTableName, kTableName)})) {
+        m_state = State::Unsupported;
+        return false;
+    }
+    schedulePendingTracks();
+    return true;
+}
+
+bool TrackSearchIndex::updateTracks(const QList<TrackId>& trackIds) {
+    if (m_state == State::Unsupported || trackIds.isEmpty()) {
+        return true;
+    }
+    for (int i = 0; i < trackIds.size(); i += kMaxTrackIdsPerStatement) {
+        const QString whereRowIds = QStringLiteral("WHERE rowid IN (%1)")
+                                            .arg(joinTrackIds(trackIds.mid(
+                                                    i, kMaxTrackIdsPerStatement)));
+        if (!deleteTracks(m_database, kTableName, whereRowIds) ||
+                !insertTracks(m_database,
+                        QStringLiteral("WHERE library.rowid IN (%1)")
+                                .arg(joinTrackIds(trackIds.mid(
+                                        i, kMaxTrackIdsPerStatement)))) ||
+                !deleteTracks(m_database, kPendingTableName, whereRowIds)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TrackSearchIndex::removeTracks(const QList<TrackId>& trackIds) {
+    if (m_state == State::Unsupported || trackIds.isEmpty()) {
+        return true;
+    }
+    for (int i = 0; i < trackIds.size(); i += kMaxTrackIdsPerStatement) {
+        const QString whereRowIds = QStringLiteral("WHERE rowid IN (%1)")
+                                            .arg(joinTrackIds(trackIds.mid(
+                                                    i, kMaxTrackIdsPerStatement)));
+        if (!deleteTracks(m_database, kTableName, whereRowIds) ||
+                !deleteTracks(m_database, kPendingTableName, whereRowIds)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TrackSearchIndex::rebuild() {
+    VERIFY_OR_DEBUG_ASSERT(m_state != State::Unsupported) {
+        return false;
+    }
+    kLogger.info() << "Rebuilding the full-text search index";
+    m_state = State::Pending;
+    SqlTransaction transaction(m_database);
+    if (!deleteTracks(m_database, kTableName, QString()) ||
+            !execStatements(m_database,
+                    {QStringLiteral("INSERT OR IGNORE INTO %1 (id) SELECT id FROM library")
+                                    .arg(kPendingTableName)}) ||
+            !transaction.commit()) {
+        return false;
+    }
+    schedulePendingTracks();
+    return true;
+}
+
+bool TrackSearchIndex::updatePendingTracks(int maxCount) {
+    if (m_state == State::Unsupported) {
+        return false;
+    }
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare(QStringLiteral("SELECT id FROM %1 ORDER BY id LIMIT :limit")
+                          .arg(kPendingTableName));
+    query.bindValue(":limit", maxCount);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    QList<TrackId> trackIds;
+    while (query.next()) {
+        trackIds.append(TrackId(query.value(0)));
+    }
+    if (!trackIds.isEmpty()) {
+        SqlTransaction transaction(m_database);
+        if (!updateTracks(trackIds) || !transaction.commit()) {
+            return false;
+        }
+    }
+    if (trackIds.size() < maxCount && m_state == State::Pending) {
+        kLogger.info() << "Full-text search index is available";
+        m_state = State::Available;
+        emit available();
+    }
+    return true;
+}
+
+void TrackSearchIndex::schedulePendingTracks() {
+    DEBUG_ASSERT(m_state == State::Pending);
+    // Don't block the event loop while updating many tracks, e.g.
+    // after rebuilding the whole index
+    QTimer::singleShot(0, this, [this] {
+        if (m_state != State::Pending) {
+            return;
+        }
+        if (!updatePendingTracks()) {
+            // The triggers keep recording all modifications and
+            // the update is retried on the next start
+            kLogger.warning() << "Failed to update the full-text search index";
+            m_state = State::Unsupported;
+            return;
+        }
+        if (m_state == State::Pending) {
+            schedulePendingTracks();
+        }
+    });
+}
+
+//static
+QString TrackSearchIndex::matchQuery(
+        const QStringList& columns,
+        const QString& likePattern) {
+    if (columns.isEmpty()) {
+        return QString();
+    }
+    for (const auto& column : columns) {
+        if (!kIndexedColumns.contains(column)) {
+            return QString();
+        }
+    }
+    QString pattern = likePattern;
+    mixxx::DbConnection::makeStringLatinLow(&pattern);
+    QStringList phrases;
+    const QStringList substrings = pattern.split(kLikeWildcardsRegex,
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            Qt::SkipEmptyParts);
+#else
+            QString::SkipEmptyParts);
+#endif
+    for (QString substring : substrings) {
+        // Shorter substrings would never match
+        if (substring.toUcs4().size() < kMinSubstringLength) {
+            continue;
+        }
+        substring.replace(QChar('"'), QStringLiteral("\"\""));
+        phrases.append(QChar('"') + substring + QChar('"'));
+    }
+    if (phrases.isEmpty()) {
+        return QString();
+    }
+    return QStringLiteral("{%1} : (%2)")
+            .arg(columns.join(QChar(' ')), phrases.join(QStringLiteral(" AND ")));
+}
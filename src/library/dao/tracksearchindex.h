@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "library/dao/dao.h"
+#include "track/trackid.h"
+
+/// A trigram index of the library columns that are searched for
+/// substrings with LIKE, stored in an SQLite FTS5 virtual table.
+///
+/// The values are stored after converting them with
+/// DbConnection::makeStringLatinLow() like the custom LIKE operator
+/// does. All literal substrings of a LIKE pattern are thus contained
+/// in the indexed values of a matching track, and the index can be
+/// used to narrow down the tracks before evaluating the exact LIKE
+/// expression.
+///
+/// TrackDAO updates the index whenever it modifies the library. Triggers
+/// record all other modifications of the indexed columns as pending,
+/// including those by previous versions of Mixxx that are not aware of
+/// the index. Pending tracks are updated in small batches from the event
+/// loop and the index is only available for searching afterwards.
+///
+/// The index is optional and only supported if SQLite has been built
+/// with FTS5 and supports the trigram tokenizer (3.34.0 or newer).
+class TrackSearchIndex : public QObject, public virtual DAO {
+    Q_OBJECT
+  public:
+    static const QString kTableName;
+
+    static constexpr int kMaxPendingTracksPerBatch = 500;
+
+    ~TrackSearchIndex() override = default;
+
+    /// Checks if the index exists and is usable with this connection.
+    void initialize(const QSqlDatabase& database) override;
+
+    /// Creates the index and the triggers if they do not exist yet and
+    /// schedules the update of all pending tracks. Tracks that are
+    /// missing in either the index or the library become pending, too.
+    /// The whole index is rebuilt if it has just been created.
+    ///
+    /// Returns false if the index is not supported.
+    bool createIfMissing();
+
+    bool isAvailable() const {
+        return m_state == State::Available;
+    }
+
+    /// Re-reads the indexed columns of the tracks from the library. Tracks
+    /// that are no longer in the library are removed from the index.
+    bool updateTracks(const QList<TrackId>& trackIds);
+    bool removeTracks(const QList<TrackId>& trackIds);
+
+    /// Marks all tracks as pending and schedules their update.
+    bool rebuild();
+
+    /// Updates up to maxCount pending tracks. The index becomes available
+    /// when no tracks are pending anymore. Returns false on failure.
+    bool updatePendingTracks(int maxCount = kMaxPendingTracksPerBatch);
+
+    /// Returns an FTS5 query that matches a superset of the tracks that
+    /// match the LIKE pattern in any of the given columns, or a null string
+    /// if the index can't be used, e.g. if a column is not indexed or if the
+    /// pattern doesn't contain a literal substring of at least 3 characters.
+    static QString matchQuery(
+            const QStringList& columns,
+            const QString& likePattern);
+
+  signals:
+    /// Emitted when all pending tracks have been updated.
+    void available();
+
+  private:
+    enum class State {
+        Unsupported,
+        Pending,
+        Available,
+    };
+
+    void schedulePendingTracks();
+
+    State m_state = State::Unsupported;
+};
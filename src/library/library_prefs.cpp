@@ -18,6 +18,16 @@ const ConfigKey mixxx::library::prefs::kRescanOnStartupConfigKey =
                 mixxx::library::prefs::kConfigGroup,
                 QStringLiteral("RescanOnStartup")};
 
+const ConfigKey mixxx::library::prefs::kWatchDirectoriesConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("WatchDirectories")};
+
+const ConfigKey mixxx::library::prefs::kWatchReconcileIntervalMinutesConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("WatchReconcileIntervalMinutes")};
+
 const ConfigKey mixxx::library::prefs::kKeyNotationConfigKey =
         ConfigKey{
                 mixxx::library::prefs::kConfigGroup,
@@ -14,6 +14,12 @@ extern const QString kConfigGroup;
 
 extern const ConfigKey kRescanOnStartupConfigKey;
 
+extern const ConfigKey kWatchDirectoriesConfigKey;
+
+extern const ConfigKey kWatchReconcileIntervalMinutesConfigKey;
+
+const int kWatchReconcileIntervalMinutesDefault = 60;
+
 extern const ConfigKey kKeyNotationConfigKey;
 
 extern const ConfigKey kTrackDoubleClickActionConfigKey;
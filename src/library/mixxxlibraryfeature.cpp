@@ -106,6 +106,17 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
             std::move(columns),
             std::move(searchColumns),
             true);
+    const TrackSearchIndex& searchIndex = m_pTrackCollection->getSearchIndex();
+    if (searchIndex.isAvailable()) {
+        pBaseTrackCache->enableSearchIndex();
+    } else {
+        // The index becomes available after all pending tracks
+        // have been updated
+        connect(&searchIndex,
+                &TrackSearchIndex::available,
+                pBaseTrackCache,
+                &BaseTrackCache::enableSearchIndex);
+    }
     m_pBaseTrackCache = QSharedPointer<BaseTrackCache>(pBaseTrackCache);
     m_pTrackCollection->connectTrackSource(m_pBaseTrackCache);
 
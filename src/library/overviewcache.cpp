@@ -3,6 +3,7 @@
 #include <QFutureWatcher>
 #include <QPixmapCache>
 #include <QSqlDatabase>
+#include <QTimer>
 #include <QtConcurrentRun>
 
 #include "library/dao/analysisdao.h"
@@ -18,6 +19,11 @@ namespace {
 
 mixxx::Logger kLogger("OverviewCache");
 
+// Roughly the number of rows that are visible in a library table.
+// Bounds both the latency of the first results and the number of
+// rendered images that are kept until the batch is finished.
+constexpr int kMaxBatchSize = 32;
+
 QString pixmapCacheKey(TrackId trackId, QSize size, mixxx::OverviewType type) {
     return QString("Overview_%1_%2_%3_%4")
             .arg(QString::number(static_cast<int>(type)),
@@ -38,6 +44,8 @@ OverviewCache::OverviewCache(UserSettingsPointer pConfig,
         mixxx::DbConnectionPoolPtr pDbConnectionPool)
         : m_pConfig(pConfig),
           m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_batchScheduled(false),
+          m_batchInProgress(false),
           m_clearingCache(false),
           m_stopClearing(false) {
 }
@@ -153,84 +161,123 @@ QPixmap OverviewCache::requestUncachedOverview(
 
     // no cached overview, request preparation
     m_currentlyLoading.insert(trackId);
+    m_pendingRequests.append(Request{
+            trackId,
+            type,
+            signalColors,
+            desiredSize,
+            pRequester});
+    scheduleNextBatch();
+
+    return QPixmap();
+}
+
+void OverviewCache::scheduleNextBatch() {
+    if (m_batchScheduled || m_batchInProgress) {
+        return;
+    }
+    // Defer until all visible rows have been painted
+    m_batchScheduled = true;
+    QTimer::singleShot(0, this, &OverviewCache::startNextBatch);
+}
 
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            &OverviewCache::prepareOverview,
+void OverviewCache::startNextBatch() {
+    m_batchScheduled = false;
+    DEBUG_ASSERT(!m_batchInProgress);
+    if (m_pendingRequests.isEmpty()) {
+        return;
+    }
+    const QList<Request> requests = m_pendingRequests.mid(0, kMaxBatchSize);
+    m_pendingRequests.erase(m_pendingRequests.begin(),
+            m_pendingRequests.begin() + requests.size());
+    m_batchInProgress = true;
+
+    QFutureWatcher<QList<FutureResult>>* watcher =
+            new QFutureWatcher<QList<FutureResult>>(this);
+    QFuture<QList<FutureResult>> future = QtConcurrent::run(
+            &OverviewCache::prepareOverviews,
             m_pConfig,
             m_pDbConnectionPool,
-            type,
-            signalColors,
-            trackId,
-            pRequester,
-            desiredSize);
+            requests);
     connect(watcher,
-            &QFutureWatcher<FutureResult>::finished,
+            &QFutureWatcher<QList<FutureResult>>::finished,
             this,
-            &OverviewCache::overviewPrepared);
+            &OverviewCache::overviewsPrepared);
     watcher->setFuture(future);
-
-    return QPixmap();
 }
 
 // static
-OverviewCache::FutureResult OverviewCache::prepareOverview(
+QList<OverviewCache::FutureResult> OverviewCache::prepareOverviews(
         const UserSettingsPointer pConfig,
         const mixxx::DbConnectionPoolPtr pDbConnectionPool,
-        mixxx::OverviewType type,
-        const WaveformSignalColors& signalColors,
-        TrackId trackId,
-        const QObject* pRequester,
-        QSize desiredSize) {
-    // kLogger.warning() << "prepareOverview" << trackId;
-    FutureResult result;
-    result.trackId = trackId;
-    result.type = type;
-    result.requester = pRequester;
-    result.image = QImage();
-    result.resizedToSize = desiredSize;
-
-    if (!trackId.isValid() || desiredSize.isEmpty()) {
-        return result;
-    }
+        const QList<Request>& requests) {
+    // kLogger.warning() << "prepareOverviews" << requests.size();
+    QList<FutureResult> results;
+    results.reserve(requests.size());
 
-    mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    // Only reads the analyses and never blocks writers
+    mixxx::DbConnectionPooler dbConnectionPooler(
+            pDbConnectionPool, mixxx::DbConnection::AccessMode::ReadOnly);
 
     AnalysisDao analysisDao(pConfig);
     analysisDao.initialize(mixxx::DbConnectionPooled(pDbConnectionPool));
 
-    QList<AnalysisDao::AnalysisInfo> analyses =
-            analysisDao.getAnalysesForTrackByType(
-                    trackId, AnalysisDao::AnalysisType::TYPE_WAVESUMMARY);
-
-    if (!analyses.isEmpty()) {
-        ConstWaveformPointer pLoadedTrackWaveformSummary = ConstWaveformPointer(
-                WaveformFactory::loadWaveformFromAnalysis(analyses.first()));
-
-        if (!pLoadedTrackWaveformSummary.isNull()) {
-            QImage image = waveformOverviewRenderer::render(
-                    pLoadedTrackWaveformSummary,
-                    type,
-                    signalColors,
-                    true /* mono, bottom-aligned */);
-
-            if (!image.isNull()) {
-                image = resizeImageSize(image, desiredSize);
+    for (const auto& request : requests) {
+        FutureResult result;
+        result.trackId = request.trackId;
+        result.type = request.type;
+        result.requester = request.requester;
+        result.image = QImage();
+        result.resizedToSize = request.desiredSize;
+
+        if (request.trackId.isValid() && !request.desiredSize.isEmpty()) {
+            // The summary is released before the next one is loaded
+            const QList<AnalysisDao::AnalysisInfo> analyses =
+                    analysisDao.getAnalysesForTrackByType(request.trackId,
+                            AnalysisDao::AnalysisType::TYPE_WAVESUMMARY);
+            if (!analyses.isEmpty()) {
+                ConstWaveformPointer pLoadedTrackWaveformSummary = ConstWaveformPointer(
+                        WaveformFactory::loadWaveformFromAnalysis(analyses.first()));
+
+                if (!pLoadedTrackWaveformSummary.isNull()) {
+                    QImage image = waveformOverviewRenderer::render(
+                            pLoadedTrackWaveformSummary,
+                            request.type,
+                            request.signalColors,
+                            true /* mono, bottom-aligned */);
+
+                    if (!image.isNull()) {
+                        image = resizeImageSize(image, request.desiredSize);
+                    }
+                    result.image = image;
+                }
             }
-            result.image = image;
         }
+        results.append(result);
     }
 
-    return result;
+    return results;
 }
 
 // watcher
-void OverviewCache::overviewPrepared() {
-    QFutureWatcher<FutureResult>* watcher = static_cast<QFutureWatcher<FutureResult>*>(sender());
-    FutureResult res = watcher->result();
+void OverviewCache::overviewsPrepared() {
+    QFutureWatcher<QList<FutureResult>>* watcher =
+            static_cast<QFutureWatcher<QList<FutureResult>>*>(sender());
+    const QList<FutureResult> results = watcher->result();
     watcher->deleteLater();
-    // kLogger.warning() << "overviewPrepared" << res.trackId;
+    m_batchInProgress = false;
+    // kLogger.warning() << "overviewsPrepared" << results.size();
+
+    for (const auto& res : results) {
+        overviewPrepared(res);
+    }
+
+    if (!m_pendingRequests.isEmpty()) {
+        scheduleNextBatch();
+    }
+}
 
+void OverviewCache::overviewPrepared(const FutureResult& res) {
     // Create pixmap, GUI thread only
     QPixmap pixmap = QPixmap::fromImage(res.image);
     if (!pixmap.isNull() && !res.resizedToSize.isEmpty()) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QList>
 #include <QSqlDatabase>
 
 #include "analyzer/analyzerprogress.h"
@@ -8,8 +9,7 @@
 #include "util/db/dbconnectionpool.h"
 #include "util/singleton.h"
 #include "waveform/overviewtype.h"
-
-class WaveformSignalColors;
+#include "waveform/renderers/waveformsignalcolors.h"
 
 class OverviewCache : public QObject, public Singleton<OverviewCache> {
     Q_OBJECT
@@ -40,9 +40,17 @@ class OverviewCache : public QObject, public Singleton<OverviewCache> {
         const QObject* requester;
     };
 
+    struct Request {
+        TrackId trackId;
+        mixxx::OverviewType type;
+        WaveformSignalColors signalColors;
+        QSize desiredSize;
+        const QObject* requester;
+    };
+
   public slots:
     void onNormalizeOrVisualGainChanged();
-    void overviewPrepared();
+    void overviewsPrepared();
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
 
   signals:
@@ -59,19 +67,27 @@ class OverviewCache : public QObject, public Singleton<OverviewCache> {
     virtual ~OverviewCache() override = default;
     friend class Singleton<OverviewCache>;
 
-    static FutureResult prepareOverview(
+    /// Renders the overviews of a whole batch of tracks with a single
+    /// database connection. Only one waveform summary is held in memory
+    /// at a time.
+    static QList<FutureResult> prepareOverviews(
             UserSettingsPointer pConfig,
             mixxx::DbConnectionPoolPtr pDbConnectionPool,
-            mixxx::OverviewType type,
-            const WaveformSignalColors& signalColors,
-            TrackId trackId,
-            const QObject* pRequester,
-            QSize desiredSize);
+            const QList<Request>& requests);
 
   private:
+    void scheduleNextBatch();
+    void startNextBatch();
+    void overviewPrepared(const FutureResult& res);
+
     UserSettingsPointer m_pConfig;
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
+    // Requests of a paint pass are collected and prepared together
+    QList<Request> m_pendingRequests;
+    bool m_batchScheduled;
+    bool m_batchInProgress;
+
     QSet<TrackId> m_currentlyLoading;
     QSet<TrackId> m_tracksWithoutOverview;
     QMultiHash<TrackId, QString> m_cacheKeysByTrackId;
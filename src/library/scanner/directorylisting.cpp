@@ -0,0 +1,131 @@
+#include "library/scanner/directorylisting.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#ifdef __LINUX__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstddef>
+#endif
+
+#include "util/assert.h"
+
+namespace {
+
+#ifdef __LINUX__
+// Large enough for a few hundred entries per system call
+constexpr std::size_t kDirentBufferSize = 32 * 1024;
+
+bool isHiddenOrDotEntry(const char* name) {
+    // Hidden entries on Unix, including "." and ".."
+    return name[0] == '.';
+}
+#endif
+
+} // anonymous namespace
+
+DirectoryListing::DirectoryListing()
+        : m_fd(-1),
+          m_device(0) {
+}
+
+DirectoryListing::~DirectoryListing() {
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+//static
+QString DirectoryListing::entryPath(const QString& dirPath, const QString& entryName) {
+    if (dirPath.endsWith(QChar('/'))) {
+        return dirPath + entryName;
+    }
+    return dirPath + QChar('/') + entryName;
+}
+
+bool DirectoryListing::open(const QString& dirPath) {
+    m_dirPath = dirPath;
+#ifdef __LINUX__
+    DEBUG_ASSERT(m_fd < 0);
+    m_fd = ::open(QFile::encodeName(dirPath).constData(),
+            O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+    struct stat dirStat;
+    if (::fstat(m_fd, &dirStat) == 0) {
+        m_device = static_cast<quint64>(dirStat.st_dev);
+    }
+    return true;
+#else
+    return QDir(dirPath).exists();
+#endif
+}
+
+void DirectoryListing::read() {
+#ifdef __LINUX__
+    VERIFY_OR_DEBUG_ASSERT(m_fd >= 0) {
+        return;
+    }
+    // glibc only provides a wrapper for getdents64() since 2.30, but
+    // struct dirent64 matches the layout of the kernel's records.
+    alignas(struct dirent64) char buffer[kDirentBufferSize];
+    for (;;) {
+        const long length = ::syscall(SYS_getdents64, m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < length;) {
+            const auto* pEntry = reinterpret_cast<const struct dirent64*>(buffer + offset);
+            offset += pEntry->d_reclen;
+            if (isHiddenOrDotEntry(pEntry->d_name)) {
+                continue;
+            }
+            bool isFile = pEntry->d_type == DT_REG;
+            bool isDir = pEntry->d_type == DT_DIR;
+            if (pEntry->d_type == DT_LNK || pEntry->d_type == DT_UNKNOWN) {
+                // Follow symbolic links like QFileInfo
+                struct stat entryStat;
+                if (::fstatat(m_fd, pEntry->d_name, &entryStat, 0) != 0) {
+                    // Broken link
+                    continue;
+                }
+                isFile = S_ISREG(entryStat.st_mode);
+                isDir = S_ISDIR(entryStat.st_mode);
+            }
+            if (isFile) {
+                m_fileNames.append(QFile::decodeName(pEntry->d_name));
+            } else if (isDir) {
+                m_subDirNames.append(QFile::decodeName(pEntry->d_name));
+            }
+        }
+    }
+    ::close(m_fd);
+    m_fd = -1;
+    m_fileNames.sort();
+    m_subDirNames.sort();
+#else
+    // Same filter as the previous walker of RecursiveScanDirectoryTask.
+    // QDir::System includes e.g. shortcuts on Windows, all entries that
+    // are not files are scanned like directories.
+    QDir dir(m_dirPath);
+    dir.setFilter(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::System);
+    dir.setSorting(QDir::Name);
+    const QFileInfoList entries = dir.entryInfoList();
+    for (const auto& entry : entries) {
+        if (entry.isFile()) {
+            m_fileNames.append(entry.fileName());
+        } else {
+            m_subDirNames.append(entry.fileName());
+        }
+    }
+#endif
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+/// The entries of a single directory that are relevant for the library
+/// scanner: Regular files and subdirectories, both sorted by name like
+/// QDir::Name. Hidden entries are skipped and symbolic links are resolved
+/// like by QDir without QDir::Hidden and QDir::NoSymLinks.
+///
+/// On Linux the directory is opened only once and the entries are read
+/// in batches with getdents64(). The file type is usually provided by the
+/// file system. Only symbolic links and entries of unknown type need an
+/// additional fstatat() relative to the directory. In contrast, QDir and
+/// QFileInfo need at least one stat() per entry with the full path.
+///
+/// On other platforms QDir is used.
+class DirectoryListing {
+  public:
+    DirectoryListing();
+    ~DirectoryListing();
+    DirectoryListing(const DirectoryListing&) = delete;
+    DirectoryListing& operator=(const DirectoryListing&) = delete;
+
+    /// Opens the directory and determines the device it resides on.
+    /// Returns false if the directory is not accessible.
+    bool open(const QString& dirPath);
+
+    /// Reads all entries of the opened directory.
+    void read();
+
+    /// Identifies the device of the directory. Only valid after open()
+    /// and 0 if unknown.
+    quint64 device() const {
+        return m_device;
+    }
+
+    const QStringList& fileNames() const {
+        return m_fileNames;
+    }
+    const QStringList& subDirNames() const {
+        return m_subDirNames;
+    }
+
+    /// Joins the path of a directory with the name of one of its entries
+    /// like QDir::filePath().
+    static QString entryPath(const QString& dirPath, const QString& entryName);
+
+  private:
+    QString m_dirPath;
+    int m_fd;
+    quint64 m_device;
+    QStringList m_fileNames;
+    QStringList m_subDirNames;
+};
@@ -1,6 +1,7 @@
 #include "library/scanner/importfilestask.h"
 
 #include "moc_importfilestask.cpp"
+#include "sources/soundsourceproxy.h"
 #include "util/timer.h"
 
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
@@ -49,6 +50,19 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
+            // Parse the metadata concurrently on this worker thread.
+            // LibraryScanner only needs to write it into the database.
+            auto preparedImport = SoundSourceProxy::prepareTrackImportFromFile(
+                    mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken));
+            if (preparedImport.importResult ==
+                    mixxx::MetadataSource::ImportResult::Succeeded) {
+                if (!m_scannerGlobal->addPreparedTrackImport(
+                            trackLocation, std::move(preparedImport))) {
+                    setSuccess(false);
+                    return;
+                }
+            }
+
             emit addNewTrack(trackLocation);
         }
     }
@@ -1,9 +1,13 @@
 #include "library/scanner/libraryscanner.h"
 
+#include <QCryptographicHash>
+
 #include "library/coverartutils.h"
 #include "library/library_decl.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/libraryscannerdlg.h"
+#include "library/scanner/librarywatcher.h"
 #include "library/scanner/recursivescandirectorytask.h"
 #include "library/scanner/scannertask.h"
 #include "library/scanner/scannerutil.h"
@@ -14,19 +18,25 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
+// Directories are listed and metadata is parsed concurrently. Listings
+// on the same device are additionally limited by ScannerGlobal.
+const int kScannerThreadPoolSize = math_clamp(QThread::idealThreadCount(), 1, 8);
 
 mixxx::Logger kLogger("LibraryScanner");
 
 QAtomicInt s_instanceCounter(0);
 
+// Flags of LibraryScanner::m_queuedScan
+constexpr int kScanQueued = 0x1;
+constexpr int kManualScanQueued = 0x2;
+
 // Returns the number of affected rows or -1 on error
 int execRowCountQuery(FwdSqlQuery& query) {
     VERIFY_OR_DEBUG_ASSERT(query.isPrepared()) {
@@ -99,8 +109,14 @@ LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
-          m_trackDao(m_cueDao, m_playlistDao, m_analysisDao, m_libraryHashDao, pConfig),
+          m_trackDao(m_cueDao,
+                  m_playlistDao,
+                  m_analysisDao,
+                  m_libraryHashDao,
+                  m_searchIndex,
+                  pConfig),
           m_stateSema(1), // only one transaction is possible at a time
           m_state(IDLE),
           m_manualScan(true) {
@@ -170,14 +186,25 @@ void LibraryScanner::run() {
         m_libraryHashDao.initialize(dbConnection);
         m_cueDao.initialize(dbConnection);
         m_trackDao.initialize(dbConnection);
+        // Only updates an existing index, the triggers record the
+        // modifications if it is not usable with this connection
+        m_searchIndex.initialize(dbConnection);
         m_playlistDao.initialize(dbConnection);
         m_analysisDao.initialize(dbConnection);
         m_directoryDao.initialize(dbConnection);
 
+        if (m_pConfig->getValue(
+                    mixxx::library::prefs::kWatchDirectoriesConfigKey, false)) {
+            startWatching();
+        }
+
         // Start the event loop.
         kLogger.debug() << "Event loop starting";
         exec();
         kLogger.debug() << "Event loop stopped";
+
+        m_pReconcileTimer.reset();
+        m_pWatcher.reset();
     }
     kLogger.debug() << "Exiting thread";
 }
@@ -194,6 +221,8 @@ void LibraryScanner::slotStartScan() {
     // finish the scan immediately.
     if (m_libraryRootDirs.isEmpty()) {
         changeScannerState(IDLE);
+        startQueuedScan();
+        scanPendingChangedDirectories();
         return;
     }
     changeScannerState(SCANNING);
@@ -495,13 +524,223 @@ void LibraryScanner::slotFinishUnhashedScan() {
 
     emit scanFinished();
     emit scanSummary(result);
+
+    if (m_pWatcher) {
+        // Library directories might have been added or removed
+        watchLibraryDirectories();
+    }
+    startQueuedScan();
+    scanPendingChangedDirectories();
+}
+
+void LibraryScanner::startWatching() {
+    if (!LibraryWatcher::isSupported()) {
+        kLogger.info()
+                << "Watching the library directories is not supported"
+                << "on this platform";
+        return;
+    }
+    m_pWatcher = std::make_unique<LibraryWatcher>();
+    connect(m_pWatcher.get(),
+            &LibraryWatcher::directoriesChanged,
+            this,
+            &LibraryScanner::slotScanChangedDirectories);
+    // Rescan everything if the journal is incomplete
+    connect(m_pWatcher.get(),
+            &LibraryWatcher::eventsLost,
+            this,
+            [this] {
+                scan(true);
+            });
+
+    const int reconcileIntervalMinutes = m_pConfig->getValue(
+            mixxx::library::prefs::kWatchReconcileIntervalMinutesConfigKey,
+            mixxx::library::prefs::kWatchReconcileIntervalMinutesDefault);
+    if (reconcileIntervalMinutes > 0) {
+        m_pReconcileTimer = std::make_unique<QTimer>();
+        m_pReconcileTimer->setInterval(reconcileIntervalMinutes * 60 * 1000);
+        connect(m_pReconcileTimer.get(),
+                &QTimer::timeout,
+                this,
+                &LibraryScanner::slotReconcileWatchedDirectories);
+        m_pReconcileTimer->start();
+    }
+
+    watchLibraryDirectories();
+}
+
+void LibraryScanner::watchLibraryDirectories() {
+    DEBUG_ASSERT(m_pWatcher);
+    PerformanceTimer timer;
+    timer.start();
+    m_pWatcher->clear();
+    bool watchingAll = true;
+    const QList<mixxx::FileInfo> rootDirs = m_directoryDao.loadAllDirectories();
+    for (const mixxx::FileInfo& rootDir : rootDirs) {
+        if (!rootDir.exists() || !rootDir.isDir()) {
+            continue;
+        }
+        if (!m_pWatcher->watchDirectoryTree(rootDir.location())) {
+            watchingAll = false;
+        }
+    }
+    if (!watchingAll) {
+        kLogger.warning()
+                << "Failed to watch all library directories."
+                << "Some changes will only be detected by rescanning the library.";
+    }
+    kLogger.info()
+            << "Watching"
+            << m_pWatcher->numWatchedDirectories()
+            << "library directories took"
+            << timer.elapsed().debugMillisWithUnit();
+}
+
+void LibraryScanner::slotReconcileWatchedDirectories() {
+    if (m_pWatcher) {
+        m_pWatcher->reconcile();
+    }
+}
+
+void LibraryScanner::slotScanChangedDirectories(const QStringList& dirPaths) {
+    for (const auto& dirPath : dirPaths) {
+        m_pendingChangedDirectories.insert(dirPath);
+    }
+    scanPendingChangedDirectories();
+}
+
+void LibraryScanner::scanPendingChangedDirectories() {
+    if (m_pendingChangedDirectories.isEmpty()) {
+        return;
+    }
+    if (!changeScannerState(STARTING)) {
+        // Retried after the running scan has finished
+        return;
+    }
+    changeScannerState(SCANNING);
+    QStringList dirPaths = m_pendingChangedDirectories.values();
+    m_pendingChangedDirectories.clear();
+    dirPaths.sort();
+    scanChangedDirectories(dirPaths);
+    changeScannerState(FINISHED);
+    startQueuedScan();
+}
+
+void LibraryScanner::scanChangedDirectories(const QStringList& dirPaths) {
+    PerformanceTimer timer;
+    timer.start();
+
+    const QRegularExpression& supportedFileNamesRegex =
+            SoundSourceProxy::getSupportedFileNamesRegex();
+    QSet<TrackId> changedTrackIds;
+    QStringList addedTrackLocations;
+
+    m_trackDao.addTracksPrepare();
+    for (const QString& dirPath : dirPaths) {
+        // The same filter, sorting, and hash as in RecursiveScanDirectoryTask
+        QDir dir(dirPath);
+        dir.setFilter(QDir::Files | QDir::NoDotAndDotDot | QDir::System);
+        dir.setSorting(QDir::SortFlag::DirsFirst | QDir::SortFlag::Name);
+        const QFileInfoList files = dir.entryInfoList();
+        QCryptographicHash hasher(QCryptographicHash::Sha256);
+        QSet<QString> fileLocations;
+        for (const auto& fileInfo : files) {
+            if (!supportedFileNamesRegex.match(fileInfo.fileName()).hasMatch()) {
+                continue;
+            }
+            hasher.addData(fileInfo.filePath().toUtf8());
+            fileLocations.insert(mixxx::FileInfo(fileInfo).location());
+        }
+
+        QSet<QString> trackLocations;
+        changedTrackIds += m_trackDao.updateTrackLocationsInDirectory(
+                dirPath, fileLocations, &trackLocations);
+        for (const auto& fileLocation : std::as_const(fileLocations)) {
+            if (trackLocations.contains(fileLocation)) {
+                continue;
+            }
+            TrackPointer pTrack = m_trackDao.addTracksAddFile(fileLocation, false);
+            if (pTrack) {
+                addedTrackLocations.append(pTrack->getLocation());
+                emit trackAdded(pTrack);
+            }
+        }
+
+        // Skip the directory during the next rescan if it is not
+        // modified again.
+        if (!dir.exists()) {
+            m_libraryHashDao.updateDirectoryStatuses({dirPath}, true, true);
+            continue;
+        }
+        const mixxx::cache_key_t newHash =
+                mixxx::cacheKeyFromMessageDigest(hasher.result());
+        if (mixxx::isValidCacheKey(m_libraryHashDao.getDirectoryHash(dirPath))) {
+            m_libraryHashDao.updateDirectoryHash(dirPath, newHash, 0);
+        } else {
+            m_libraryHashDao.saveDirectoryHash(dirPath, newHash);
+        }
+    }
+    m_trackDao.addTracksFinish();
+
+    // Files might have been moved between directories
+    int numRelocatedTracks = 0;
+    if (!addedTrackLocations.isEmpty()) {
+        QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
+        ScopedTransaction transaction(dbConnection);
+        QList<RelocatedTrack> relocatedTracks;
+        const bool cancel = false;
+        if (m_trackDao.detectMovedTracks(
+                    &relocatedTracks, addedTrackLocations, &cancel)) {
+            transaction.commit();
+            numRelocatedTracks = relocatedTracks.size();
+            if (!relocatedTracks.isEmpty()) {
+                emit tracksRelocated(relocatedTracks);
+            }
+        }
+    }
+    if (!changedTrackIds.isEmpty()) {
+        emit tracksChanged(changedTrackIds);
+    }
+
+    kLogger.info()
+            << "Updated"
+            << dirPaths.size()
+            << "changed directories with"
+            << addedTrackLocations.size() - numRelocatedTracks
+            << "new tracks,"
+            << numRelocatedTracks
+            << "moved tracks, and"
+            << changedTrackIds.size()
+            << "missing or rediscovered tracks in"
+            << timer.elapsed().debugMillisWithUnit();
 }
 
 void LibraryScanner::scan(bool autoscan) {
-    if (changeScannerState(STARTING)) {
-        m_manualScan = autoscan;
-        emit startScan();
+    // Requests are queued while another scan is in progress, e.g. while
+    // updating changed directories, and coalesced into a single scan.
+    m_queuedScan.fetchAndOrOrdered(
+            autoscan ? kScanQueued : kScanQueued | kManualScanQueued);
+    startQueuedScan();
+}
+
+void LibraryScanner::startQueuedScan() {
+    if (m_queuedScan.loadAcquire() == 0) {
+        return;
+    }
+    if (!changeScannerState(STARTING)) {
+        // Retried after the running scan has finished
+        return;
+    }
+    const int queuedScan = m_queuedScan.fetchAndStoreOrdered(0);
+    if (queuedScan == 0) {
+        // Already started from another thread
+        changeScannerState(IDLE);
+        return;
     }
+    // The summary is shown if any of the requests was a manual scan
+    const bool autoscan = (queuedScan & kManualScanQueued) == 0;
+    m_manualScan = autoscan;
+    emit startScan();
 }
 
 // this is called after pressing the cancel button in the scanner
@@ -511,8 +750,16 @@ void LibraryScanner::slotCancel() {
     // All pending scan start request are canceled
     // as well until the scanner is idle again.
     changeScannerState(CANCELING);
+    m_queuedScan.storeRelease(0);
     cancel();
     changeScannerState(IDLE);
+    // Changed directories that have been collected in the meantime
+    QMetaObject::invokeMethod(
+            this,
+            [this] {
+                scanPendingChangedDirectories();
+            },
+            Qt::QueuedConnection);
 }
 
 void LibraryScanner::cancelAndQuit() {
@@ -627,10 +874,15 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
 void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer(QStringLiteral("LibraryScanner::addNewTrack"));
+    std::optional<SoundSourceProxy::PreparedTrackImport> preparedImport;
+    if (m_scannerGlobal) {
+        preparedImport = m_scannerGlobal->takePreparedTrackImport(trackPath);
+    }
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            preparedImport ? &*preparedImport : nullptr);
     if (!pTrack) {
         // This happens only when there is an issue with the database which
         // has been logged already. No need for yet another warning here.
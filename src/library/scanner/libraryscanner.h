@@ -2,11 +2,14 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <QAtomicInt>
 #include <QList>
 #include <QScopedPointer>
 #include <QSemaphore>
 #include <QThread>
 #include <QThreadPool>
+#include <QTimer>
+#include <memory>
 
 #include "library/dao/analysisdao.h"
 #include "library/dao/cuedao.h"
@@ -14,17 +17,20 @@
 #include "library/dao/libraryhashdao.h"
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackdao.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/scanner/scannerglobal.h"
 #include "track/track_decl.h"
 #include "util/db/dbconnectionpool.h"
 
 class ScannerTask;
 class LibraryScannerDlg;
+class LibraryWatcher;
 class QString;
 struct LibraryScanResultSummary;
 
 class LibraryScanner : public QThread {
     FRIEND_TEST(LibraryScannerTest, ScannerRoundtrip);
+    FRIEND_TEST(LibraryScannerTest, ScanChangedDirectories);
     Q_OBJECT
   public:
     LibraryScanner(
@@ -33,8 +39,8 @@ class LibraryScanner : public QThread {
     ~LibraryScanner() override;
 
   public slots:
-    // Call from any thread to start a scan. Does nothing if a scan is already
-    // in progress.
+    // Call from any thread to start a scan. If a scan is already in progress
+    // the request is queued and a single scan is started afterwards.
     // The autoscan flag is used for the summary report. Receivers of scanSummary()
     // can use this to decide whether to show the summary dialog, for example hide
     // it for the automatic scan during startup.
@@ -76,6 +82,10 @@ class LibraryScanner : public QThread {
     void slotTrackExists(const QString& trackPath);
     void slotAddNewTrack(const QString& trackPath);
 
+    // LibraryWatcher signal handlers.
+    void slotScanChangedDirectories(const QStringList& dirPaths);
+    void slotReconcileWatchedDirectories();
+
   private:
     enum ScannerState {
         IDLE,
@@ -100,7 +110,17 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    // Starts a queued scan if no other scan is in progress. Called from
+    // any thread.
+    void startQueuedScan();
+
+    void startWatching();
+    void watchLibraryDirectories();
+    void scanPendingChangedDirectories();
+    void scanChangedDirectories(const QStringList& dirPaths);
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const UserSettingsPointer m_pConfig;
 
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
@@ -111,6 +131,7 @@ class LibraryScanner : public QThread {
     PlaylistDAO m_playlistDao;
     DirectoryDAO m_directoryDao;
     AnalysisDao m_analysisDao;
+    TrackSearchIndex m_searchIndex;
     TrackDAO m_trackDao;
 
     // Global scanner state for scan currently in progress.
@@ -131,4 +152,15 @@ class LibraryScanner : public QThread {
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 
     bool m_manualScan;
+
+    // Requests of scan() that have not been started yet
+    QAtomicInt m_queuedScan;
+
+    // Only created and accessed in the library scanner thread if
+    // watching the library directories is enabled.
+    std::unique_ptr<LibraryWatcher> m_pWatcher;
+    std::unique_ptr<QTimer> m_pReconcileTimer;
+    // Changed directories that could not be updated yet, because
+    // another scan was in progress.
+    QSet<QString> m_pendingChangedDirectories;
 };
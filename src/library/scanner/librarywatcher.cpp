@@ -0,0 +1,317 @@
+#include "library/scanner/librarywatcher.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#ifdef __LINUX__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "moc_librarywatcher.cpp"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("LibraryWatcher");
+
+// Files that are copied into the library usually cause a burst of
+// events in the same directory.
+constexpr int kJournalFlushDelayMillis = 2000;
+
+#ifdef __LINUX__
+// Files are only reported after they have been written completely
+// to avoid importing incomplete files while they are still copied.
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+        IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+        IN_ONLYDIR;
+
+constexpr std::size_t kEventBufferSize = 64 * 1024;
+#endif
+
+QDateTime lastModified(const QString& dirPath) {
+    return QFileInfo(dirPath).lastModified();
+}
+
+bool isInDirectoryTree(const QString& path, const QString& rootDir) {
+    return path.startsWith(rootDir) &&
+            (path.size() == rootDir.size() || path.at(rootDir.size()) == QChar('/'));
+}
+
+} // anonymous namespace
+
+LibraryWatcher::LibraryWatcher(QObject* parent)
+        : QObject(parent),
+          m_fd(-1),
+          m_pNotifier(nullptr) {
+    m_journalTimer.setSingleShot(true);
+    m_journalTimer.setInterval(kJournalFlushDelayMillis);
+    connect(&m_journalTimer,
+            &QTimer::timeout,
+            this,
+            &LibraryWatcher::slotFlushJournal);
+}
+
+LibraryWatcher::~LibraryWatcher() {
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+//static
+bool LibraryWatcher::isSupported() {
+#ifdef __LINUX__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool LibraryWatcher::open() {
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        return true;
+    }
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        kLogger.warning()
+                << "Failed to initialize inotify:"
+                << std::strerror(errno);
+        return false;
+    }
+    m_pNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_pNotifier,
+            &QSocketNotifier::activated,
+            this,
+            &LibraryWatcher::slotReadEvents);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LibraryWatcher::clear() {
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        for (auto it = m_pathsByWatch.constBegin(); it != m_pathsByWatch.constEnd(); ++it) {
+            inotify_rm_watch(m_fd, it.key());
+        }
+    }
+#endif
+    m_pathsByWatch.clear();
+    m_watchesByPath.clear();
+    m_lastModifiedByPath.clear();
+    m_changedDirectories.clear();
+    m_journalTimer.stop();
+}
+
+bool LibraryWatcher::addWatch(const QString& dirPath) {
+#ifdef __LINUX__
+    if (m_watchesByPath.contains(dirPath)) {
+        return true;
+    }
+    const int wd = inotify_add_watch(m_fd, QFile::encodeName(dirPath).constData(), kWatchMask);
+    if (wd < 0) {
+        kLogger.warning()
+                << "Failed to watch directory"
+                << dirPath
+                << std::strerror(errno);
+        return false;
+    }
+    // The same directory might be reachable through different paths
+    const QString oldPath = m_pathsByWatch.value(wd);
+    if (!oldPath.isEmpty()) {
+        m_watchesByPath.remove(oldPath);
+        m_lastModifiedByPath.remove(oldPath);
+    }
+    m_pathsByWatch.insert(wd, dirPath);
+    m_watchesByPath.insert(dirPath, wd);
+    m_lastModifiedByPath.insert(dirPath, lastModified(dirPath));
+    return true;
+#else
+    Q_UNUSED(dirPath);
+    return false;
+#endif
+}
+
+bool LibraryWatcher::watchDirectoryTree(const QString& rootDir) {
+    if (!open()) {
+        return false;
+    }
+    if (!addWatch(rootDir)) {
+        return false;
+    }
+    // Like the scanner, hidden directories are skipped. Symbolic links
+    // are not followed to avoid cycles.
+    QDirIterator it(rootDir,
+            QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        if (!addWatch(it.next())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LibraryWatcher::removeWatchesInDirectoryTree(const QString& rootDir) {
+    auto it = m_watchesByPath.begin();
+    while (it != m_watchesByPath.end()) {
+        if (!isInDirectoryTree(it.key(), rootDir)) {
+            ++it;
+            continue;
+        }
+#ifdef __LINUX__
+        // Fails if the directory has already been deleted
+        inotify_rm_watch(m_fd, it.value());
+#endif
+        m_pathsByWatch.remove(it.value());
+        m_lastModifiedByPath.remove(it.key());
+        it = m_watchesByPath.erase(it);
+    }
+}
+
+void LibraryWatcher::journalDirectory(const QString& dirPath) {
+    m_changedDirectories.insert(dirPath);
+    if (!m_journalTimer.isActive()) {
+        m_journalTimer.start();
+    }
+}
+
+void LibraryWatcher::journalDirectoryTree(const QString& rootDir) {
+    journalDirectory(rootDir);
+    for (auto it = m_watchesByPath.constBegin(); it != m_watchesByPath.constEnd(); ++it) {
+        if (isInDirectoryTree(it.key(), rootDir)) {
+            m_changedDirectories.insert(it.key());
+        }
+    }
+}
+
+void LibraryWatcher::slotReadEvents() {
+#ifdef __LINUX__
+    alignas(struct inotify_event) char buffer[kEventBufferSize];
+    bool lostEvents = false;
+    for (;;) {
+        const ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN if all events have been read
+            break;
+        }
+        const char* pNext = buffer;
+        while (pNext < buffer + length) {
+            const auto* pEvent = reinterpret_cast<const struct inotify_event*>(pNext);
+            pNext += sizeof(struct inotify_event) + pEvent->len;
+            if (pEvent->mask & IN_Q_OVERFLOW) {
+                lostEvents = true;
+                continue;
+            }
+            const QString dirPath = m_pathsByWatch.value(pEvent->wd);
+            if (dirPath.isEmpty()) {
+                // The watch has already been removed
+                continue;
+            }
+            if (pEvent->mask & IN_IGNORED) {
+                m_pathsByWatch.remove(pEvent->wd);
+                m_watchesByPath.remove(dirPath);
+                m_lastModifiedByPath.remove(dirPath);
+                continue;
+            }
+            if (pEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                journalDirectoryTree(dirPath);
+                removeWatchesInDirectoryTree(dirPath);
+                continue;
+            }
+            const QString path = dirPath + QChar('/') +
+                    (pEvent->len > 0 ? QFile::decodeName(pEvent->name) : QString());
+            if (pEvent->mask & IN_ISDIR) {
+                // Only the files of a directory are relevant for the
+                // scanner, not its subdirectories.
+                if (pEvent->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    // Files might have been added before the watch
+                    // has been created.
+                    if (!watchDirectoryTree(path)) {
+                        lostEvents = true;
+                    }
+                    journalDirectoryTree(path);
+                } else if (pEvent->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    journalDirectoryTree(path);
+                    removeWatchesInDirectoryTree(path);
+                }
+                continue;
+            }
+            if (pEvent->mask & IN_CREATE) {
+                // Wait until the file has been written
+                continue;
+            }
+            journalDirectory(dirPath);
+        }
+    }
+    if (lostEvents) {
+        kLogger.warning() << "Events have been lost";
+        emit eventsLost();
+    }
+#endif
+}
+
+void LibraryWatcher::reconcile() {
+    QStringList modifiedDirPaths;
+    for (auto it = m_lastModifiedByPath.begin(); it != m_lastModifiedByPath.end(); ++it) {
+        const QDateTime modified = lastModified(it.key());
+        if (modified != it.value()) {
+            it.value() = modified;
+            modifiedDirPaths.append(it.key());
+        }
+    }
+    for (const auto& dirPath : std::as_const(modifiedDirPaths)) {
+        if (!QFileInfo::exists(dirPath)) {
+            journalDirectoryTree(dirPath);
+            removeWatchesInDirectoryTree(dirPath);
+            continue;
+        }
+        journalDirectory(dirPath);
+        // Subdirectories that have been added without notice
+        const QStringList subDirNames = QDir(dirPath).entryList(
+                QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+        for (const auto& subDirName : subDirNames) {
+            const QString subDirPath = dirPath + QChar('/') + subDirName;
+            if (!m_watchesByPath.contains(subDirPath)) {
+                watchDirectoryTree(subDirPath);
+                journalDirectoryTree(subDirPath);
+            }
+        }
+    }
+    kLogger.debug()
+            << "Reconciled"
+            << m_lastModifiedByPath.size()
+            << "directories:"
+            << modifiedDirPaths.size()
+            << "modified";
+}
+
+void LibraryWatcher::slotFlushJournal() {
+    if (m_changedDirectories.isEmpty()) {
+        return;
+    }
+    QStringList dirPaths = m_changedDirectories.values();
+    m_changedDirectories.clear();
+    dirPaths.sort();
+    // Avoid reporting these changes again when reconciling
+    for (const auto& dirPath : std::as_const(dirPaths)) {
+        const auto it = m_lastModifiedByPath.find(dirPath);
+        if (it != m_lastModifiedByPath.end()) {
+            it.value() = lastModified(dirPath);
+        }
+    }
+    kLogger.debug()
+            << "Directories changed:"
+            << dirPaths;
+    emit directoriesChanged(dirPaths);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+class QSocketNotifier;
+
+/// Watches the directory trees of the library for changes with inotify
+/// on Linux, so that only modified directories need to be rescanned
+/// instead of walking the whole library.
+///
+/// Events are collected in a journal of modified directories that is
+/// flushed periodically. Multiple events for the same directory, e.g.
+/// while copying an album, are thus merged into a single update.
+///
+/// Events might get lost, e.g. if the event queue overflows or if the
+/// files are modified remotely on a network share. reconcile() detects
+/// these changes by only comparing the modification times of the watched
+/// directories.
+///
+/// On other platforms the watcher is not supported and does nothing.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+  public:
+    explicit LibraryWatcher(QObject* parent = nullptr);
+    ~LibraryWatcher() override;
+
+    static bool isSupported();
+
+    /// Adds watches for a directory and all its subdirectories. Must be
+    /// invoked from the thread of the watcher.
+    ///
+    /// Returns false if not all directories could be watched, e.g. if the
+    /// limit for inotify watches has been reached.
+    bool watchDirectoryTree(const QString& rootDir);
+    void clear();
+
+    /// Journals all watched directories that have been modified since
+    /// they have been watched or reported.
+    void reconcile();
+
+    int numWatchedDirectories() const {
+        return static_cast<int>(m_pathsByWatch.size());
+    }
+
+  signals:
+    /// The files in these directories (not recursively) have been
+    /// added, removed, renamed, or modified. Directories that have been
+    /// removed are included.
+    void directoriesChanged(const QStringList& dirPaths);
+    /// Events have been lost and the library needs to be rescanned.
+    void eventsLost();
+
+  private slots:
+    void slotReadEvents();
+    void slotFlushJournal();
+
+  private:
+    bool open();
+    bool addWatch(const QString& dirPath);
+    void removeWatchesInDirectoryTree(const QString& rootDir);
+    void journalDirectoryTree(const QString& rootDir);
+    void journalDirectory(const QString& dirPath);
+
+    int m_fd;
+    QSocketNotifier* m_pNotifier;
+
+    QHash<int, QString> m_pathsByWatch;
+    QHash<QString, int> m_watchesByPath;
+    QHash<QString, QDateTime> m_lastModifiedByPath;
+
+    QSet<QString> m_changedDirectories;
+    QTimer m_journalTimer;
+};
@@ -1,9 +1,9 @@
 #include "library/scanner/recursivescandirectorytask.h"
 
 #include <QCryptographicHash>
-#include <QDir>
 #include <QFileInfo>
 
+#include "library/scanner/directorylisting.h"
 #include "library/scanner/importfilestask.h"
 #include "library/scanner/libraryscanner.h"
 #include "moc_recursivescandirectorytask.cpp"
@@ -30,15 +30,15 @@ void RecursiveScanDirectoryTask::run() {
     //qDebug() << "Burn CPU";
     //for (int i = 0;i < 1000000000; i++) asm("nop");
 
-    // Note, we save on filesystem operations (and random work) by initializing
-    // a QDirIterator with a QDir instead of a QString -- but it inherits its
-    // Filter from the QDir so we have to set it first. If the QDir has not done
-    // any FS operations yet then this should be lightweight.
-    auto dir = m_dirAccess.info().toQDir();
-    dir.setFilter(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::System);
-    // sort directory by file name to increase chance that files are sorted sensible
-    dir.setSorting(QDir::SortFlag::DirsFirst | QDir::SortFlag::Name);
-    const QFileInfoList children = dir.entryInfoList();
+    const QString dirLocation = m_dirAccess.info().location();
+
+    // Only the names and types of the entries are needed. Reading them
+    // in batches avoids a stat() per entry like QDir::entryInfoList().
+    DirectoryListing listing;
+    if (listing.open(dirLocation)) {
+        const auto deviceReleaser = m_scannerGlobal->acquireDevice(listing.device());
+        listing.read();
+    }
 
     std::list<QFileInfo> filesToImport;
     std::list<QFileInfo> possibleCovers;
@@ -53,39 +53,36 @@ void RecursiveScanDirectoryTask::run() {
     QRegularExpression supportedCoverExtensionsRegex =
             m_scannerGlobal->supportedCoverExtensionsRegex();
 
-    for (const auto& currentFileInfo : children) {
-        QString currentFile = currentFileInfo.filePath();
-
-        if (currentFileInfo.isFile()) {
-            const QString& fileName = currentFileInfo.fileName();
-            const QRegularExpressionMatch supportedExtensionsMatch =
-                    supportedExtensionsRegex.match(fileName);
-            if (supportedExtensionsMatch.hasMatch()) {
-                hasher.addData(currentFile.toUtf8());
-                filesToImport.push_back(currentFileInfo);
-            } else {
-                const QRegularExpressionMatch supportedCoverExtensionsMatch =
-                        supportedCoverExtensionsRegex.match(fileName);
-                if (supportedCoverExtensionsMatch.hasMatch()) {
-                    possibleCovers.push_back(currentFileInfo);
-                }
-            }
+    // The files are hashed in the same order as before, i.e. sorted
+    // by name, to keep the stored directory hashes valid.
+    for (const auto& fileName : listing.fileNames()) {
+        const QString currentFile = DirectoryListing::entryPath(dirLocation, fileName);
+        const QRegularExpressionMatch supportedExtensionsMatch =
+                supportedExtensionsRegex.match(fileName);
+        if (supportedExtensionsMatch.hasMatch()) {
+            hasher.addData(currentFile.toUtf8());
+            filesToImport.push_back(QFileInfo(currentFile));
         } else {
-            // File is a directory
-            if (m_scannerGlobal->directoryBlacklisted(currentFile)) {
-                // Skip blacklisted directories like the iTunes Album
-                // Art Folder since it is probably a waste of time.
-                continue;
+            const QRegularExpressionMatch supportedCoverExtensionsMatch =
+                    supportedCoverExtensionsRegex.match(fileName);
+            if (supportedCoverExtensionsMatch.hasMatch()) {
+                possibleCovers.push_back(QFileInfo(currentFile));
             }
-            dirsToScan.push_back(mixxx::FileInfo(std::move(currentFileInfo)));
         }
     }
+    for (const auto& subDirName : listing.subDirNames()) {
+        const QString currentDir = DirectoryListing::entryPath(dirLocation, subDirName);
+        if (m_scannerGlobal->directoryBlacklisted(currentDir)) {
+            // Skip blacklisted directories like the iTunes Album
+            // Art Folder since it is probably a waste of time.
+            continue;
+        }
+        dirsToScan.push_back(mixxx::FileInfo(currentDir));
+    }
 
     // Calculate a hash of the directory's file list.
     const mixxx::cache_key_t newHash = mixxx::cacheKeyFromMessageDigest(hasher.result());
 
-    QString dirLocation = m_dirAccess.info().location();
-
     // Try to retrieve a hash from the last time that directory was scanned.
     const mixxx::cache_key_t prevHash = m_scannerGlobal->directoryHashInDatabase(dirLocation);
     const bool prevHashExists = mixxx::isValidCacheKey(prevHash);
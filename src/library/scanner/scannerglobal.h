@@ -4,10 +4,15 @@
 #include <QHash>
 #include <QMutex>
 #include <QRegularExpression>
+#include <QSemaphore>
 #include <QSet>
 #include <QSharedPointer>
 #include <QStringList>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 
+#include "sources/soundsourceproxy.h"
 #include "util/cache.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
@@ -29,6 +34,7 @@ class ScannerGlobal {
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
+              m_pendingTrackImports(kMaxPendingTrackImports),
               m_numScannedDirectories(0),
               m_numRelocatedTracks(0) {
     }
@@ -147,6 +153,58 @@ class ScannerGlobal {
         m_addedTracks << trackLocation;
     }
 
+    // Stores the metadata of a new track that has been imported by a
+    // worker thread until the track is added to the database. Blocks
+    // while too many imports are pending to limit the memory consumption
+    // if the database writer can't keep up with the workers. Returns
+    // false if the scan has been canceled while waiting.
+    bool addPreparedTrackImport(
+            const QString& trackLocation,
+            SoundSourceProxy::PreparedTrackImport&& preparedImport) {
+        while (!m_pendingTrackImports.tryAcquire(1, kPendingTrackImportTimeoutMillis)) {
+            if (shouldCancel()) {
+                return false;
+            }
+        }
+        const auto locker = lockMutex(&m_preparedTrackImportsMutex);
+        m_preparedTrackImports.insert(trackLocation, std::move(preparedImport));
+        return true;
+    }
+
+    std::optional<SoundSourceProxy::PreparedTrackImport> takePreparedTrackImport(
+            const QString& trackLocation) {
+        const auto locker = lockMutex(&m_preparedTrackImportsMutex);
+        const auto it = m_preparedTrackImports.find(trackLocation);
+        if (it == m_preparedTrackImports.end()) {
+            return std::nullopt;
+        }
+        auto preparedImport = std::move(it.value());
+        m_preparedTrackImports.erase(it);
+        m_pendingTrackImports.release();
+        return preparedImport;
+    }
+
+    // Limits the number of directories that are listed concurrently on
+    // the same device. Listing directories is I/O bound and too many
+    // concurrent requests would only cause seeks on rotational disks
+    // or congest network shares, while directories on other devices
+    // could be listed in the meantime. The returned releaser must be
+    // kept until the directory has been read.
+    QSemaphoreReleaser acquireDevice(quint64 device) {
+        QSemaphore* pSemaphore;
+        {
+            const auto locker = lockMutex(&m_deviceSemaphoresMutex);
+            auto& pDeviceSemaphore = m_deviceSemaphores[device];
+            if (!pDeviceSemaphore) {
+                pDeviceSemaphore = std::make_unique<QSemaphore>(
+                        kMaxConcurrentListingsPerDevice);
+            }
+            pSemaphore = pDeviceSemaphore.get();
+        }
+        pSemaphore->acquire();
+        return QSemaphoreReleaser(pSemaphore);
+    }
+
     int numScannedDirectories() const {
         return m_numScannedDirectories;
     }
@@ -162,6 +220,10 @@ class ScannerGlobal {
     }
 
   private:
+    static constexpr int kMaxPendingTrackImports = 1000;
+    static constexpr int kPendingTrackImportTimeoutMillis = 100;
+    static constexpr int kMaxConcurrentListingsPerDevice = 4;
+
     TaskWatcher m_watcher;
 
     QSet<QString> m_trackLocations;
@@ -202,6 +264,17 @@ class ScannerGlobal {
     volatile bool m_scanFinishedCleanly;
     volatile bool m_shouldCancel;
 
+    // Track metadata that has been imported concurrently by
+    // ImportFilesTask, consumed by LibraryScanner.
+    QMutex m_preparedTrackImportsMutex;
+    QHash<QString, SoundSourceProxy::PreparedTrackImport> m_preparedTrackImports;
+    QSemaphore m_pendingTrackImports;
+
+    // Semaphores are never removed while scanning, so the pointers
+    // remain valid without holding the mutex.
+    QMutex m_deviceSemaphoresMutex;
+    std::unordered_map<quint64, std::unique_ptr<QSemaphore>> m_deviceSemaphores;
+
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
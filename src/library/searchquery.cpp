@@ -1,7 +1,10 @@
 #include "library/searchquery.h"
 
 #include <QRegularExpression>
+#include <algorithm>
 
+#include "library/columnartrackindex.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/trackset/crate/crateschema.h"
@@ -115,6 +118,23 @@ bool AndNode::match(const TrackPointer& pTrack) const {
     return true;
 }
 
+bool AndNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    // An empty AND node always evaluates to true
+    pMatches->assign(index.rowCount(), ColumnarTrackIndex::kRowTrue);
+    std::vector<uint8_t> nodeMatches;
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->matchIndexed(index, &nodeMatches)) {
+            return false;
+        }
+        for (std::size_t row = 0; row < pMatches->size(); ++row) {
+            (*pMatches)[row] = std::min((*pMatches)[row], nodeMatches[row]);
+        }
+    }
+    return true;
+}
+
 QString AndNode::toSql() const {
     QStringList queryFragments;
     queryFragments.reserve(static_cast<int>(m_nodes.size()));
@@ -136,6 +156,22 @@ bool OrNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
+bool OrNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    pMatches->assign(index.rowCount(), ColumnarTrackIndex::kRowFalse);
+    std::vector<uint8_t> nodeMatches;
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->matchIndexed(index, &nodeMatches)) {
+            return false;
+        }
+        for (std::size_t row = 0; row < pMatches->size(); ++row) {
+            (*pMatches)[row] = std::max((*pMatches)[row], nodeMatches[row]);
+        }
+    }
+    return true;
+}
+
 QString OrNode::toSql() const {
     if (m_nodes.empty()) {
         return "FALSE";
@@ -155,6 +191,19 @@ bool NotNode::match(const TrackPointer& pTrack) const {
     return !m_pNode->match(pTrack);
 }
 
+bool NotNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    if (!m_pNode->matchIndexed(index, pMatches)) {
+        return false;
+    }
+    // NOT NULL is still NULL
+    for (auto& match : *pMatches) {
+        match = static_cast<uint8_t>(ColumnarTrackIndex::kRowTrue - match);
+    }
+    return true;
+}
+
 QString NotNode::toSql() const {
     QString sql(m_pNode->toSql());
     if (sql.isEmpty()) {
@@ -200,8 +249,7 @@ bool TextFilterNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
-QString TextFilterNode::toSql() const {
-    FieldEscaper escaper(m_database);
+QString TextFilterNode::likePattern() const {
     QString argument = m_argument;
     if (argument.size() > 0) {
         if (argument[argument.size() - 1].isSpace()) {
@@ -210,22 +258,62 @@ QString TextFilterNode::toSql() const {
             argument.append('_');
         }
     }
-    QString escapedArgument;
     // Using a switch-case without default case to get a compile-time -Wswitch warning
     switch (m_matchMode) {
     case StringMatch::Contains:
-        escapedArgument = escaper.escapeString(
-                kSqlLikeMatchAll + argument + kSqlLikeMatchAll);
-        break;
+        return kSqlLikeMatchAll + argument + kSqlLikeMatchAll;
     case StringMatch::Equals:
-        escapedArgument = escaper.escapeString(argument);
-        break;
+        return argument;
     }
+    DEBUG_ASSERT(!"unreachable");
+    return argument;
+}
+
+bool TextFilterNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    const QString pattern = likePattern();
+    pMatches->assign(index.rowCount(), ColumnarTrackIndex::kRowFalse);
+    for (const auto& sqlColumn : m_sqlColumns) {
+        if (!index.matchLike(sqlColumn, pattern, pMatches)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString TextFilterNode::toSql() const {
+    FieldEscaper escaper(m_database);
+    const QString escapedArgument = escaper.escapeString(likePattern());
     QStringList searchClauses;
     for (const auto& sqlColumn : m_sqlColumns) {
         searchClauses << QString("%1 LIKE %2").arg(sqlColumn, escapedArgument);
     }
-    return concatSqlClauses(searchClauses, "OR");
+    const QString likeSql = concatSqlClauses(searchClauses, "OR");
+    if (m_searchIndexIdColumn.isEmpty()) {
+        return likeSql;
+    }
+    const QString matchQuery = TrackSearchIndex::matchQuery(m_sqlColumns, likePattern());
+    if (matchQuery.isEmpty()) {
+        return likeSql;
+    }
+    // The index only finds candidates, the LIKE expression is still
+    // evaluated for the remaining tracks. All other tracks don't match,
+    // but the result must still be NULL instead of false if any of the
+    // columns is NULL. Otherwise a negated filter would match tracks
+    // that it doesn't match without the index.
+    QStringList nullClauses;
+    for (const auto& sqlColumn : m_sqlColumns) {
+        nullClauses << QString("%1 IS NULL").arg(sqlColumn);
+    }
+    return QString(
+            "CASE WHEN %1 IN (SELECT rowid FROM %2 WHERE %2 MATCH %3) THEN (%4) "
+            "WHEN %5 THEN NULL ELSE 0 END")
+            .arg(m_searchIndexIdColumn,
+                    TrackSearchIndex::kTableName,
+                    escaper.escapeString(matchQuery),
+                    likeSql,
+                    nullClauses.join(" OR "));
 }
 
 bool NullOrEmptyTextFilterNode::match(const TrackPointer& pTrack) const {
@@ -240,6 +328,17 @@ bool NullOrEmptyTextFilterNode::match(const TrackPointer& pTrack) const {
     return false;
 }
 
+bool NullOrEmptyTextFilterNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    if (m_sqlColumns.isEmpty()) {
+        return false;
+    }
+    pMatches->assign(index.rowCount(), ColumnarTrackIndex::kRowFalse);
+    // only use the major column
+    return index.matchNullOrEmpty(m_sqlColumns.first(), pMatches);
+}
+
 QString NullOrEmptyTextFilterNode::toSql() const {
     if (!m_sqlColumns.isEmpty()) {
         // only use the major column
@@ -255,21 +354,41 @@ CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
           m_matchInitialized(false) {
 }
 
-bool CrateFilterNode::match(const TrackPointer& pTrack) const {
-    if (!m_matchInitialized) {
-        CrateTrackSelectResult crateTracks(
-                m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
-
-        while (crateTracks.next()) {
-            m_matchingTrackIds.push_back(crateTracks.trackId());
-        }
+void CrateFilterNode::initMatchingTrackIds() const {
+    if (m_matchInitialized) {
+        return;
+    }
+    CrateTrackSelectResult crateTracks(
+            m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
 
-        m_matchInitialized = true;
+    while (crateTracks.next()) {
+        m_matchingTrackIds.push_back(crateTracks.trackId());
     }
 
+    m_matchInitialized = true;
+}
+
+bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+    initMatchingTrackIds();
     return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
 }
 
+bool CrateFilterNode::matchIndexed(
+        const ColumnarTrackIndex& index,
+        std::vector<uint8_t>* pMatches) const {
+    // The crate tracks are selected once, which is much cheaper than
+    // evaluating the whole query by the database
+    initMatchingTrackIds();
+    pMatches->assign(index.rowCount(), ColumnarTrackIndex::kRowFalse);
+    for (const auto& trackId : m_matchingTrackIds) {
+        const int row = index.rowOf(trackId);
+        if (row >= 0) {
+            (*pMatches)[row] = ColumnarTrackIndex::kRowTrue;
+        }
+    }
+    return true;
+}
+
 QString CrateFilterNode::toSql() const {
     return QString("id IN (%1)")
             .arg(m_pCrateStorage->formatQueryForTrackIdsByCrateNameLike(
@@ -5,6 +5,7 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "track/track_decl.h"
 #include "util/assert.h"
 
+class ColumnarTrackIndex;
 class CrateStorage;
 class TrackId;
 
@@ -31,6 +33,20 @@ class QueryNode {
     virtual bool match(const TrackPointer& pTrack) const = 0;
     virtual QString toSql() const = 0;
 
+    /// Evaluate the node for all rows of the index at once without
+    /// evaluating the whole query by the database. The matches are
+    /// stored as one ColumnarTrackIndex::RowMatch value per row.
+    ///
+    /// Returns false if the node refers to columns that are not
+    /// indexed or could only be evaluated by the database.
+    virtual bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const {
+        Q_UNUSED(index);
+        Q_UNUSED(pMatches);
+        return false;
+    }
+
   protected:
     QueryNode() = default;
 };
@@ -53,12 +69,18 @@ class OrNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 };
 
 class AndNode : public GroupNode {
   public:
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 };
 
 class NotNode : public QueryNode {
@@ -70,6 +92,9 @@ class NotNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 
   private:
     std::unique_ptr<QueryNode> m_pNode;
@@ -82,14 +107,27 @@ class TextFilterNode : public QueryNode {
             const QString& argument,
             const StringMatch matchMode = StringMatch::Contains);
 
+    /// Narrow down the tracks with the TrackSearchIndex before evaluating
+    /// the LIKE expression. The id column must contain the library ids.
+    void setSearchIndexIdColumn(const QString& idColumn) {
+        m_searchIndexIdColumn = idColumn;
+    }
+
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 
   private:
+    // The unescaped argument of the LIKE operator
+    QString likePattern() const;
+
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
     QString m_argument;
     StringMatch m_matchMode;
+    QString m_searchIndexIdColumn;
 };
 
 class NullOrEmptyTextFilterNode : public QueryNode {
@@ -102,6 +140,9 @@ class NullOrEmptyTextFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 
   private:
     QSqlDatabase m_database;
@@ -115,8 +156,13 @@ class CrateFilterNode : public QueryNode {
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
+    bool matchIndexed(
+            const ColumnarTrackIndex& index,
+            std::vector<uint8_t>* pMatches) const override;
 
   private:
+    void initMatchingTrackIds() const;
+
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
     mutable bool m_matchInitialized;
@@ -168,6 +168,22 @@ SearchQueryParser::TextArgumentResult SearchQueryParser::getTextArgument(QString
     return {argument, mode};
 }
 
+void SearchQueryParser::setSearchIndexIdColumn(const QString& idColumn) {
+    m_searchIndexIdColumn = idColumn;
+}
+
+std::unique_ptr<TextFilterNode> SearchQueryParser::makeTextFilterNode(
+        const QStringList& sqlColumns,
+        const QString& argument,
+        StringMatch matchMode) const {
+    auto pNode = std::make_unique<TextFilterNode>(
+            m_pTrackCollection->database(), sqlColumns, argument, matchMode);
+    if (!m_searchIndexIdColumn.isEmpty()) {
+        pNode->setSearchIndexIdColumn(m_searchIndexIdColumn);
+    }
+    return pNode;
+}
+
 void SearchQueryParser::parseTokens(QStringList tokens,
                                     AndNode* pQuery) const {
     while (tokens.size() > 0) {
@@ -202,9 +218,7 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     pNode = std::make_unique<CrateFilterNode>(
                             &m_pTrackCollection->crates(), argument);
                 } else {
-                    pNode = std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(),
-                            m_fieldToSqlColumns[field],
+                    pNode = makeTextFilterNode(m_fieldToSqlColumns[field],
                             argument,
                             matchMode);
                 }
@@ -238,8 +252,7 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                             pNode = std::make_unique<NullOrEmptyTextFilterNode>(
                                     m_pTrackCollection->database(), m_fieldToSqlColumns[field]);
                         } else {
-                            pNode = std::make_unique<TextFilterNode>(
-                                    m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                            pNode = makeTextFilterNode(m_fieldToSqlColumns[field], argument);
                         }
                     } else {
                         pNode = std::make_unique<KeyFilterNode>(key, fuzzy);
@@ -255,8 +268,7 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                         field == "added" ||
                         field == "dateadded") {
                     field = "datetime_added";
-                    pNode = std::make_unique<TextFilterNode>(
-                        m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                    pNode = makeTextFilterNode(m_fieldToSqlColumns[field], argument);
                 } else if (field == "bpm") {
                     if (matchMode == StringMatch::Equals) {
                         // restore = operator removed by getTextArgument()
@@ -280,12 +292,10 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     auto gNode = std::make_unique<OrNode>();
                     gNode->addNode(std::make_unique<CrateFilterNode>(
                                     &m_pTrackCollection->crates(), argument));
-                    gNode->addNode(std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument));
+                    gNode->addNode(makeTextFilterNode(m_queryColumns, argument));
                     pNode = std::move(gNode);
                 } else {
-                    pNode = std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument);
+                    pNode = makeTextFilterNode(m_queryColumns, argument);
                 }
             }
         }
@@ -385,3 +395,54 @@ bool SearchQueryParser::queryIsLessSpecific(const QString& original, const QStri
     }
     return false;
 }
+
+namespace {
+
+// A plain search term matches a substring of the search columns, i.e. it
+// matches less when extended by more characters.
+bool isPlainSearchTerm(const QString& word) {
+    return !word.contains(':') &&
+            !word.startsWith(kNegatePrefix) &&
+            !word.startsWith(kFuzzyPrefix) &&
+            !word.startsWith('=') &&
+            !word.contains('"');
+}
+
+} // anonymous namespace
+
+bool SearchQueryParser::queryIsMoreSpecific(const QString& original, const QString& changed) {
+    // Alternatives could add matches in any term
+    if (original.contains(kSplitOnOrOperatorRegexp) ||
+            changed.contains(kSplitOnOrOperatorRegexp)) {
+        return false;
+    }
+    const QStringList oldWordList = SearchQueryParser::splitQueryIntoWords(original);
+    QStringList newWordList = SearchQueryParser::splitQueryIntoWords(changed);
+
+    // All terms are combined with AND. Each old term must still be present,
+    // either unmodified or, if it is a plain search term that matches a
+    // substring, extended by more characters. Additional terms only remove
+    // matches.
+    for (const QString& oldWord : oldWordList) {
+        int matchingIndex = newWordList.indexOf(oldWord);
+        if (matchingIndex < 0) {
+            if (!isPlainSearchTerm(oldWord)) {
+                return false;
+            }
+            for (int j = 0; j < newWordList.length(); j++) {
+                const QString& newWord = newWordList.at(j);
+                // The extended term must still be a plain search term,
+                // e.g. "art" must not match "artist:abba"
+                if (newWord.startsWith(oldWord) && isPlainSearchTerm(newWord)) {
+                    matchingIndex = j;
+                    break;
+                }
+            }
+            if (matchingIndex < 0) {
+                return false;
+            }
+        }
+        newWordList.removeAt(matchingIndex);
+    }
+    return true;
+}
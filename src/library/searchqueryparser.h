@@ -17,6 +17,10 @@ class SearchQueryParser {
 
     void setSearchColumns(QStringList searchColumns);
 
+    /// Use the TrackSearchIndex for text filters. The id column must
+    /// contain the library ids of the tracks.
+    void setSearchIndexIdColumn(const QString& idColumn);
+
     std::unique_ptr<QueryNode> parseQuery(
             const QString& query,
             const QString& extraFilter) const;
@@ -25,11 +29,21 @@ class SearchQueryParser {
     static QStringList splitQueryIntoWords(const QString& query);
     /// checks if the changed search query is less specific then the original term
     static bool queryIsLessSpecific(const QString& original, const QString& changed);
+    /// checks if all tracks matching the changed search query also match the
+    /// original query, i.e. if the changed query only adds terms or extends
+    /// plain search terms. This is a conservative check that may return
+    /// false for some queries that are actually more specific.
+    static bool queryIsMoreSpecific(const QString& original, const QString& changed);
 
   private:
     void parseTokens(QStringList tokens,
                      AndNode* pQuery) const;
 
+    std::unique_ptr<TextFilterNode> makeTextFilterNode(
+            const QStringList& sqlColumns,
+            const QString& argument,
+            StringMatch matchMode = StringMatch::Contains) const;
+
     std::unique_ptr<AndNode> parseAndNode(const QString& query) const;
     std::unique_ptr<OrNode> parseOrNode(const QString& query) const;
 
@@ -49,6 +63,7 @@ class SearchQueryParser {
     QStringList m_numericFilters;
     QStringList m_specialFilters;
     QHash<QString, QStringList> m_fieldToSqlColumns;
+    QString m_searchIndexIdColumn;
 
     QRegularExpression m_textFilterMatcher;
     QRegularExpression m_crateFilterMatcher;
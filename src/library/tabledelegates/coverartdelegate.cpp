@@ -1,6 +1,7 @@
 #include "library/tabledelegates/coverartdelegate.h"
 
 #include <QPainter>
+#include <QScrollBar>
 #include <QTableView>
 #include <algorithm>
 
@@ -41,6 +42,10 @@ CoverArtDelegate::CoverArtDelegate(QTableView* parent)
         kLogger.warning()
                 << "Caching of cover art is not available";
     }
+    connect(m_pTableView->verticalScrollBar(),
+            &QScrollBar::valueChanged,
+            this,
+            &CoverArtDelegate::slotCancelInvisibleRequests);
 }
 
 void CoverArtDelegate::emitRowsChanged(
@@ -70,10 +75,12 @@ void CoverArtDelegate::requestUncachedCover(
         // The CoverArtCache will take care of the update
         const auto pTrack = m_pTrackModel->getTrackByRef(
                 TrackRef::fromFilePath(coverInfo.trackLocation));
-        CoverArtCache::requestUncachedCover(this, pTrack, width);
+        CoverArtCache::requestUncachedCover(
+                this, pTrack, width, CoverArtCache::Priority::Visible);
     } else {
         // This is the fast path with an internal temporary track
-        CoverArtCache::requestUncachedCover(this, coverInfo, width);
+        CoverArtCache::requestUncachedCover(
+                this, coverInfo, width, CoverArtCache::Priority::Visible);
     }
     m_pendingCacheRows.insert(coverInfo.cacheKey(), row);
 }
@@ -91,9 +98,8 @@ void CoverArtDelegate::slotInhibitLazyLoading(
     const int width = static_cast<int>(m_pTableView->columnWidth(m_column) * scaleFactor);
 
     for (int row : std::as_const(m_cacheMissRows)) {
-        const QModelIndex index = m_pTableView->model()->index(row, m_column);
-        const QRect rect = m_pTableView->visualRect(index);
-        if (rect.intersects(m_pTableView->rect())) {
+        if (isRowVisible(row)) {
+            const QModelIndex index = m_pTableView->model()->index(row, m_column);
             const CoverInfo coverInfo = m_pTrackModel->getCoverInfo(index);
             requestUncachedCover(coverInfo, width, row);
         }
@@ -101,6 +107,23 @@ void CoverArtDelegate::slotInhibitLazyLoading(
     m_cacheMissRows.clear();
 }
 
+void CoverArtDelegate::slotCancelInvisibleRequests() {
+    if (m_pendingCacheRows.isEmpty()) {
+        return;
+    }
+    const QList<mixxx::cache_key_t> cacheKeys = m_pendingCacheRows.uniqueKeys();
+    for (const auto cacheKey : cacheKeys) {
+        const QList<int> rows = m_pendingCacheRows.values(cacheKey);
+        if (std::any_of(rows.cbegin(), rows.cend(), [this](int row) {
+                    return isRowVisible(row);
+                })) {
+            continue;
+        }
+        CoverArtCache::cancelCoverRequest(this, cacheKey);
+        m_pendingCacheRows.remove(cacheKey);
+    }
+}
+
 void CoverArtDelegate::slotCoverFound(
         const QObject* pRequester,
         const CoverInfo& coverInfo,
@@ -177,12 +200,16 @@ void CoverArtDelegate::paintItem(
     }
 }
 
+bool CoverArtDelegate::isRowVisible(int row) const {
+    const QModelIndex index = m_pTableView->model()->index(row, m_column);
+    const QRect rect = m_pTableView->visualRect(index);
+    return rect.intersects(m_pTableView->rect());
+}
+
 void CoverArtDelegate::cleanCacheMissRows() const {
     auto it = m_cacheMissRows.cbegin();
     while (it != m_cacheMissRows.cend()) {
-        const QModelIndex index = m_pTableView->model()->index(*it, m_column);
-        const QRect rect = m_pTableView->visualRect(index);
-        if (!rect.intersects(m_pTableView->rect())) {
+        if (!isRowVisible(*it)) {
             // Cover image row is no longer shown. We keep the set
             // small which likely reuses the allocatd memory later
             it = constErase(&m_cacheMissRows, it);
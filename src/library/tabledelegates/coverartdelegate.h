@@ -48,6 +48,9 @@ class CoverArtDelegate : public TableItemDelegate {
             const QObject* pRequester,
             const CoverInfo& coverInfo,
             const QPixmap& pixmap);
+    // Cancels pending requests for covers that have been
+    // scrolled out of view before they have been loaded.
+    void slotCancelInvisibleRequests();
 
   protected:
     TrackModel* const m_pTrackModel;
@@ -56,6 +59,7 @@ class CoverArtDelegate : public TableItemDelegate {
     void emitRowsChanged(
             QList<int>&& rows);
     void cleanCacheMissRows() const;
+    bool isRowVisible(int row) const;
     void requestUncachedCover(
             const CoverInfo& coverInfo,
             int width,
@@ -21,7 +21,7 @@ TrackCollection::TrackCollection(
         : QObject(parent),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
-                     m_analysisDao, m_libraryHashDao, pConfig) {
+                     m_analysisDao, m_libraryHashDao, m_searchIndex, pConfig) {
     // Forward signals from TrackDAO
     connect(&m_trackDao,
             &TrackDAO::trackDirty,
@@ -72,6 +72,9 @@ void TrackCollection::connectDatabase(const QSqlDatabase& database) {
     DEBUG_ASSERT(database.isOpen());
     m_database = database;
     m_trackDao.initialize(database);
+    m_searchIndex.initialize(database);
+    // Pending tracks are updated asynchronously
+    m_searchIndex.createIfMissing();
     m_playlistDao.initialize(database);
     m_cueDao.initialize(database);
     m_directoryDao.initialize(database);
@@ -122,6 +125,19 @@ void TrackCollection::connectTrackSource(QSharedPointer<BaseTrackCache> pTrackSo
             &TrackDAO::tracksRemoved,
             m_pTrackSource.data(),
             &BaseTrackCache::slotTracksRemoved);
+    // Crate filters of the previous search may match other tracks now
+    connect(this,
+            &TrackCollection::crateTracksChanged,
+            m_pTrackSource.data(),
+            &BaseTrackCache::slotTrackMembershipChanged);
+    connect(this,
+            &TrackCollection::crateUpdated,
+            m_pTrackSource.data(),
+            &BaseTrackCache::slotTrackMembershipChanged);
+    connect(this,
+            &TrackCollection::crateDeleted,
+            m_pTrackSource.data(),
+            &BaseTrackCache::slotTrackMembershipChanged);
 }
 
 QWeakPointer<BaseTrackCache> TrackCollection::disconnectTrackSource() {
@@ -131,6 +147,7 @@ QWeakPointer<BaseTrackCache> TrackCollection::disconnectTrackSource() {
     if (m_pTrackSource) {
         kLogger.info() << "Disconnecting track source";
         m_trackDao.disconnect(m_pTrackSource.data());
+        disconnect(m_pTrackSource.data());
         m_pTrackSource.reset();
     }
     return pWeakPtr;
@@ -4,6 +4,7 @@
 #include <QLineEdit>
 #include <QMenu>
 #include <QStandardPaths>
+#include <QtConcurrentRun>
 #include <algorithm>
 #include <vector>
 
@@ -21,6 +22,8 @@
 #include "moc_cratefeature.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
 #include "util/defs.h"
 #include "util/file.h"
 #include "widget/wlibrary.h"
@@ -41,6 +44,16 @@ QString formatLabel(
 const ConfigKey kConfigKeyLastImportExportCrateDirectoryKey(
         "[Library]", "LastImportExportCrateDirectory");
 
+// Executed in a worker thread
+QList<CrateSummary> readCrateSummaries(
+        const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+        const QSet<CrateId>& crateIds) {
+    const mixxx::DbConnectionPooler dbConnectionPooler(
+            pDbConnectionPool, mixxx::DbConnection::AccessMode::ReadOnly);
+    return CrateStorage::readCrateSummariesById(
+            mixxx::DbConnectionPooled(pDbConnectionPool), crateIds);
+}
+
 } // anonymous namespace
 
 using namespace mixxx::library::prefs;
@@ -50,8 +63,14 @@ CrateFeature::CrateFeature(Library* pLibrary,
         : BaseTrackSetFeature(pLibrary, pConfig, "CRATEHOME", QStringLiteral("crates")),
           m_lockedCrateIcon(":/images/library/ic_library_locked_tracklist.svg"),
           m_pTrackCollection(pLibrary->trackCollectionManager()->internalCollection()),
-          m_crateTableModel(this, pLibrary->trackCollectionManager()) {
+          m_pDbConnectionPool(pLibrary->dbConnectionPool()),
+          m_crateTableModel(this, pLibrary->trackCollectionManager()),
+          m_readingCrateSummaries(false) {
     initActions();
+    connect(&m_crateSummariesWatcher,
+            &QFutureWatcher<QList<CrateSummary>>::finished,
+            this,
+            &CrateFeature::slotCrateSummariesRead);
 
     // construct child model
     m_pSidebarModel->setRootItem(TreeItem::newRoot(this));
@@ -585,15 +604,34 @@ QModelIndex CrateFeature::rebuildChildModel(CrateId selectedCrateId) {
 }
 
 void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
-    const CrateStorage& crateStorage = m_pTrackCollection->crates();
-    for (const CrateId& crateId : updatedCrateIds) {
-        QModelIndex index = indexFromCrateId(crateId);
-        VERIFY_OR_DEBUG_ASSERT(index.isValid()) {
-            continue;
-        }
-        CrateSummary crateSummary;
-        VERIFY_OR_DEBUG_ASSERT(
-                crateStorage.readCrateSummaryById(crateId, &crateSummary)) {
+    m_crateSummaryIdsToRead.unite(updatedCrateIds);
+    if (m_readingCrateSummaries) {
+        // Continued when finished
+        return;
+    }
+    startReadingCrateSummaries();
+}
+
+void CrateFeature::startReadingCrateSummaries() {
+    DEBUG_ASSERT(!m_readingCrateSummaries);
+    if (m_crateSummaryIdsToRead.isEmpty()) {
+        return;
+    }
+    m_readingCrateSummaries = true;
+    m_crateSummariesWatcher.setFuture(QtConcurrent::run(
+            readCrateSummaries,
+            m_pDbConnectionPool,
+            std::move(m_crateSummaryIdsToRead)));
+    m_crateSummaryIdsToRead.clear();
+}
+
+void CrateFeature::slotCrateSummariesRead() {
+    m_readingCrateSummaries = false;
+    const QList<CrateSummary> crateSummaries = m_crateSummariesWatcher.result();
+    for (const auto& crateSummary : crateSummaries) {
+        // The crate might have been deleted in the meantime
+        QModelIndex index = indexFromCrateId(crateSummary.getId());
+        if (!index.isValid()) {
             continue;
         }
         updateTreeItemForCrateSummary(
@@ -606,6 +644,8 @@ void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
         // have been modified.
         slotTrackSelected(m_selectedTrackId);
     }
+
+    startReadingCrateSummaries();
 }
 
 CrateId CrateFeature::crateIdFromIndex(const QModelIndex& index) const {
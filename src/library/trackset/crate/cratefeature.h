@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QFutureWatcher>
 #include <QList>
 #include <QModelIndex>
 #include <QPointer>
@@ -8,9 +9,11 @@
 
 #include "library/trackset/basetracksetfeature.h"
 #include "library/trackset/crate/crate.h"
+#include "library/trackset/crate/cratesummary.h"
 #include "library/trackset/crate/cratetablemodel.h"
 #include "preferences/usersettings.h"
 #include "track/trackid.h"
+#include "util/db/dbconnectionpool.h"
 #include "util/parented_ptr.h"
 
 // forward declaration(s)
@@ -18,7 +21,6 @@ class Library;
 class WLibrarySidebar;
 class QAction;
 class QPoint;
-class CrateSummary;
 
 class CrateFeature : public BaseTrackSetFeature {
     Q_OBJECT
@@ -75,6 +77,7 @@ class CrateFeature : public BaseTrackSetFeature {
     void slotTrackSelected(TrackId trackId);
     void slotResetSelectedTrack();
     void slotUpdateCrateLabels(const QSet<CrateId>& updatedCrateIds);
+    void slotCrateSummariesRead();
 
   private:
     void initActions();
@@ -90,7 +93,12 @@ class CrateFeature : public BaseTrackSetFeature {
             const CrateSummary& crateSummary) const;
 
     QModelIndex rebuildChildModel(CrateId selectedCrateId = CrateId());
+    // Updates the labels asynchronously. The summaries are read in a
+    // worker thread, because calculating the totals may take a while
+    // for large crates and would otherwise block while the scanner or
+    // the analyzer are modifying the library.
     void updateChildModel(const QSet<CrateId>& updatedCrateIds);
+    void startReadingCrateSummaries();
 
     CrateId crateIdFromIndex(const QModelIndex& index) const;
     QModelIndex indexFromCrateId(CrateId crateId) const;
@@ -103,9 +111,15 @@ class CrateFeature : public BaseTrackSetFeature {
     const QIcon m_lockedCrateIcon;
 
     TrackCollection* const m_pTrackCollection;
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     CrateTableModel m_crateTableModel;
 
+    // At most one read is running at a time to apply the results in order
+    QFutureWatcher<QList<CrateSummary>> m_crateSummariesWatcher;
+    bool m_readingCrateSummaries;
+    QSet<CrateId> m_crateSummaryIdsToRead;
+
     // Stores the id of a crate in the sidebar that is adjacent to the crate(crateId).
     void storePrevSiblingCrateId(CrateId crateId);
     // Can be used to restore a similar selection after the sidebar model was rebuilt.
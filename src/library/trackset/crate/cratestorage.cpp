@@ -395,6 +395,37 @@ bool CrateStorage::readCrateSummaryById(
     return false;
 }
 
+//static
+QList<CrateSummary> CrateStorage::readCrateSummariesById(
+        const QSqlDatabase& database,
+        const QSet<CrateId>& ids) {
+    QList<CrateSummary> crateSummaries;
+    if (ids.isEmpty()) {
+        return crateSummaries;
+    }
+    QStringList joinedIds;
+    joinedIds.reserve(ids.size());
+    for (const auto& id : ids) {
+        joinedIds.append(id.toString());
+    }
+    FwdSqlQuery query(database,
+            QStringLiteral("%1 %2 WHERE %3.%4 IN (%5) GROUP BY %3.%4")
+                    .arg(kCrateSummaryViewSelect,
+                            kLibraryTracksJoin,
+                            CRATE_TABLE,
+                            CRATETABLE_ID,
+                            joinedIds.join(kSqlListSeparator)));
+    if (!query.execPrepared()) {
+        return crateSummaries;
+    }
+    CrateSummarySelectResult selectResult(std::move(query));
+    CrateSummary crateSummary;
+    while (selectResult.populateNext(&crateSummary)) {
+        crateSummaries.append(crateSummary);
+    }
+    return crateSummaries;
+}
+
 uint CrateStorage::countCrateTracks(CrateId crateId) const {
     FwdSqlQuery query(m_database,
             QStringLiteral("SELECT COUNT(*) FROM %1 WHERE %2=:crateId")
@@ -337,6 +337,14 @@ class CrateStorage : public virtual /*implements*/ SqlStorage {
     // Omit the pCrate parameter for checking if the corresponding crate exists.
     bool readCrateSummaryById(CrateId id, CrateSummary* pCrateSummary = nullptr) const;
 
+    // Same as readCrateSummaryById() for multiple crates, but without
+    // the temporary view that is only available for connected databases.
+    // Intended for worker threads that use a read-only connection.
+    // Crates that don't exist are omitted.
+    static QList<CrateSummary> readCrateSummariesById(
+            const QSqlDatabase& database,
+            const QSet<CrateId>& ids);
+
   private:
     void createViews();
 
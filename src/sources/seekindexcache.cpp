@@ -0,0 +1,191 @@
+#include "sources/seekindexcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("SeekIndexCache");
+
+// Bump the version when changing the file layout. Sidecar files with
+// a different version are ignored and replaced.
+constexpr quint32 kMagic = 0x4D585849; // "MXXI"
+constexpr quint32 kVersion = 1;
+
+constexpr QDataStream::Version kDataStreamVersion = QDataStream::Qt_5_12;
+
+const QString kFileSuffix = QStringLiteral(".idx");
+
+// Only written during startup before any audio source is opened
+QString s_dirPath;
+
+QString sidecarFilePath(
+        const QString& kind,
+        const QString& localFileName) {
+    DEBUG_ASSERT(!s_dirPath.isEmpty());
+    const QByteArray pathHash = QCryptographicHash::hash(
+            QFileInfo(localFileName).absoluteFilePath().toUtf8(),
+            QCryptographicHash::Sha1);
+    return QDir(s_dirPath).filePath(
+            QString::fromLatin1(pathHash.toHex()) +
+            QChar('.') + kind + kFileSuffix);
+}
+
+} // anonymous namespace
+
+//static
+void SeekIndexCache::setDirectory(const QString& dirPath, qint64 maxTotalBytes) {
+    if (!dirPath.isEmpty() && !QDir().mkpath(dirPath)) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << dirPath;
+        s_dirPath.clear();
+        return;
+    }
+    s_dirPath = dirPath;
+    if (isEnabled()) {
+        const int deletedCount = prune(maxTotalBytes);
+        if (deletedCount > 0) {
+            kLogger.info()
+                    << "Deleted"
+                    << deletedCount
+                    << "least recently used seek indexes";
+        }
+    }
+}
+
+//static
+bool SeekIndexCache::isEnabled() {
+    return !s_dirPath.isEmpty();
+}
+
+//static
+std::optional<QByteArray> SeekIndexCache::load(
+        const QString& kind,
+        const QString& localFileName) {
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+    const QFileInfo fileInfo(localFileName);
+    QFile sidecarFile(sidecarFilePath(kind, localFileName));
+    if (!sidecarFile.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    QDataStream in(&sidecarFile);
+    in.setVersion(kDataStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 fileSize = -1;
+    qint64 lastModifiedMillis = 0;
+    QByteArray compressedIndex;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        return std::nullopt;
+    }
+    in >> fileSize >> lastModifiedMillis >> compressedIndex;
+    if (in.status() != QDataStream::Ok) {
+        kLogger.warning()
+                << "Corrupt seek index"
+                << sidecarFile.fileName()
+                << "for"
+                << localFileName;
+        sidecarFile.remove();
+        return std::nullopt;
+    }
+    if (fileSize != fileInfo.size() ||
+            lastModifiedMillis != fileInfo.lastModified().toMSecsSinceEpoch()) {
+        kLogger.debug()
+                << "Outdated seek index for"
+                << localFileName;
+        sidecarFile.remove();
+        return std::nullopt;
+    }
+    const QByteArray index = qUncompress(compressedIndex);
+    if (index.isEmpty()) {
+        sidecarFile.remove();
+        return std::nullopt;
+    }
+    // The modification time of the sidecar file tracks the last use
+    // for pruning the least recently used indexes
+    sidecarFile.setFileTime(
+            QDateTime::currentDateTimeUtc(),
+            QFileDevice::FileModificationTime);
+    return index;
+}
+
+//static
+bool SeekIndexCache::save(
+        const QString& kind,
+        const QString& localFileName,
+        const QByteArray& index) {
+    if (!isEnabled()) {
+        return false;
+    }
+    const QFileInfo fileInfo(localFileName);
+    QSaveFile sidecarFile(sidecarFilePath(kind, localFileName));
+    if (!sidecarFile.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to open"
+                << sidecarFile.fileName()
+                << "for writing";
+        return false;
+    }
+    QDataStream out(&sidecarFile);
+    out.setVersion(kDataStreamVersion);
+    out << kMagic
+        << kVersion
+        << static_cast<qint64>(fileInfo.size())
+        << static_cast<qint64>(fileInfo.lastModified().toMSecsSinceEpoch())
+        << qCompress(index);
+    if (out.status() != QDataStream::Ok || !sidecarFile.commit()) {
+        kLogger.warning()
+                << "Failed to write seek index"
+                << sidecarFile.fileName();
+        return false;
+    }
+    return true;
+}
+
+//static
+int SeekIndexCache::prune(qint64 maxTotalBytes) {
+    if (!isEnabled()) {
+        return 0;
+    }
+    QDir dir(s_dirPath);
+    // Most recently used first
+    const QFileInfoList fileInfos = dir.entryInfoList(
+            QStringList{QChar('*') + kFileSuffix}, QDir::Files, QDir::Time);
+    qint64 totalBytes = 0;
+    int deletedCount = 0;
+    for (const auto& fileInfo : fileInfos) {
+        totalBytes += fileInfo.size();
+        if (totalBytes > maxTotalBytes && dir.remove(fileInfo.fileName())) {
+            ++deletedCount;
+        }
+    }
+    return deletedCount;
+}
+
+//static
+void SeekIndexCache::clear() {
+    if (!isEnabled()) {
+        return;
+    }
+    QDir dir(s_dirPath);
+    const QStringList fileNames = dir.entryList(
+            QStringList{QChar('*') + kFileSuffix}, QDir::Files);
+    for (const auto& fileName : fileNames) {
+        dir.remove(fileName);
+    }
+}
+
+} // namespace mixxx
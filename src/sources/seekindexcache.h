@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <optional>
+
+namespace mixxx {
+
+/// Persistent storage for seek indexes of audio files, e.g. the MP3
+/// frame positions that would otherwise need to be rebuilt by scanning
+/// the whole file each time it is opened.
+///
+/// Each index is stored in a separate sidecar file within a common
+/// cache directory. The sidecar files are named after a hash of the
+/// audio file's path. The size and the modification time of the audio
+/// file are stored alongside the index and are validated when loading
+/// it. An index that does not match the current file is ignored.
+///
+/// Indexes are neither loaded nor saved until a cache directory has
+/// been configured.
+///
+/// The total size of the cache directory is limited. Loading an index
+/// marks it as recently used and the least recently used indexes are
+/// deleted when exceeding the limit.
+class SeekIndexCache final {
+  public:
+    SeekIndexCache() = delete;
+
+    static constexpr qint64 kDefaultMaxTotalBytes = 32 * 1024 * 1024;
+
+    /// Set the directory for storing the sidecar files and prune it to
+    /// the given total size. Must be invoked once during startup, before
+    /// any audio sources are opened.
+    static void setDirectory(
+            const QString& dirPath,
+            qint64 maxTotalBytes = kDefaultMaxTotalBytes);
+
+    static bool isEnabled();
+
+    /// Load the index of the given kind, e.g. "mp3" or "ffmpeg", for
+    /// a local audio file.
+    static std::optional<QByteArray> load(
+            const QString& kind,
+            const QString& localFileName);
+
+    /// Store or replace the index of the given kind for a local audio
+    /// file. Failures are logged and otherwise ignored.
+    static bool save(
+            const QString& kind,
+            const QString& localFileName,
+            const QByteArray& index);
+
+    /// Delete the least recently used indexes until the total size of
+    /// all stored indexes does not exceed the given limit. Returns the
+    /// number of deleted indexes.
+    static int prune(qint64 maxTotalBytes);
+
+    /// Delete all stored indexes.
+    static void clear();
+};
+
+} // namespace mixxx
@@ -9,8 +9,13 @@ extern "C" {
 
 } // extern "C"
 
+#include <QDataStream>
+#include <QVector>
+
+#include "sources/seekindexcache.h"
 #include "util/logger.h"
 #include "util/sample.h"
+#include "util/timer.h"
 
 #if !defined(VERBOSE_DEBUG_LOG)
 #define VERBOSE_DEBUG_LOG false
@@ -53,8 +58,24 @@ constexpr int64_t kavStreamDecoderFrameDelayAAC = 2112;
 
 constexpr SINT kMaxSamplesPerMP3Frame = 1152;
 
+// The minimum distance between subsequent entries of the packet index.
+// A finer resolution is not needed, because decoding needs to start
+// m_seekPrerollFrameCount frames before the actual target position
+// anyway.
+constexpr SINT kPacketIndexMinFrameDistance = 4096;
+
+constexpr QDataStream::Version kPacketIndexDataStreamVersion = QDataStream::Qt_5_12;
+
 const Logger kLogger("SoundSourceFFmpeg");
 
+int getStreamIndexEntriesCount(AVStream* pavStream) {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100) // FFmpeg 4.4
+    return avformat_index_get_entries_count(pavStream);
+#else
+    return pavStream->nb_index_entries;
+#endif
+}
+
 int64_t getStreamStartTime(const AVStream& avStream) {
     auto start_time = avStream.start_time;
     if (start_time == AV_NOPTS_VALUE) {
@@ -486,8 +507,10 @@ SoundSourceFFmpeg::SoundSourceFFmpeg(const QUrl& url)
           m_pavStream(nullptr),
           m_pavDecodedFrame(nullptr),
           m_seekPrerollFrameCount(0),
+          m_packetIndexState(PacketIndexState::Disabled),
           m_pavPacket(av_packet_alloc()),
           m_pavResampledFrame(nullptr),
+          m_resampleIntoOutputBuffer(true),
           m_avutilVersion(avutil_version()) {
     DEBUG_ASSERT(m_pavPacket);
 #if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(57, 28, 100) // FFmpeg 5.1
@@ -771,9 +794,164 @@ SoundSource::OpenResult SoundSourceFFmpeg::tryOpen(
     kLogger.debug() << "Frame buffer capacity:" << m_frameBuffer.capacity();
 #endif
 
+    initPacketIndex();
+
     return OpenResult::Succeeded;
 }
 
+QString SoundSourceFFmpeg::packetIndexKind() const {
+    DEBUG_ASSERT(m_pavStream);
+    // Files with multiple audio streams, e.g. stem files, need a
+    // separate index for each stream
+    return QStringLiteral("ffmpeg-%1").arg(m_pavStream->index);
+}
+
+void SoundSourceFFmpeg::initPacketIndex() {
+    m_packetIndex.clear();
+    m_packetIndexState = PacketIndexState::Disabled;
+    if (!SeekIndexCache::isEnabled()) {
+        return;
+    }
+    // The positions in PCM streams are calculated directly
+    if (av_get_exact_bits_per_sample(m_pavStream->codecpar->codec_id) > 0) {
+        return;
+    }
+    // Containers like MP4 already provide a complete index
+    const auto expectedEntryCount = frameLength() / kPacketIndexMinFrameDistance;
+    if (getStreamIndexEntriesCount(m_pavStream) >= expectedEntryCount) {
+        return;
+    }
+    const auto index = SeekIndexCache::load(packetIndexKind(), getLocalFileName());
+    if (index) {
+        restorePacketIndex(*index);
+    }
+    if (m_packetIndexState == PacketIndexState::Disabled) {
+        m_packetIndexState = PacketIndexState::Recording;
+    }
+}
+
+void SoundSourceFFmpeg::restorePacketIndex(const QByteArray& index) {
+    QDataStream in(index);
+    in.setVersion(kPacketIndexDataStreamVersion);
+    qint32 codecId = AV_CODEC_ID_NONE;
+    qint32 timeBaseNum = 0;
+    qint32 timeBaseDen = 0;
+    QVector<qint64> posDeltas;
+    QVector<qint64> ptsDeltas;
+    in >> codecId >> timeBaseNum >> timeBaseDen >> posDeltas >> ptsDeltas;
+    if (in.status() != QDataStream::Ok ||
+            codecId != m_pavStream->codecpar->codec_id ||
+            timeBaseNum != m_pavStream->time_base.num ||
+            timeBaseDen != m_pavStream->time_base.den ||
+            posDeltas.size() != ptsDeltas.size()) {
+        kLogger.warning()
+                << "Discarding invalid packet index of"
+                << getLocalFileName();
+        return;
+    }
+    int64_t pos = 0;
+    int64_t pts = 0;
+    for (int i = 0; i < posDeltas.size(); ++i) {
+        pos += posDeltas[i];
+        pts += ptsDeltas[i];
+        const int av_add_index_entry_result = av_add_index_entry(
+                m_pavStream,
+                pos,
+                pts,
+                /*size*/ 0,
+                /*distance*/ 0,
+                AVINDEX_KEYFRAME);
+        if (av_add_index_entry_result < 0) {
+            kLogger.warning().noquote()
+                    << "av_add_index_entry() failed:"
+                    << formatErrorString(av_add_index_entry_result);
+            return;
+        }
+    }
+    kLogger.debug()
+            << "Restored packet index with"
+            << posDeltas.size()
+            << "entries for"
+            << getLocalFileName();
+    m_packetIndexState = PacketIndexState::Complete;
+}
+
+void SoundSourceFFmpeg::updatePacketIndex(
+        const AVPacket& avPacket,
+        SINT packetFrameIndex) {
+    switch (m_packetIndexState) {
+    case PacketIndexState::Disabled:
+    case PacketIndexState::Paused:
+    case PacketIndexState::Complete:
+        return;
+    case PacketIndexState::Resync:
+        if (!avPacket.data || avPacket.pts == AV_NOPTS_VALUE) {
+            return;
+        }
+        // Recording continues only if no gaps would occur
+        if (m_packetIndex.empty()
+                        ? packetFrameIndex > frameIndexMin()
+                        : avPacket.pts > m_packetIndex.back().pts) {
+            m_packetIndexState = PacketIndexState::Paused;
+            return;
+        }
+        m_packetIndexState = PacketIndexState::Recording;
+        break;
+    case PacketIndexState::Recording:
+        break;
+    }
+    DEBUG_ASSERT(m_packetIndexState == PacketIndexState::Recording);
+    if (!avPacket.data) {
+        // The end of the stream has been reached
+        m_packetIndexState = PacketIndexState::Complete;
+        savePacketIndex();
+        m_packetIndex.clear();
+        return;
+    }
+    if (avPacket.pts == AV_NOPTS_VALUE || avPacket.pos < 0) {
+        // The index would be incomplete
+        m_packetIndexState = PacketIndexState::Disabled;
+        m_packetIndex.clear();
+        return;
+    }
+    if (!m_packetIndex.empty()) {
+        if (avPacket.pts <= m_packetIndex.back().pts) {
+            // Already recorded before seeking back
+            return;
+        }
+        const SINT prevFrameIndex = convertStreamTimeToFrameIndex(
+                *m_pavStream, m_packetIndex.back().pts);
+        if (packetFrameIndex - prevFrameIndex < kPacketIndexMinFrameDistance) {
+            return;
+        }
+    }
+    m_packetIndex.push_back(PacketIndexEntry{avPacket.pos, avPacket.pts});
+}
+
+void SoundSourceFFmpeg::savePacketIndex() const {
+    QVector<qint64> posDeltas;
+    QVector<qint64> ptsDeltas;
+    posDeltas.reserve(static_cast<int>(m_packetIndex.size()));
+    ptsDeltas.reserve(static_cast<int>(m_packetIndex.size()));
+    int64_t prevPos = 0;
+    int64_t prevPts = 0;
+    for (const auto& entry : m_packetIndex) {
+        posDeltas.append(entry.pos - prevPos);
+        ptsDeltas.append(entry.pts - prevPts);
+        prevPos = entry.pos;
+        prevPts = entry.pts;
+    }
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    out.setVersion(kPacketIndexDataStreamVersion);
+    out << static_cast<qint32>(m_pavStream->codecpar->codec_id)
+        << static_cast<qint32>(m_pavStream->time_base.num)
+        << static_cast<qint32>(m_pavStream->time_base.den)
+        << posDeltas
+        << ptsDeltas;
+    SeekIndexCache::save(packetIndexKind(), getLocalFileName(), index);
+}
+
 bool SoundSourceFFmpeg::initResampling(
         audio::ChannelCount* pResampledChannelCount,
         audio::SampleRate* pResampledSampleRate) {
@@ -914,6 +1092,8 @@ void SoundSourceFFmpeg::close() {
     m_pavCodecContext.close();
     m_pavInputFormatContext.close();
     m_pavStream = nullptr;
+    m_packetIndex.clear();
+    m_packetIndexState = PacketIndexState::Disabled;
 }
 
 namespace {
@@ -999,11 +1179,18 @@ bool SoundSourceFFmpeg::adjustCurrentPosition(SINT startIndex) {
     // Seek to new position
     const int64_t seekTimestamp =
             convertFrameIndexToStreamTime(*m_pavStream, seekIndex);
-    int av_seek_frame_result = av_seek_frame(
-            m_pavInputFormatContext,
-            m_pavStream->index,
-            seekTimestamp,
-            AVSEEK_FLAG_BACKWARD);
+    int av_seek_frame_result;
+    {
+        // The seek cost depends on both the container format and the
+        // availability of an index, see also initPacketIndex().
+        ScopedTimer t(QStringLiteral("SoundSourceFFmpeg::seek %1"),
+                QLatin1String(m_pavInputFormatContext->iformat->name));
+        av_seek_frame_result = av_seek_frame(
+                m_pavInputFormatContext,
+                m_pavStream->index,
+                seekTimestamp,
+                AVSEEK_FLAG_BACKWARD);
+    }
     if (av_seek_frame_result < 0) {
         // Unrecoverable seek error: Invalidate the current position and abort
         kLogger.warning().noquote()
@@ -1016,6 +1203,11 @@ bool SoundSourceFFmpeg::adjustCurrentPosition(SINT startIndex) {
     // from the stream
     m_frameBuffer.reset();
 
+    if (m_packetIndexState == PacketIndexState::Recording ||
+            m_packetIndexState == PacketIndexState::Paused) {
+        m_packetIndexState = PacketIndexState::Resync;
+    }
+
     return true;
 }
 
@@ -1035,6 +1227,7 @@ bool SoundSourceFFmpeg::consumeNextAVPacket(
             m_frameBuffer.invalidate();
             return false;
         }
+        updatePacketIndex(*m_pavPacket, packetFrameIndex);
         *ppavNextPacket = m_pavPacket;
     }
     auto* pavNextPacket = *ppavNextPacket;
@@ -1120,6 +1313,28 @@ const CSAMPLE* SoundSourceFFmpeg::resampleDecodedAVFrame() {
     }
 }
 
+bool SoundSourceFFmpeg::resampleDecodedAVFrameInto(CSAMPLE* pSampleBuffer) {
+    DEBUG_ASSERT(m_pSwrContext);
+    DEBUG_ASSERT(pSampleBuffer);
+    // The sample rate is never converted, i.e. the resampling context
+    // doesn't buffer any samples and all samples are converted at once.
+    auto* pOutputData = reinterpret_cast<uint8_t*>(pSampleBuffer);
+    const auto swr_convert_result = swr_convert(
+            m_pSwrContext,
+            &pOutputData,
+            m_pavDecodedFrame->nb_samples,
+            const_cast<const uint8_t**>(m_pavDecodedFrame->extended_data),
+            m_pavDecodedFrame->nb_samples);
+    if (swr_convert_result < 0) {
+        kLogger.warning().noquote()
+                << "swr_convert() failed:"
+                << formatErrorString(swr_convert_result);
+        return false;
+    }
+    DEBUG_ASSERT(swr_convert_result == m_pavDecodedFrame->nb_samples);
+    return true;
+}
+
 ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesClamped(
         const WritableSampleFrames& originalWritableSampleFrames) {
     DEBUG_ASSERT(m_frameBuffer.signalInfo() == getSignalInfo());
@@ -1286,6 +1501,33 @@ ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesClamped(
                     << "decodedFrameRange" << decodedFrameRange;
 #endif
 
+            // Decoded frames that fit into the remaining output buffer
+            // are resampled directly into it if neither any lead-in nor
+            // lead-out frames need to be cut off. This avoids copying
+            // all samples a second time.
+            if (m_resampleIntoOutputBuffer &&
+                    m_pSwrContext &&
+                    pOutputSampleBuffer &&
+                    decodedFrameRange.isSubrangeOf(frameIndexRange()) &&
+                    decodedFrameRange.start() == writableFrameRange.start() &&
+                    decodedFrameRange.end() <= writableFrameRange.end()) {
+                DEBUG_ASSERT(m_frameBuffer.isEmpty());
+                if (!resampleDecodedAVFrameInto(pOutputSampleBuffer)) {
+                    // Invalidate current position and abort reading after unrecoverable error
+                    m_frameBuffer.invalidate();
+                    // Housekeeping before aborting to avoid memory leaks
+                    av_frame_unref(m_pavDecodedFrame);
+                    break;
+                }
+                pOutputSampleBuffer += getSignalInfo().frames2samples(
+                        decodedFrameRange.length());
+                writableFrameRange.shrinkFront(decodedFrameRange.length());
+                // Continue buffering at the end of the decoded frame
+                m_frameBuffer.reset(decodedFrameRange.end());
+                av_frame_unref(m_pavDecodedFrame);
+                continue;
+            }
+
             const CSAMPLE* pDecodedSampleData = resampleDecodedAVFrame();
             if (!pDecodedSampleData) {
                 // Invalidate current position and abort reading after unrecoverable error
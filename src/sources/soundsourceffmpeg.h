@@ -8,6 +8,8 @@ extern "C" {
 
 } // extern "C"
 
+#include <vector>
+
 #include "sources/readaheadframebuffer.h"
 #include "sources/soundsourceprovider.h"
 
@@ -32,6 +34,9 @@ class SoundSourceFFmpeg : public SoundSource {
 
   private:
     const CSAMPLE* resampleDecodedAVFrame();
+    // Resample the decoded frame directly into the given output buffer,
+    // bypassing both m_pavResampledFrame and m_frameBuffer
+    bool resampleDecodedAVFrameInto(CSAMPLE* pSampleBuffer);
 
     // Seek to the requested start index (if needed) or return false
     // upon seek errors.
@@ -41,6 +46,30 @@ class SoundSourceFFmpeg : public SoundSource {
     bool consumeNextAVPacket(
             AVPacket** ppavNextPacket);
 
+    // The packet index contains the positions of packets within the
+    // file. It is recorded while reading the stream sequentially and
+    // stored persistently in the SeekIndexCache when reaching the end
+    // of the stream. When the file is opened again the index entries
+    // are added to the stream to speed up subsequent seek operations
+    // if the container itself provides no or only a sparse index.
+    struct PacketIndexEntry {
+        int64_t pos;
+        int64_t pts;
+    };
+    enum class PacketIndexState {
+        Disabled,
+        Recording,
+        // Continue recording after seeking back into the recorded range
+        Resync,
+        Paused,
+        Complete,
+    };
+    void initPacketIndex();
+    void restorePacketIndex(const QByteArray& index);
+    void updatePacketIndex(const AVPacket& avPacket, SINT packetFrameIndex);
+    void savePacketIndex() const;
+    QString packetIndexKind() const;
+
     // Takes ownership of an input format context and ensures that
     // the corresponding AVFormatContext is closed, either explicitly
     // or implicitly by the destructor. The wrapper can only be
@@ -157,6 +186,9 @@ class SoundSourceFFmpeg : public SoundSource {
     FrameCount m_seekPrerollFrameCount;
     ReadAheadFrameBuffer m_frameBuffer;
 
+    std::vector<PacketIndexEntry> m_packetIndex;
+    PacketIndexState m_packetIndexState;
+
     // FFmpeg static constants
     static constexpr AVSampleFormat s_avSampleFormat = AV_SAMPLE_FMT_FLT;
 
@@ -212,8 +244,13 @@ class SoundSourceFFmpeg : public SoundSource {
     AVPacket* m_pavPacket;
 
     AVFrame* m_pavResampledFrame;
+    // Decoded frames that fit into the output buffer are resampled
+    // directly into it. Only disabled for comparing both paths in tests.
+    bool m_resampleIntoOutputBuffer;
 
     const unsigned int m_avutilVersion;
+
+    friend class SoundSourceFFmpegTest;
 };
 
 class SoundSourceProviderFFmpeg : public SoundSourceProvider {
@@ -1,6 +1,10 @@
 #include "sources/soundsourcemp3.h"
 #include "sources/mp3decoding.h"
 
+#include <QDataStream>
+#include <QVector>
+
+#include "sources/seekindexcache.h"
 #include "util/logger.h"
 #include "util/math.h"
 
@@ -17,6 +21,10 @@ constexpr SINT kChannelCountMax = 2;
 
 constexpr SINT kMaxBytesPerMp3Frame = 1441;
 
+const QString kSeekIndexKind = QStringLiteral("mp3");
+
+constexpr QDataStream::Version kSeekIndexDataStreamVersion = QDataStream::Qt_5_12;
+
 // mp3 supports 9 different sample rates
 constexpr int kSampleRateCount = 9;
 
@@ -247,6 +255,36 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     DEBUG_ASSERT(m_seekFrameList.empty());
     m_avgSeekFrameCount = 0;
     m_curFrameIndex = 0;
+
+    // Scanning the whole file for building the seek frame list is
+    // expensive, especially for large files on network drives. The
+    // list is stored persistently and only rebuilt if the file has
+    // been modified.
+    const auto seekIndex = SeekIndexCache::load(kSeekIndexKind, m_file.fileName());
+    if (!seekIndex || !restoreSeekFrameList(*seekIndex)) {
+        const OpenResult scanResult = scanSeekFrameList();
+        if (scanResult != OpenResult::Succeeded) {
+            return scanResult;
+        }
+        SeekIndexCache::save(kSeekIndexKind, m_file.fileName(), serializeSeekFrameList());
+    }
+    DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
+
+    // Restart decoding at the beginning of the audio stream
+    restartDecoding(m_seekFrameList.front());
+
+    if (m_curFrameIndex != frameIndexMin()) {
+        kLogger.warning() << "Failed to start decoding:" << m_file.fileName();
+        // Abort
+        return OpenResult::Failed;
+    }
+
+    return OpenResult::Succeeded;
+}
+
+SoundSource::OpenResult SoundSourceMp3::scanSeekFrameList() {
+    DEBUG_ASSERT(m_seekFrameList.empty());
+    DEBUG_ASSERT(m_curFrameIndex == 0);
     int headerPerSampleRate[kSampleRateCount];
     for (int i = 0; i < kSampleRateCount; ++i) {
         headerPerSampleRate[i] = 0;
@@ -475,16 +513,107 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     addSeekFrame(m_curFrameIndex, nullptr);
     DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
 
-    // Restart decoding at the beginning of the audio stream
-    restartDecoding(m_seekFrameList.front());
+    return OpenResult::Succeeded;
+}
 
-    if (m_curFrameIndex != frameIndexMin()) {
-        kLogger.warning() << "Failed to start decoding:" << m_file.fileName();
-        // Abort
-        return OpenResult::Failed;
+QByteArray SoundSourceMp3::serializeSeekFrameList() const {
+    DEBUG_ASSERT(!m_seekFrameList.empty());
+    DEBUG_ASSERT(!m_seekFrameList.back().pInputData);
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    out.setVersion(kSeekIndexDataStreamVersion);
+    out << static_cast<quint32>(getSignalInfo().getChannelCount())
+        << static_cast<quint32>(getSignalInfo().getSampleRate())
+        << static_cast<quint32>(getBitrate())
+        << static_cast<qint64>(frameLength());
+    // Store the offsets as differences to the preceding seek frame,
+    // which are almost constant and compress well. The terminating
+    // seek frame and a last frame that has been copied into the
+    // leftover buffer don't reference the mapped file and are omitted.
+    const unsigned char* pPrevInputData = m_pFileData;
+    SINT prevFrameIndex = 0;
+    QVector<quint32> frameIndexDeltas;
+    QVector<quint32> inputDataDeltas;
+    frameIndexDeltas.reserve(static_cast<int>(m_seekFrameList.size()));
+    inputDataDeltas.reserve(static_cast<int>(m_seekFrameList.size()));
+    for (const auto& seekFrame : m_seekFrameList) {
+        if (seekFrame.pInputData < m_pFileData ||
+                seekFrame.pInputData >= m_pFileData + m_fileSize) {
+            continue;
+        }
+        frameIndexDeltas.append(static_cast<quint32>(seekFrame.frameIndex - prevFrameIndex));
+        inputDataDeltas.append(static_cast<quint32>(seekFrame.pInputData - pPrevInputData));
+        prevFrameIndex = seekFrame.frameIndex;
+        pPrevInputData = seekFrame.pInputData;
     }
+    out << frameIndexDeltas << inputDataDeltas;
+    return index;
+}
 
-    return OpenResult::Succeeded;
+bool SoundSourceMp3::restoreSeekFrameList(const QByteArray& index) {
+    DEBUG_ASSERT(m_seekFrameList.empty());
+    QDataStream in(index);
+    in.setVersion(kSeekIndexDataStreamVersion);
+    quint32 channelCount = 0;
+    quint32 sampleRate = 0;
+    quint32 bitrate = 0;
+    qint64 frameCount = 0;
+    QVector<quint32> frameIndexDeltas;
+    QVector<quint32> inputDataDeltas;
+    in >> channelCount >> sampleRate >> bitrate >> frameCount >>
+            frameIndexDeltas >> inputDataDeltas;
+    if (in.status() != QDataStream::Ok ||
+            frameIndexDeltas.isEmpty() ||
+            frameIndexDeltas.size() != inputDataDeltas.size() ||
+            !audio::ChannelCount(channelCount).isValid() ||
+            static_cast<SINT>(channelCount) > kChannelCountMax ||
+            getIndexBySampleRate(audio::SampleRate(sampleRate)) >= kSampleRateCount) {
+        kLogger.warning()
+                << "Discarding invalid seek index of"
+                << m_file.fileName();
+        return false;
+    }
+
+    // Validate all positions before modifying any members
+    SINT frameIndex = 0;
+    quint64 fileOffset = 0;
+    for (int i = 0; i < frameIndexDeltas.size(); ++i) {
+        frameIndex += frameIndexDeltas[i];
+        fileOffset += inputDataDeltas[i];
+        if ((i > 0 && (frameIndexDeltas[i] == 0 || inputDataDeltas[i] == 0)) ||
+                fileOffset >= m_fileSize ||
+                frameIndex >= frameCount) {
+            kLogger.warning()
+                    << "Discarding inconsistent seek index of"
+                    << m_file.fileName();
+            return false;
+        }
+    }
+    if (frameIndexDeltas.front() != 0) {
+        // The first seek frame must start at the beginning of the stream
+        return false;
+    }
+
+    m_seekFrameList.reserve(frameIndexDeltas.size() + 1);
+    frameIndex = 0;
+    const unsigned char* pInputData = m_pFileData;
+    for (int i = 0; i < frameIndexDeltas.size(); ++i) {
+        frameIndex += frameIndexDeltas[i];
+        pInputData += inputDataDeltas[i];
+        addSeekFrame(frameIndex, pInputData);
+    }
+    initChannelCountOnce(audio::ChannelCount(channelCount));
+    initSampleRateOnce(audio::SampleRate(sampleRate));
+    initFrameIndexRangeOnce(IndexRange::forward(0, frameCount));
+    if (audio::Bitrate(bitrate).isValid()) {
+        initBitrateOnce(audio::Bitrate(bitrate));
+    }
+    m_avgSeekFrameCount = frameLength() / static_cast<SINT>(m_seekFrameList.size());
+    m_curFrameIndex = frameCount;
+
+    // Terminate m_seekFrameList
+    addSeekFrame(m_curFrameIndex, nullptr);
+    return true;
 }
 
 void SoundSourceMp3::close() {
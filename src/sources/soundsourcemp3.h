@@ -53,6 +53,15 @@ class SoundSourceMp3 final : public SoundSource {
 
     void addSeekFrame(SINT frameIndex, const unsigned char* pInputData);
 
+    /// Decodes all frame headers of the file for building the seek frame list
+    /// and initializes the audio properties.
+    OpenResult scanSeekFrameList();
+
+    /// Serialization of the seek frame list and the audio properties
+    /// for storing them persistently, see SeekIndexCache.
+    QByteArray serializeSeekFrameList() const;
+    bool restoreSeekFrameList(const QByteArray& index);
+
     /** Returns the position in m_seekFrameList of the requested frame index. */
     SINT findSeekFrameIndex(SINT frameIndex) const;
 
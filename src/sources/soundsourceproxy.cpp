@@ -4,6 +4,7 @@
 #include <QMimeType>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include <tuple>
 
 #include "sources/audiosourcetrackproxy.h"
 
@@ -591,6 +592,30 @@ SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
     }
 }
 
+//static
+SoundSourceProxy::PreparedTrackImport SoundSourceProxy::prepareTrackImportFromFile(
+        const mixxx::FileAccess& trackFileAccess) {
+    PreparedTrackImport preparedImport;
+    QImage coverImage;
+    // Resetting missing tags is irrelevant for a new track without
+    // any metadata.
+    std::tie(preparedImport.importResult, preparedImport.sourceSynchronizedAt) =
+            importTrackMetadataAndCoverImageFromFile(
+                    trackFileAccess,
+                    &preparedImport.trackMetadata,
+                    &coverImage,
+                    false);
+    if (preparedImport.importResult == mixxx::MetadataSource::ImportResult::Succeeded) {
+        // Guessing might need to look for cover files in the directory.
+        // Only the hash and the location of the image are kept.
+        preparedImport.coverInfo = CoverInfoGuesser().guessCoverInfo(
+                trackFileAccess.info(),
+                preparedImport.trackMetadata.getAlbumInfo().getTitle(),
+                coverImage);
+    }
+    return preparedImport;
+}
+
 std::pair<mixxx::MetadataSource::ImportResult, QDateTime>
 SoundSourceProxy::importTrackMetadataAndCoverImage(
         mixxx::TrackMetadata* pTrackMetadata,
@@ -636,7 +661,8 @@ inline bool shouldImportSeratoTagsFromSource(
 
 SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromSource(
         UpdateTrackFromSourceMode mode,
-        const SyncTrackMetadataParams& syncParams) {
+        const SyncTrackMetadataParams& syncParams,
+        const PreparedTrackImport* pPreparedImport) {
     DEBUG_ASSERT(m_pTrack);
 
     if (getUrl().isEmpty()) {
@@ -713,13 +739,26 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
         }
     }
 
+    // A prepared import only replaces the initial import into
+    // an empty track object.
+    if (pPreparedImport &&
+            (sourceSyncStatus != mixxx::TrackRecord::SourceSyncStatus::Void ||
+                    !updateMetadataFromSource)) {
+        pPreparedImport = nullptr;
+    }
+
     // Parse the tags stored in the audio file and the date and time when the
     // file has been last modified to detect future changes of the tags.
-    auto [metadataImportResult, sourceSynchronizedAt] =
-            importTrackMetadataAndCoverImage(
-                    &trackMetadata,
-                    pCoverImg,
-                    syncParams.resetMissingTagMetadataOnImport);
+    auto [metadataImportResult, sourceSynchronizedAt] = pPreparedImport
+            ? std::make_pair(pPreparedImport->importResult,
+                      pPreparedImport->sourceSynchronizedAt)
+            : importTrackMetadataAndCoverImage(
+                      &trackMetadata,
+                      pCoverImg,
+                      syncParams.resetMissingTagMetadataOnImport);
+    if (pPreparedImport) {
+        trackMetadata = pPreparedImport->trackMetadata;
+    }
     VERIFY_OR_DEBUG_ASSERT(!sourceSynchronizedAt.isValid() ||
             sourceSynchronizedAt.timeSpec() == Qt::UTC) {
         qWarning() << "Converting source synchronization time to UTC:" << sourceSynchronizedAt;
@@ -869,11 +908,12 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     if (pCoverImg) {
         // If the pointer is not null then the cover art should be guessed
-        auto coverInfo =
-                CoverInfoGuesser().guessCoverInfo(
-                        m_pTrack->getFileInfo(),
-                        m_pTrack->getAlbum(),
-                        *pCoverImg);
+        auto coverInfo = pPreparedImport
+                ? pPreparedImport->coverInfo
+                : CoverInfoGuesser().guessCoverInfo(
+                          m_pTrack->getFileInfo(),
+                          m_pTrack->getAlbum(),
+                          *pCoverImg);
         DEBUG_ASSERT(coverInfo.source == CoverInfo::GUESSED);
         m_pTrack->setCoverInfo(coverInfo);
     }
@@ -4,6 +4,7 @@
 
 #include <QMimeType>
 
+#include "library/coverart.h"
 #include "sources/soundsourceproviderregistry.h"
 #include "track/track_decl.h"
 
@@ -107,6 +108,28 @@ class SoundSourceProxy {
             QImage* pCoverImage,
             bool resetMissingTagMetadata);
 
+    /// Track metadata and guessed cover art of a new track that have
+    /// been imported from the file in advance, e.g. concurrently on a
+    /// worker thread while scanning the library.
+    struct PreparedTrackImport {
+        mixxx::MetadataSource::ImportResult importResult =
+                mixxx::MetadataSource::ImportResult::Unavailable;
+        QDateTime sourceSynchronizedAt;
+        mixxx::TrackMetadata trackMetadata;
+        CoverInfoRelative coverInfo;
+    };
+
+    /// Import the track metadata and guess the cover art of a file
+    /// that is not yet in the library without holding on to the
+    /// cover image.
+    ///
+    /// The result can be passed to updateTrackFromSource() instead
+    /// of parsing the file again. Like
+    /// importTrackMetadataAndCoverImageFromFile() this function is
+    /// thread-safe and can be invoked from any thread.
+    static PreparedTrackImport prepareTrackImportFromFile(
+            const mixxx::FileAccess& trackFileAccess);
+
     /// Import both track metadata and/or the cover image of the
     /// captured track object from the corresponding file.
     ///
@@ -174,10 +197,14 @@ class SoundSourceProxy {
     /// properly. The application log will contain warning messages for a detailed
     /// analysis in case unexpected behavior has been reported.
     ///
+    /// The optional prepared import is only used instead of reading the
+    /// file if the track has never been synchronized with its source.
+    ///
     /// Returns true if the track has been modified and false otherwise.
     UpdateTrackFromSourceResult updateTrackFromSource(
             UpdateTrackFromSourceMode mode,
-            const SyncTrackMetadataParams& syncParams);
+            const SyncTrackMetadataParams& syncParams,
+            const PreparedTrackImport* pPreparedImport = nullptr);
 
     /// Opening the audio source through the proxy will update the
     /// audio properties of the corresponding track object. Returns
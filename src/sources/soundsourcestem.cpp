@@ -1,5 +1,9 @@
 #include "sources/soundsourcestem.h"
 
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
 #include "sources/readaheadframebuffer.h"
 
 extern "C" {
@@ -29,6 +33,14 @@ constexpr int kRequiredStreamCount = kNumStreams - 1; // Stem count doesn't incl
 
 const Logger kLogger("SoundSourceSTEM");
 
+// The stems are decoded in a dedicated thread pool to prevent that
+// chunk requests from the engine are blocked by long running tasks
+// in the global thread pool, e.g. the library scanner.
+QThreadPool* stemDecodingThreadPool() {
+    static QThreadPool s_threadPool;
+    return &s_threadPool;
+}
+
 } // anonymous namespace
 
 const QString SoundSourceProviderSTEM::kDisplayName = QStringLiteral("STEM with FFmpeg");
@@ -448,6 +460,21 @@ void SoundSourceSTEM::close() {
     }
 }
 
+void SoundSourceSTEM::readStemSampleFrames(
+        std::size_t streamIdx,
+        IndexRange frameIndexRange) {
+    SampleBuffer& stemBuffer = m_stemBuffers[streamIdx];
+    const SINT stemSampleLength = m_pStereoStreams[streamIdx]->getSignalInfo().frames2samples(
+            frameIndexRange.length());
+    DEBUG_ASSERT(stemSampleLength <= stemBuffer.size());
+    m_pStereoStreams[streamIdx]->readSampleFrames(
+            WritableSampleFrames(
+                    frameIndexRange,
+                    SampleBuffer::WritableSlice(
+                            stemBuffer.data(),
+                            stemSampleLength)));
+}
+
 ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         const WritableSampleFrames& globalSampleFrames) {
     VERIFY_OR_DEBUG_ASSERT(m_requestedChannelCount.isValid()) {
@@ -463,13 +490,6 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
     SINT stemSampleLength = m_pStereoStreams.front()->getSignalInfo().frames2samples(
             globalSampleFrames.frameLength());
 
-    // The same buffer is reused between requests tp prevent reallocation, but
-    // it will be reallocated if a larger chunk is requested and will keep the
-    // new maximum size
-    if (stemSampleLength > m_buffer.size()) {
-        m_buffer = SampleBuffer(stemSampleLength);
-    }
-
     ReadableSampleFrames read(globalSampleFrames.frameIndexRange(),
             SampleBuffer::ReadableSlice(
                     globalSampleFrames.writableData(),
@@ -489,14 +509,41 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         return read;
     }
 
-    for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
-        WritableSampleFrames currentStemFrame = WritableSampleFrames(
-                globalSampleFrames.frameIndexRange(),
-                SampleBuffer::WritableSlice(
-                        m_buffer.data(),
-                        stemSampleLength));
-        m_pStereoStreams[streamIdx]->readSampleFrames(currentStemFrame);
+    // The same buffers are reused between requests to prevent reallocation,
+    // but they will be reallocated if a larger chunk is requested and will
+    // keep the new maximum size
+    if (m_stemBuffers.size() != stemCount ||
+            stemSampleLength > m_stemBuffers.front().size()) {
+        m_stemBuffers.clear();
+        m_stemBuffers.reserve(stemCount);
+        for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
+            m_stemBuffers.emplace_back(stemSampleLength);
+        }
+    }
+
+    // Each stem source owns its own demuxer and decoder context and
+    // all stems could be decoded independently. All but the first stem
+    // are decoded by the thread pool while the calling thread decodes
+    // the first stem. Waiting for a task that has not been started yet
+    // will run it on the calling thread, i.e. decoding will continue
+    // even if all pooled threads are busy with other stem decks.
+    const IndexRange frameIndexRange = globalSampleFrames.frameIndexRange();
+    std::vector<QFuture<void>> decodingTasks;
+    decodingTasks.reserve(stemCount - 1);
+    for (std::size_t streamIdx = 1; streamIdx < stemCount; streamIdx++) {
+        decodingTasks.push_back(QtConcurrent::run(
+                stemDecodingThreadPool(),
+                [this, streamIdx, frameIndexRange] {
+                    readStemSampleFrames(streamIdx, frameIndexRange);
+                }));
+    }
+    readStemSampleFrames(0, frameIndexRange);
+    for (auto& decodingTask : decodingTasks) {
+        decodingTask.waitForFinished();
+    }
 
+    for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
+        const SampleBuffer& stemBuffer = m_stemBuffers[streamIdx];
         // TODO(XXX): currently, stem samples are interleaved and packed
         // next to each other as such:
         //    1L1R1L1R1L1R...2L2R2L2R2L2R2L2R......3L3R3L3R3L3R3L3R......4L4R4L4R4L4R4L4R....
@@ -505,15 +552,12 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         if (m_requestedChannelCount != mixxx::audio::ChannelCount::stereo()) {
             // Change the sample layout to interleave all channels together
             for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * stemCount * i + 2 * streamIdx] = m_buffer[2 * i];
-                pBuffer[2 * stemCount * i + 2 * streamIdx + 1] = m_buffer[2 * i + 1];
+                pBuffer[2 * stemCount * i + 2 * streamIdx] = stemBuffer[2 * i];
+                pBuffer[2 * stemCount * i + 2 * streamIdx + 1] = stemBuffer[2 * i + 1];
             }
         } else {
             // Change the sample layout to mix all channels together
-            for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * i] += m_buffer[2 * i];
-                pBuffer[2 * i + 1] += m_buffer[2 * i + 1];
-            }
+            SampleUtil::add(pBuffer, stemBuffer.data(), stemSampleLength);
         }
     }
 
@@ -33,9 +33,16 @@ class SoundSourceSTEM : public SoundSource {
     void close() override;
 
   private:
+    // Decodes the given range of a single stem into its buffer
+    void readStemSampleFrames(
+            std::size_t streamIdx,
+            IndexRange frameIndexRange);
+
     // Contains each stem source, or the main mix if opened in stereo mode
     std::vector<std::unique_ptr<SoundSourceSingleSTEM>> m_pStereoStreams;
-    SampleBuffer m_buffer;
+    // One decoding buffer per stem source that allows to decode all
+    // stems concurrently
+    std::vector<SampleBuffer> m_stemBuffers;
 
     mixxx::audio::ChannelCount m_requestedChannelCount;
 
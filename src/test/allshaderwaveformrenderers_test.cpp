@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "track/track.h"
+#include "waveform/isynctimeprovider.h"
+#include "waveform/renderers/allshader/waveformrendererfiltered.h"
+#include "waveform/renderers/allshader/waveformrendererhsv.h"
+#include "waveform/renderers/allshader/waveformrendererrgb.h"
+#include "waveform/renderers/allshader/waveformrenderersimple.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/visualplayposition.h"
+#include "waveform/waveform.h"
+
+// Measures the CPU stage of the allshader signal renderers, i.e. the
+// generation of the geometry in preprocess(). No OpenGL context is
+// needed, because the vertices are only uploaded when rendering.
+
+namespace {
+
+const QString kGroup = QStringLiteral("[Channel1]");
+
+constexpr int kSampleRate = 44100;
+// Like the main waveform of AnalyzerWaveform
+constexpr int kVisualSampleRate = 441;
+// 5 minutes
+constexpr int kTrackSeconds = 300;
+constexpr int kWidth = 1920;
+constexpr int kHeight = 200;
+constexpr int kFramesPerSecond = 60;
+
+// Every frame is rendered at the next vsync in 60 Hz
+class FixedVSyncTimeProvider : public VSyncTimeProvider {
+  public:
+    std::chrono::microseconds fromTimerToNextSync(const PerformanceTimer&) override {
+        return std::chrono::microseconds(0);
+    }
+    std::chrono::microseconds getSyncInterval() const override {
+        return std::chrono::microseconds(1000000 / kFramesPerSecond);
+    }
+};
+
+// Fills the waveform with pseudo-random values
+WaveformPointer createWaveform() {
+    auto pWaveform = WaveformPointer::create(kSampleRate,
+            kSampleRate * kTrackSeconds,
+            kVisualSampleRate,
+            -1,
+            0);
+    WaveformData* pData = pWaveform->data();
+    unsigned int value = 1;
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        value = value * 1103515245 + 12345;
+        pData[i].filtered.all = static_cast<unsigned char>(value >> 8);
+        pData[i].filtered.low = static_cast<unsigned char>(value >> 12);
+        pData[i].filtered.mid = static_cast<unsigned char>(value >> 16);
+        pData[i].filtered.high = static_cast<unsigned char>(value >> 20);
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    return pWaveform;
+}
+
+// A playing deck with the controls that are read by the renderers
+class SyntheticDeck {
+  public:
+    explicit SyntheticDeck(double zoom)
+            : m_widgetRenderer(kGroup),
+              m_playPos(0.0) {
+        const double trackSamples = 2.0 * kSampleRate * kTrackSeconds;
+        addControl(kGroup, QStringLiteral("track_samples"), trackSamples);
+        addControl(kGroup, QStringLiteral("rate_ratio"), 1.0);
+        addControl(kGroup, QStringLiteral("total_gain"), 1.0);
+        addControl(kGroup, QStringLiteral("filterWaveformEnable"), 0.0);
+        const QString effectGroup =
+                QStringLiteral("[EqualizerRack1_%1_Effect1]").arg(kGroup);
+        for (const auto& item : {QStringLiteral("parameter1"),
+                     QStringLiteral("parameter2"),
+                     QStringLiteral("parameter3"),
+                     QStringLiteral("button_parameter1"),
+                     QStringLiteral("button_parameter2"),
+                     QStringLiteral("button_parameter3")}) {
+            addControl(effectGroup, item, 0.0);
+        }
+
+        TrackPointer pTrack = Track::newTemporary();
+        pTrack->setWaveform(createWaveform());
+        m_widgetRenderer.init();
+        m_widgetRenderer.resizeRenderer(kWidth, kHeight, 1.0f);
+        m_widgetRenderer.setZoom(zoom);
+        m_widgetRenderer.setTrack(pTrack);
+        m_pVisualPlayPosition = VisualPlayPosition::getVisualPlayPosition(kGroup);
+    }
+
+    WaveformWidgetRenderer* widgetRenderer() {
+        return &m_widgetRenderer;
+    }
+
+    // Advances the play position by one display frame, like the engine
+    // does while playing
+    void nextFrame() {
+        m_playPos += 1.0 / (kTrackSeconds * kFramesPerSecond);
+        if (m_playPos >= 1.0) {
+            m_playPos = 0.0;
+        }
+        m_pVisualPlayPosition->set(m_playPos,
+                1.0,
+                0.0,
+                m_playPos,
+                0.0,
+                SlipModeState::Disabled,
+                false,
+                false,
+                false,
+                0.0,
+                0.0,
+                kTrackSeconds,
+                0.0);
+        m_widgetRenderer.onPreRender(&m_vsyncTimeProvider);
+    }
+
+  private:
+    void addControl(const QString& group, const QString& item, double value) {
+        auto pControl = std::make_unique<ControlObject>(ConfigKey(group, item));
+        pControl->set(value);
+        m_controls.push_back(std::move(pControl));
+    }
+
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+    WaveformWidgetRenderer m_widgetRenderer;
+    QSharedPointer<VisualPlayPosition> m_pVisualPlayPosition;
+    FixedVSyncTimeProvider m_vsyncTimeProvider;
+    double m_playPos;
+};
+
+template<typename T_Renderer, typename... Args>
+void preprocessFrames(benchmark::State& state, Args&&... args) {
+    SyntheticDeck deck(static_cast<double>(state.range(0)));
+    T_Renderer renderer(deck.widgetRenderer(), std::forward<Args>(args)...);
+    renderer.init();
+
+    for (auto _ : state) {
+        deck.nextFrame();
+        renderer.preprocess();
+        benchmark::DoNotOptimize(renderer.geometry().vertexData());
+    }
+    state.counters["vertices"] = renderer.geometry().vertexCount();
+    state.counters["frames/s"] = benchmark::Counter(
+            static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+void BM_PreprocessRGB(benchmark::State& state) {
+    preprocessFrames<allshader::WaveformRendererRGB>(state);
+}
+
+void BM_PreprocessFiltered(benchmark::State& state) {
+    preprocessFrames<allshader::WaveformRendererFiltered>(state, false);
+}
+
+void BM_PreprocessStacked(benchmark::State& state) {
+    preprocessFrames<allshader::WaveformRendererFiltered>(state, true);
+}
+
+void BM_PreprocessHSV(benchmark::State& state) {
+    preprocessFrames<allshader::WaveformRendererHSV>(state);
+}
+
+void BM_PreprocessSimple(benchmark::State& state) {
+    preprocessFrames<allshader::WaveformRendererSimple>(state);
+}
+
+// The minimum, default and maximum zoom
+BENCHMARK(BM_PreprocessRGB)->Arg(1)->Arg(3)->Arg(10);
+BENCHMARK(BM_PreprocessFiltered)->Arg(1)->Arg(3)->Arg(10);
+BENCHMARK(BM_PreprocessStacked)->Arg(1)->Arg(3)->Arg(10);
+BENCHMARK(BM_PreprocessHSV)->Arg(1)->Arg(3)->Arg(10);
+BENCHMARK(BM_PreprocessSimple)->Arg(1)->Arg(3)->Arg(10);
+
+} // namespace
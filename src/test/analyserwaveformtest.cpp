@@ -9,6 +9,7 @@
 #include "library/dao/analysisdao.h"
 #include "test/mixxxtest.h"
 #include "track/track.h"
+#include "util/sample.h"
 
 namespace {
 
@@ -130,4 +131,43 @@ TEST_F(AnalyzerWaveformTest, canary) {
     EXPECT_DOUBLE_EQ(pWaveformSummary->getAudioVisualRatio(), 1.0);
 }
 
+// The stereo mix that is shared with the other analyzers must result in
+// the same waveform as mixing down the stems in the analyzer.
+TEST_F(AnalyzerWaveformTest, stemsWithSharedStereoMix) {
+    const auto channelCount = mixxx::audio::ChannelCount::stem();
+    const SINT frameCount = kBigBufSize / kChannelCount;
+    std::vector<CSAMPLE> stems(frameCount * channelCount);
+    for (std::size_t i = 0; i < stems.size(); ++i) {
+        stems[i] = static_cast<CSAMPLE>((i * 7919) % 1000) / 1000.0f - 0.5f;
+    }
+    std::vector<CSAMPLE> stereoMix(kBigBufSize);
+    SampleUtil::mixMultichannelToStereo(stereoMix.data(), stems.data(), frameCount, channelCount);
+
+    m_aw.initialize(AnalyzerTrack(m_pTrack),
+            m_pTrack->getSampleRate(),
+            channelCount,
+            frameCount);
+    EXPECT_TRUE(m_aw.processSamples(stems.data(), static_cast<SINT>(stems.size())));
+    m_aw.storeResults(m_pTrack);
+    m_aw.cleanup();
+
+    TrackPointer pTrack = Track::newTemporary();
+    AnalyzerWaveform analyzer(config(), QSqlDatabase());
+    analyzer.initialize(AnalyzerTrack(pTrack),
+            m_pTrack->getSampleRate(),
+            channelCount,
+            frameCount);
+    EXPECT_TRUE(analyzer.processStemSamples(
+            stems.data(), static_cast<SINT>(stems.size()), stereoMix.data()));
+    analyzer.storeResults(pTrack);
+    analyzer.cleanup();
+
+    ASSERT_NE(m_pTrack->getWaveform(), nullptr);
+    ASSERT_NE(pTrack->getWaveform(), nullptr);
+    EXPECT_TRUE(pTrack->getWaveform()->hasStem());
+    EXPECT_EQ(m_pTrack->getWaveform()->toByteArray(), pTrack->getWaveform()->toByteArray());
+    EXPECT_EQ(m_pTrack->getWaveformSummary()->toByteArray(),
+            pTrack->getWaveformSummary()->toByteArray());
+}
+
 } // namespace
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "analyzer/analyzerthread.h"
+#include "library/dao/analysisdao.h"
+#include "test/librarytest.h"
+#include "track/beats.h"
+#include "track/keyfactory.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr mixxx::cache_key_t kAudioDigest = 0x0123456789abcdefULL;
+
+const auto kSampleRate = mixxx::audio::SampleRate(44100);
+
+} // namespace
+
+class AnalysisDaoTest : public LibraryTest {
+  protected:
+    AnalysisDao& analysisDao() const {
+        return internalCollection()->getAnalysisDAO();
+    }
+
+    TrackId addTrack(const QString& fileName) const {
+        const mixxx::FileInfo fileInfo(QDir(QDir::tempPath()), fileName);
+        return internalCollection()->addTrack(
+                Track::newTemporary(mixxx::FileAccess(fileInfo)), false);
+    }
+
+    void setBeats(TrackId trackId, const mixxx::BeatsPointer& pBeats) const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral(
+                "UPDATE library SET beats_version=:version,"
+                "beats_sub_version=:subVersion,beats=:beats WHERE id=:id"));
+        query.bindValue(":version", pBeats->getVersion());
+        query.bindValue(":subVersion", pBeats->getSubVersion());
+        query.bindValue(":beats", pBeats->toByteArray());
+        query.bindValue(":id", trackId.toVariant());
+        ASSERT_TRUE(query.exec());
+    }
+
+    void saveWaveform(TrackId trackId, const QByteArray& data) const {
+        AnalysisDao::AnalysisInfo analysis;
+        analysis.trackId = trackId;
+        analysis.type = AnalysisDao::TYPE_WAVEFORM;
+        analysis.description = QStringLiteral("Waveform");
+        analysis.version = QStringLiteral("Test");
+        analysis.data = data;
+        ASSERT_TRUE(analysisDao().saveAnalysis(&analysis));
+    }
+};
+
+TEST_F(AnalysisDaoTest, findResultsOfAnalyzedDuplicate) {
+    const TrackId analyzedId = addTrack(QStringLiteral("analyzed.mp3"));
+    const TrackId waveformId = addTrack(QStringLiteral("waveform.mp3"));
+    const TrackId unanalyzedId = addTrack(QStringLiteral("unanalyzed.mp3"));
+    const TrackId newId = addTrack(QStringLiteral("new.mp3"));
+
+    const auto pBeats = mixxx::Beats::fromConstTempo(
+            kSampleRate, mixxx::audio::kStartFramePos, mixxx::Bpm(120));
+    setBeats(analyzedId, pBeats);
+    for (const auto& trackId : {analyzedId, unanalyzedId}) {
+        ASSERT_TRUE(analysisDao().saveAudioDigest(trackId, kAudioDigest));
+    }
+    EXPECT_EQ(kAudioDigest, analysisDao().getAudioDigest(analyzedId));
+    EXPECT_FALSE(mixxx::isValidCacheKey(analysisDao().getAudioDigest(newId)));
+
+    // The most recently added duplicate has no results
+    auto results = analysisDao().findTrackAnalysisResultsByAudioDigest(kAudioDigest, newId);
+    ASSERT_TRUE(results.has_value());
+    EXPECT_EQ(analyzedId, results->trackId);
+    EXPECT_EQ(pBeats->getVersion(), results->beatsVersion);
+    EXPECT_EQ(pBeats->toByteArray(), results->beatsBlob);
+
+    // Stored waveforms are results, too
+    saveWaveform(waveformId, QByteArrayLiteral("waveform"));
+    ASSERT_TRUE(analysisDao().saveAudioDigest(waveformId, kAudioDigest));
+    results = analysisDao().findTrackAnalysisResultsByAudioDigest(kAudioDigest, newId);
+    ASSERT_TRUE(results.has_value());
+    EXPECT_EQ(waveformId, results->trackId);
+
+    // The track itself is excluded
+    results = analysisDao().findTrackAnalysisResultsByAudioDigest(kAudioDigest, waveformId);
+    ASSERT_TRUE(results.has_value());
+    EXPECT_EQ(analyzedId, results->trackId);
+
+    EXPECT_FALSE(analysisDao()
+                    .findTrackAnalysisResultsByAudioDigest(kAudioDigest + 1, newId)
+                    .has_value());
+}
+
+TEST_F(AnalysisDaoTest, copyAnalyses) {
+    const TrackId sourceId = addTrack(QStringLiteral("source.mp3"));
+    const TrackId targetId = addTrack(QStringLiteral("target.mp3"));
+    const QByteArray data = QByteArrayLiteral("waveform data");
+    saveWaveform(sourceId, data);
+
+    EXPECT_EQ(1, analysisDao().copyAnalyses(sourceId, targetId));
+    const auto analyses = analysisDao().getAnalysesForTrack(targetId);
+    ASSERT_EQ(1, analyses.size());
+    EXPECT_EQ(AnalysisDao::TYPE_WAVEFORM, analyses.first().type);
+    EXPECT_EQ(data, analyses.first().data);
+
+    // Existing analyses are never overwritten
+    EXPECT_EQ(0, analysisDao().copyAnalyses(sourceId, targetId));
+    EXPECT_EQ(1, analysisDao().getAnalysesForTrack(targetId).size());
+}
+
+TEST_F(AnalysisDaoTest, restoreMissingResults) {
+    const auto pBeats = mixxx::Beats::fromConstTempo(
+            kSampleRate, mixxx::audio::kStartFramePos, mixxx::Bpm(120));
+    const Keys keys = KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::A_MINOR,
+            mixxx::track::io::key::ANALYZER);
+    AnalysisDao::TrackAnalysisResults results;
+    results.beatsVersion = pBeats->getVersion();
+    results.beatsSubVersion = pBeats->getSubVersion();
+    results.beatsBlob = pBeats->toByteArray();
+    results.keysVersion = keys.getVersion();
+    results.keysSubVersion = keys.getSubVersion();
+    results.keysBlob = keys.toByteArray();
+    results.replayGainRatio = 0.5;
+    results.replayGainPeak = 0.9;
+
+    auto pTrack = Track::newTemporary();
+    pTrack->setAudioProperties(
+            mixxx::audio::ChannelCount(2),
+            kSampleRate,
+            mixxx::audio::Bitrate(),
+            mixxx::Duration::fromSeconds(180));
+    AnalyzerThread::restoreTrackAnalysisResults(pTrack.get(), kSampleRate, results);
+    ASSERT_TRUE(pTrack->getBeats());
+    EXPECT_EQ(pBeats->toByteArray(), pTrack->getBeats()->toByteArray());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pTrack->getKeys().getGlobalKey());
+    EXPECT_DOUBLE_EQ(0.5, pTrack->getReplayGain().getRatio());
+
+    // Existing results are kept
+    const auto pOtherBeats = mixxx::Beats::fromConstTempo(
+            kSampleRate, mixxx::audio::kStartFramePos, mixxx::Bpm(90));
+    auto pAnalyzedTrack = Track::newTemporary();
+    pAnalyzedTrack->setAudioProperties(
+            mixxx::audio::ChannelCount(2),
+            kSampleRate,
+            mixxx::audio::Bitrate(),
+            mixxx::Duration::fromSeconds(180));
+    ASSERT_TRUE(pAnalyzedTrack->trySetBeats(pOtherBeats));
+    pAnalyzedTrack->setReplayGain(mixxx::ReplayGain(0.25, 0.5));
+    AnalyzerThread::restoreTrackAnalysisResults(pAnalyzedTrack.get(), kSampleRate, results);
+    EXPECT_EQ(pOtherBeats->toByteArray(), pAnalyzedTrack->getBeats()->toByteArray());
+    EXPECT_DOUBLE_EQ(0.25, pAnalyzedTrack->getReplayGain().getRatio());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pAnalyzedTrack->getKeys().getGlobalKey());
+}
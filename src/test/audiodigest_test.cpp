@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "analyzer/audiodigest.h"
+#include "analyzer/constants.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+class AudioDigestTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    AudioDigestTest()
+            : m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk) {
+    }
+
+    mixxx::cache_key_t calculateAudioDigest(const QString& filePath) {
+        auto pTrack = Track::newTemporary(filePath);
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::kAnalysisChannels);
+        const auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(openParams);
+        if (!pAudioSource) {
+            return mixxx::invalidCacheKey();
+        }
+        return mixxx::calculateAudioDigest(pAudioSource, &m_sampleBuffer);
+    }
+
+    QString getTestFilePath(const QString& fileName) const {
+        return getTestDir().filePath(QStringLiteral("id3-test-data/") + fileName);
+    }
+
+  private:
+    mixxx::SampleBuffer m_sampleBuffer;
+};
+
+TEST_F(AudioDigestTest, stableForSameFile) {
+    const QString filePath = getTestFilePath(QStringLiteral("cover-test.wav"));
+    const auto digest = calculateAudioDigest(filePath);
+    EXPECT_TRUE(mixxx::isValidCacheKey(digest));
+    EXPECT_EQ(digest, calculateAudioDigest(filePath));
+}
+
+TEST_F(AudioDigestTest, independentOfFileLocation) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString filePath = getTestFilePath(QStringLiteral("cover-test.ogg"));
+    const QString copiedFilePath = tempDir.filePath(QStringLiteral("moved.ogg"));
+    ASSERT_TRUE(QFile::copy(filePath, copiedFilePath));
+
+    const auto digest = calculateAudioDigest(filePath);
+    EXPECT_TRUE(mixxx::isValidCacheKey(digest));
+    EXPECT_EQ(digest, calculateAudioDigest(copiedFilePath));
+}
+
+TEST_F(AudioDigestTest, differentForDifferentAudio) {
+    const auto wavDigest = calculateAudioDigest(
+            getTestFilePath(QStringLiteral("cover-test.wav")));
+    const auto oggDigest = calculateAudioDigest(
+            getTestFilePath(QStringLiteral("cover-test.ogg")));
+    EXPECT_TRUE(mixxx::isValidCacheKey(wavDigest));
+    EXPECT_TRUE(mixxx::isValidCacheKey(oggDigest));
+    // Lossy encoding alters the decoded signal
+    EXPECT_NE(wavDigest, oggDigest);
+}
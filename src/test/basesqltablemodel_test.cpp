@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+
+#include "library/dao/playlistdao.h"
+#include "library/dao/trackschema.h"
+#include "library/playlisttablemodel.h"
+#include "test/librarytest.h"
+#include "util/db/sqltransaction.h"
+
+namespace {
+
+// A history playlist with every track played twice
+constexpr int kNumTracks = 25000;
+constexpr int kNumPlaylistTracks = 2 * kNumTracks;
+
+// The number of rows that is initially visible
+constexpr int kNumVisibleRows = 50;
+
+} // anonymous namespace
+
+class BaseSqlTableModelTest : public LibraryTest {
+  protected:
+    int createPlaylist() {
+        const QSqlDatabase database = dbConnection();
+        const int playlistId = internalCollection()->getPlaylistDAO().createPlaylist(
+                QStringLiteral("History"), PlaylistDAO::PLHT_SET_LOG);
+        EXPECT_NE(kInvalidPlaylistId, playlistId);
+
+        SqlTransaction transaction(database);
+        QSqlQuery trackInsert(database);
+        trackInsert.prepare(QStringLiteral(
+                "INSERT INTO library (id,mixxx_deleted) VALUES (:id,0)"));
+        for (int id = 1; id <= kNumTracks; ++id) {
+            trackInsert.bindValue(QStringLiteral(":id"), id);
+            EXPECT_TRUE(trackInsert.exec());
+        }
+        QSqlQuery playlistTrackInsert(database);
+        playlistTrackInsert.prepare(QStringLiteral(
+                "INSERT INTO PlaylistTracks "
+                "(playlist_id,track_id,position,pl_datetime_added) "
+                "VALUES (:playlistId,:trackId,:position,:added)"));
+        for (int position = 1; position <= kNumPlaylistTracks; ++position) {
+            playlistTrackInsert.bindValue(QStringLiteral(":playlistId"), playlistId);
+            playlistTrackInsert.bindValue(QStringLiteral(":trackId"),
+                    trackIdAtPosition(position).toVariant());
+            playlistTrackInsert.bindValue(QStringLiteral(":position"), position);
+            playlistTrackInsert.bindValue(QStringLiteral(":added"),
+                    QDateTime::fromSecsSinceEpoch(position));
+            EXPECT_TRUE(playlistTrackInsert.exec());
+        }
+        transaction.commit();
+        return playlistId;
+    }
+
+    static TrackId trackIdAtPosition(int position) {
+        return TrackId(QVariant((position - 1) % kNumTracks + 1));
+    }
+
+    static int numRowPages(const BaseSqlTableModel& model) {
+        return static_cast<int>(model.m_rowPages.size());
+    }
+
+    static QVariant rawValue(const BaseSqlTableModel& model, int row, int column) {
+        return model.rawValue(model.index(row, column));
+    }
+
+    static void expectRow(const PlaylistTableModel& model, int row) {
+        const int position = row + 1;
+        EXPECT_EQ(trackIdAtPosition(position),
+                model.getTrackId(model.index(row, 0)));
+        const int positionColumn =
+                model.fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+        EXPECT_EQ(position,
+                rawValue(model, row, positionColumn).toInt());
+        const int addedColumn =
+                model.fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_DATETIMEADDED);
+        EXPECT_EQ(position,
+                rawValue(model, row, addedColumn)
+                        .toDateTime()
+                        .toSecsSinceEpoch());
+    }
+};
+
+TEST_F(BaseSqlTableModelTest, FetchRowPagesLazily) {
+    const int playlistId = createPlaylist();
+
+    PlaylistTableModel model(nullptr, trackCollectionManager(), "mixxx.db.model.test");
+
+    // Time to first paint: Select all rows and populate the visible rows
+    QElapsedTimer timer;
+    timer.start();
+    model.selectPlaylist(playlistId);
+    model.select();
+    ASSERT_EQ(kNumPlaylistTracks, model.rowCount());
+    for (int row = 0; row < kNumVisibleRows; ++row) {
+        expectRow(model, row);
+    }
+    const qint64 firstPaintMillis = timer.elapsed();
+
+    // Only the visible page has been fetched, the next one is
+    // prefetched from the event loop.
+    EXPECT_EQ(1, numRowPages(model));
+    QCoreApplication::processEvents();
+    EXPECT_EQ(2, numRowPages(model));
+
+    // Jump to the end and scroll up
+    for (int row = kNumPlaylistTracks - 1; row >= kNumPlaylistTracks - 1000; --row) {
+        expectRow(model, row);
+    }
+    QCoreApplication::processEvents();
+    // The first two pages and the pages around the last 1000 rows
+    EXPECT_GE(8, numRowPages(model));
+
+    // Scroll through the whole playlist. The number of cached pages
+    // is bounded.
+    for (int row = 0; row < kNumPlaylistTracks; row += 97) {
+        expectRow(model, row);
+    }
+    QCoreApplication::processEvents();
+    EXPECT_GE(32, numRowPages(model));
+
+    qInfo() << "Selected" << model.rowCount() << "rows and fetched"
+            << kNumVisibleRows << "rows in" << firstPaintMillis << "ms";
+}
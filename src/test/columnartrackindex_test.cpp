@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "control/controlobject.h"
+#include "library/basetrackcache.h"
+#include "library/columnartrackindex.h"
+#include "library/dao/trackschema.h"
+#include "library/library_prefs.h"
+#include "library/searchquery.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QStringList kColumns = {
+        LIBRARYTABLE_ID,
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_BPM,
+        TRACKLOCATIONSTABLE_LOCATION,
+};
+
+class ColumnarTrackIndexTest : public MixxxTest {
+  protected:
+    ColumnarTrackIndexTest()
+            : m_keyNotation(mixxx::library::prefs::kKeyNotationConfigKey),
+              m_columnCache(kColumns),
+              m_index(m_columnCache, m_collator) {
+        addTrack(1, "Björk", "Army of Me", 95.0, "/music/bjork.mp3");
+        addTrack(2, "ABBA", "Waterloo", 147.0, "/music/abba.flac");
+        addTrack(3, QVariant(), "Untitled", QVariant(), "/music/unknown.ogg");
+        addTrack(4, "abba", "Mamma Mia", 137.0, "/music/mamma.mp3");
+    }
+
+    void addTrack(int id,
+            const QVariant& artist,
+            const QVariant& title,
+            const QVariant& bpm,
+            const QString& location) {
+        m_index.updateRow(TrackId(QVariant(id)), {id, artist, title, bpm, location});
+    }
+
+    int sortColumn(const QString& columnName) const {
+        return m_columnCache.fieldIndex(columnName);
+    }
+
+    std::vector<int> trackIdsOfMatches(const QueryNode& query) const {
+        std::vector<uint8_t> matches;
+        EXPECT_TRUE(query.matchIndexed(m_index, &matches));
+        std::vector<int> trackIds;
+        for (int row = 0; row < m_index.rowCount(); ++row) {
+            if (matches[row] == ColumnarTrackIndex::kRowTrue) {
+                trackIds.push_back(m_index.trackIdAt(row).toVariant().toInt());
+            }
+        }
+        std::sort(trackIds.begin(), trackIds.end());
+        return trackIds;
+    }
+
+    std::vector<int> sortedTrackIds(const QList<SortColumn>& sortColumns) const {
+        std::vector<int> rows(m_index.rowCount());
+        std::iota(rows.begin(), rows.end(), 0);
+        EXPECT_TRUE(m_index.canSort(sortColumns, 0));
+        m_index.sortRows(&rows, sortColumns, 0);
+        std::vector<int> trackIds;
+        for (const int row : rows) {
+            trackIds.push_back(m_index.trackIdAt(row).toVariant().toInt());
+        }
+        return trackIds;
+    }
+
+    ControlObject m_keyNotation;
+    const ColumnCache m_columnCache;
+    const mixxx::StringCollator m_collator;
+    ColumnarTrackIndex m_index;
+};
+
+TEST_F(ColumnarTrackIndexTest, MatchContains) {
+    // Diacritics and case are ignored like by LIKE in the database
+    EXPECT_EQ(std::vector<int>({1}),
+            trackIdsOfMatches(TextFilterNode(
+                    QSqlDatabase(), {LIBRARYTABLE_ARTIST}, "bjork")));
+    EXPECT_EQ(std::vector<int>({2, 4}),
+            trackIdsOfMatches(TextFilterNode(
+                    QSqlDatabase(), {LIBRARYTABLE_ARTIST}, "Abb")));
+    EXPECT_EQ(std::vector<int>({2, 4}),
+            trackIdsOfMatches(TextFilterNode(
+                    QSqlDatabase(),
+                    {LIBRARYTABLE_TITLE, TRACKLOCATIONSTABLE_LOCATION},
+                    "a.")));
+}
+
+TEST_F(ColumnarTrackIndexTest, MatchEquals) {
+    EXPECT_EQ(std::vector<int>({2, 4}),
+            trackIdsOfMatches(TextFilterNode(QSqlDatabase(),
+                    {LIBRARYTABLE_ARTIST},
+                    "abba",
+                    StringMatch::Equals)));
+    EXPECT_EQ(std::vector<int>({}),
+            trackIdsOfMatches(TextFilterNode(QSqlDatabase(),
+                    {LIBRARYTABLE_ARTIST},
+                    "abb",
+                    StringMatch::Equals)));
+}
+
+TEST_F(ColumnarTrackIndexTest, MatchNullOrEmpty) {
+    EXPECT_EQ(std::vector<int>({3}),
+            trackIdsOfMatches(NullOrEmptyTextFilterNode(
+                    QSqlDatabase(), {LIBRARYTABLE_ARTIST})));
+}
+
+TEST_F(ColumnarTrackIndexTest, MatchComposite) {
+    AndNode query;
+    query.addNode(std::make_unique<TextFilterNode>(
+            QSqlDatabase(), QStringList{LIBRARYTABLE_ARTIST}, "abba"));
+    query.addNode(std::make_unique<NotNode>(std::make_unique<TextFilterNode>(
+            QSqlDatabase(), QStringList{LIBRARYTABLE_TITLE}, "water")));
+    EXPECT_EQ(std::vector<int>({4}), trackIdsOfMatches(query));
+}
+
+TEST_F(ColumnarTrackIndexTest, MatchNullLikeSql) {
+    // NOT (artist LIKE '%abba%') is NULL for a NULL artist
+    EXPECT_EQ(std::vector<int>({1}),
+            trackIdsOfMatches(NotNode(std::make_unique<TextFilterNode>(
+                    QSqlDatabase(), QStringList{LIBRARYTABLE_ARTIST}, "abba"))));
+    EXPECT_EQ(std::vector<int>({2, 4}),
+            trackIdsOfMatches(NotNode(std::make_unique<NotNode>(
+                    std::make_unique<TextFilterNode>(QSqlDatabase(),
+                            QStringList{LIBRARYTABLE_ARTIST},
+                            "abba")))));
+    // NULL OR FALSE is NULL
+    EXPECT_EQ(std::vector<int>({2, 4}),
+            trackIdsOfMatches(NotNode(std::make_unique<TextFilterNode>(QSqlDatabase(),
+                    QStringList{LIBRARYTABLE_ARTIST, LIBRARYTABLE_TITLE},
+                    "me"))));
+    // NULL AND FALSE is FALSE
+    auto pQuery = std::make_unique<AndNode>();
+    pQuery->addNode(std::make_unique<TextFilterNode>(
+            QSqlDatabase(), QStringList{LIBRARYTABLE_ARTIST}, "abba"));
+    pQuery->addNode(std::make_unique<TextFilterNode>(
+            QSqlDatabase(), QStringList{LIBRARYTABLE_TITLE}, "xyz"));
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}),
+            trackIdsOfMatches(NotNode(std::move(pQuery))));
+}
+
+TEST_F(ColumnarTrackIndexTest, UnindexedColumnFallsBack) {
+    std::vector<uint8_t> matches;
+    EXPECT_FALSE(TextFilterNode(QSqlDatabase(), {LIBRARYTABLE_KEY}, "A")
+                         .matchIndexed(m_index, &matches));
+    EXPECT_FALSE(m_index.canSort(
+            {SortColumn(m_columnCache.fieldIndex(LIBRARYTABLE_ID),
+                    Qt::AscendingOrder)},
+            0));
+}
+
+TEST_F(ColumnarTrackIndexTest, Sort) {
+    // NULL first, then case insensitive and by track id
+    EXPECT_EQ(std::vector<int>({3, 2, 4, 1}),
+            sortedTrackIds({SortColumn(sortColumn(LIBRARYTABLE_ARTIST),
+                    Qt::AscendingOrder)}));
+    EXPECT_EQ(std::vector<int>({1, 4, 2, 3}),
+            sortedTrackIds({
+                    SortColumn(sortColumn(LIBRARYTABLE_ARTIST), Qt::DescendingOrder),
+                    SortColumn(sortColumn(LIBRARYTABLE_TITLE), Qt::AscendingOrder),
+            }));
+    EXPECT_EQ(std::vector<int>({2, 4, 1, 3}),
+            sortedTrackIds({SortColumn(sortColumn(LIBRARYTABLE_BPM),
+                    Qt::DescendingOrder)}));
+}
+
+TEST_F(ColumnarTrackIndexTest, SortTiesByTrackId) {
+    std::vector<int> rows = {m_index.rowOf(TrackId(QVariant(4))),
+            m_index.rowOf(TrackId(QVariant(2)))};
+    m_index.sortRows(&rows,
+            {SortColumn(sortColumn(LIBRARYTABLE_ARTIST), Qt::AscendingOrder)},
+            0);
+    EXPECT_EQ(std::vector<int>({m_index.rowOf(TrackId(QVariant(2))),
+                      m_index.rowOf(TrackId(QVariant(4)))}),
+            rows);
+}
+
+TEST_F(ColumnarTrackIndexTest, UpdateAndRemove) {
+    addTrack(2, "Zappa", "Peaches en Regalia", 120.0, "/music/zappa.mp3");
+    m_index.removeRow(TrackId(QVariant(1)));
+    EXPECT_EQ(3, m_index.rowCount());
+    EXPECT_EQ(-1, m_index.rowOf(TrackId(QVariant(1))));
+    EXPECT_EQ(std::vector<int>({3, 4, 2}),
+            sortedTrackIds({SortColumn(sortColumn(LIBRARYTABLE_ARTIST),
+                    Qt::AscendingOrder)}));
+    EXPECT_EQ(std::vector<int>({2}),
+            trackIdsOfMatches(TextFilterNode(
+                    QSqlDatabase(), {LIBRARYTABLE_TITLE}, "peach")));
+}
+
+} // namespace
@@ -47,9 +47,39 @@ TEST_F(ControllerRenderingEngineTest, createValidRendererWithSupportedTypes) {
                 pixelFormat,                                           // pixelFormat
                 LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
                 false,                                                 // reversedColor
-                false                                                  // rawData
+                false,                                                 // rawData
+                false,                                                 // partialUpdate
+                false                                                  // skipUnchangedFrames
         });
         EXPECT_TRUE(screenTest.isValid());
         EXPECT_TRUE(screenTest.stop());
     }
 }
+
+TEST_F(ControllerRenderingEngineTest, onlySkipUnchangedFramesIfConfigured) {
+    LegacyControllerMapping::ScreenInfo info{
+            "",                                                       // identifier
+            QSize(0, 0),                                              // size
+            10,                                                       // target_fps
+            1,                                                        // msaa
+            std::chrono::milliseconds(10),                            // splash_off
+            QImage::Format_RGB16,                                     // pixelFormat
+            LegacyControllerMapping::ScreenInfo::ColorEndian::Little, // endian
+            false,                                                    // reversedColor
+            false,                                                    // rawData
+            false,                                                    // partialUpdate
+            false                                                     // skipUnchangedFrames
+    };
+    EXPECT_FALSE(ControllerRenderingEngine::canSkipFrame(info, false, 100ms));
+    EXPECT_FALSE(ControllerRenderingEngine::canSkipFrame(info, true, 100ms));
+
+    info.skipUnchangedFrames = true;
+    EXPECT_TRUE(ControllerRenderingEngine::canSkipFrame(info, false, 100ms));
+    EXPECT_FALSE(ControllerRenderingEngine::canSkipFrame(info, true, 100ms));
+
+    // A complete frame is still sent periodically
+    EXPECT_FALSE(ControllerRenderingEngine::canSkipFrame(info,
+            false,
+            ControllerRenderingEngine::kMaxSkippedFramesDuration));
+    EXPECT_FALSE(ControllerRenderingEngine::canSkipFrame(info, false, 10s));
+}
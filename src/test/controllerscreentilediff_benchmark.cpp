@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <QPainter>
+#include <vector>
+
+#include "controllers/rendering/controllerscreentilediff.h"
+
+namespace {
+
+// Like the screens of the Traktor Kontrol S4 MK3
+constexpr int kWidth = 480;
+constexpr int kHeight = 272;
+constexpr int kTargetFps = 30;
+
+QImage createFrame() {
+    QImage frame(kWidth, kHeight, QImage::Format_RGB16);
+    frame.fill(Qt::black);
+    return frame;
+}
+
+enum class FrameChange {
+    None,
+    // A scrolling waveform with a track position and a time display
+    Waveform,
+    // Fades or page transitions
+    Complete,
+};
+
+std::vector<QImage> createFrames(FrameChange change) {
+    constexpr int kFrameCount = kTargetFps;
+    std::vector<QImage> frames;
+    frames.reserve(kFrameCount);
+    for (int i = 0; i < kFrameCount; ++i) {
+        QImage frame = createFrame();
+        QPainter painter(&frame);
+        painter.fillRect(0, 0, kWidth, 40, Qt::darkBlue);
+        painter.setPen(Qt::white);
+        painter.drawText(QRect(0, 0, kWidth, 40), Qt::AlignCenter, QStringLiteral("Artist - Title"));
+        switch (change) {
+        case FrameChange::None:
+            break;
+        case FrameChange::Waveform:
+            painter.drawText(QRect(0, 40, kWidth / 2, 30),
+                    Qt::AlignCenter,
+                    QStringLiteral("-01:23.%1").arg(i % 10));
+            painter.fillRect(0, 240, i * kWidth / kFrameCount, 8, Qt::green);
+            for (int x = 0; x < kWidth; x += 2) {
+                const int amplitude = (x * 7 + i * 2) % 60;
+                painter.fillRect(x, 160 - amplitude, 2, 2 * amplitude, Qt::cyan);
+            }
+            break;
+        case FrameChange::Complete:
+            painter.fillRect(0, 40, kWidth, kHeight - 40, QColor(i * 8, i * 4, i * 2));
+            break;
+        }
+        painter.end();
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+void BM_ControllerScreenTileDiff(benchmark::State& state, FrameChange change) {
+    const std::vector<QImage> frames = createFrames(change);
+    ControllerScreenTileDiff diff;
+    diff.update(frames.back());
+
+    std::size_t frameIndex = 0;
+    qint64 changedBytes = 0;
+    for (auto _ : state) {
+        const QImage& frame = frames[frameIndex];
+        frameIndex = (frameIndex + 1) % frames.size();
+        const QList<QRect> regions = diff.update(frame);
+        for (const QRect& region : regions) {
+            changedBytes += region.width() * region.height() * frame.depth() / 8;
+        }
+        benchmark::DoNotOptimize(regions);
+    }
+
+    const qint64 frameBytes = frames.front().sizeInBytes();
+    state.SetBytesProcessed(state.iterations() * frameBytes);
+    const double changedBytesPerFrame =
+            static_cast<double>(changedBytes) / state.iterations();
+    // The bandwidth needed on the bus at the target frame rate, without any
+    // protocol overhead
+    state.counters["sentBytes/s"] = changedBytesPerFrame * kTargetFps;
+    state.counters["fullFrameBytes/s"] = static_cast<double>(frameBytes) * kTargetFps;
+}
+
+BENCHMARK_CAPTURE(BM_ControllerScreenTileDiff, Static, FrameChange::None);
+BENCHMARK_CAPTURE(BM_ControllerScreenTileDiff, Waveform, FrameChange::Waveform);
+BENCHMARK_CAPTURE(BM_ControllerScreenTileDiff, Complete, FrameChange::Complete);
+
+} // namespace
@@ -0,0 +1,103 @@
+#include "controllers/rendering/controllerscreentilediff.h"
+
+#include <gtest/gtest.h>
+
+#include <QPainter>
+#include <QRandomGenerator>
+
+namespace {
+
+// Like the screens of the Traktor Kontrol S4 MK3
+constexpr int kWidth = 480;
+constexpr int kHeight = 272;
+
+QImage createFrame(int width = kWidth, int height = kHeight) {
+    QImage frame(width, height, QImage::Format_RGB16);
+    frame.fill(Qt::black);
+    return frame;
+}
+
+// Applies the changed regions of the frame to the previous frame, like a
+// device that supports partial updates.
+void applyRegions(QImage* pPreviousFrame, const QImage& frame, const QList<QRect>& regions) {
+    QPainter painter(pPreviousFrame);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect& region : regions) {
+        painter.drawImage(region.topLeft(), frame, region);
+    }
+}
+
+TEST(ControllerScreenTileDiffTest, FirstFrameIsComplete) {
+    ControllerScreenTileDiff diff;
+    const QImage frame = createFrame();
+    EXPECT_EQ(QList<QRect>{frame.rect()}, diff.update(frame));
+    EXPECT_TRUE(diff.update(frame).isEmpty());
+
+    // A new size requires a complete frame again
+    const QImage resizedFrame = createFrame(kWidth / 2, kHeight / 2);
+    EXPECT_EQ(QList<QRect>{resizedFrame.rect()}, diff.update(resizedFrame));
+
+    diff.reset();
+    EXPECT_EQ(QList<QRect>{resizedFrame.rect()}, diff.update(resizedFrame));
+}
+
+TEST(ControllerScreenTileDiffTest, ChangedPixel) {
+    ControllerScreenTileDiff diff(16);
+    QImage frame = createFrame(100, 50);
+    diff.update(frame);
+
+    frame.setPixel(20, 40, 0xffff);
+    EXPECT_EQ(QList<QRect>{QRect(16, 32, 16, 16)}, diff.update(frame));
+    EXPECT_TRUE(diff.update(frame).isEmpty());
+
+    // The tiles at the right and bottom edges are smaller
+    frame.setPixel(99, 49, 0xffff);
+    EXPECT_EQ(QList<QRect>{QRect(96, 48, 4, 2)}, diff.update(frame));
+}
+
+TEST(ControllerScreenTileDiffTest, MergeAdjacentTiles) {
+    ControllerScreenTileDiff diff(16);
+    QImage frame = createFrame();
+    diff.update(frame);
+
+    // A vertical line, e.g. the play marker of a waveform
+    for (int y = 0; y < kHeight; ++y) {
+        frame.setPixel(100, y, 0xffff);
+    }
+    EXPECT_EQ(QList<QRect>{QRect(96, 0, 16, kHeight)}, diff.update(frame));
+
+    // A horizontal line, e.g. a progress bar
+    for (int x = 10; x < 300; ++x) {
+        frame.setPixel(x, 20, 0xffff);
+    }
+    EXPECT_EQ(QList<QRect>{QRect(0, 16, 304, 16)}, diff.update(frame));
+
+    // Two separate regions in the same tile rows
+    frame.setPixel(0, 0, 0x1234);
+    frame.setPixel(0, 16, 0x1234);
+    frame.setPixel(479, 0, 0x1234);
+    frame.setPixel(479, 16, 0x1234);
+    EXPECT_EQ((QList<QRect>{QRect(0, 0, 16, 32), QRect(464, 0, 16, 32)}),
+            diff.update(frame));
+}
+
+TEST(ControllerScreenTileDiffTest, RegionsContainAllChanges) {
+    ControllerScreenTileDiff diff;
+    QImage frame = createFrame();
+    QImage deviceFrame = frame.copy();
+    diff.update(frame);
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < 100; ++i) {
+        const int changes = random.bounded(50);
+        for (int j = 0; j < changes; ++j) {
+            frame.setPixel(random.bounded(kWidth),
+                    random.bounded(kHeight),
+                    random.bounded(0x10000));
+        }
+        applyRegions(&deviceFrame, frame, diff.update(frame));
+        ASSERT_EQ(frame, deviceFrame) << i;
+    }
+}
+
+} // namespace
@@ -827,8 +827,33 @@ class MockScreenRender : public ControllerRenderingEngine {
             requestSendingFrameData,
             (Controller * controller, const QByteArray& frame),
             (override));
+    MOCK_METHOD(void,
+            requestSendingFrameRegions,
+            (Controller * controller, const QList<QByteArray>& regions),
+            (override));
 };
 
+namespace {
+
+// The result of the transform function of the partialUpdate test: the
+// position and size of the region, followed by its pixels.
+QByteArray transformedRegion(const QImage& frame, const QRect& region) {
+    QByteArray result;
+    result.append(static_cast<char>(region.x()));
+    result.append(static_cast<char>(region.y()));
+    result.append(static_cast<char>(region.width()));
+    result.append(static_cast<char>(region.height()));
+    const int bytesPerPixel = frame.depth() / 8;
+    for (int line = region.top(); line <= region.bottom(); ++line) {
+        result.append(reinterpret_cast<const char*>(frame.constScanLine(line)) +
+                        region.x() * bytesPerPixel,
+                region.width() * bytesPerPixel);
+    }
+    return result;
+}
+
+} // namespace
+
 TEST_F(ControllerScriptEngineLegacyTest, screenWontSentRawDataIfNotConfigured) {
     LogCaptureGuard logCaptureGuard;
     LegacyControllerMapping::ScreenInfo dummyScreen{
@@ -840,7 +865,9 @@ TEST_F(ControllerScriptEngineLegacyTest, screenWontSentRawDataIfNotConfigured) {
             QImage::Format_RGB16,                                  // pixelFormat
             LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
             false,                                                 // rawData
-            false                                                  // reversedColor
+            false,                                                 // reversedColor
+            false,                                                 // partialUpdate
+            false                                                  // skipUnchangedFrames
     };
     QImage dummyFrame;
     // Allocate screen on the heap as it need to outlive the this function,
@@ -875,7 +902,9 @@ TEST_F(ControllerScriptEngineLegacyTest, screenWillSentRawDataIfConfigured) {
             QImage::Format_RGB16,                                  // pixelFormat
             LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
             false,                                                 // reversedColor
-            true                                                   // rawData
+            true,                                                  // rawData
+            false,                                                 // partialUpdate
+            false                                                  // skipUnchangedFrames
     };
     QImage dummyFrame;
     // Allocate screen on the heap as it need to outlive the this function,
@@ -895,4 +924,136 @@ TEST_F(ControllerScriptEngineLegacyTest, screenWillSentRawDataIfConfigured) {
 
     ASSERT_ALL_EXPECTED_MSG();
 }
+
+TEST_F(ControllerScriptEngineLegacyTest, screenWillSendChangedRegionsIfConfigured) {
+    LogCaptureGuard logCaptureGuard;
+    LegacyControllerMapping::ScreenInfo dummyScreen{
+            "",                                                    // identifier
+            QSize(20, 20),                                         // size
+            10,                                                    // target_fps
+            1,                                                     // msaa
+            std::chrono::milliseconds(10),                         // splash_off
+            QImage::Format_RGB16,                                  // pixelFormat
+            LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
+            false,                                                 // reversedColor
+            false,                                                 // rawData
+            true,                                                  // partialUpdate
+            false                                                  // skipUnchangedFrames
+    };
+    // Allocate screen on the heap as it need to outlive the this function,
+    // since the engine will take ownership of it
+    std::shared_ptr<MockScreenRender> pDummyRender =
+            std::make_shared<MockScreenRender>(dummyScreen);
+    auto pRootItem = std::make_unique<mixxx::qml::QmlMixxxControllerScreen>();
+    const QJSValue transform = evaluate(QStringLiteral(
+            "var failing = false;"
+            "(function(data, timestamp, region) {"
+            "  if (failing && region.width === 4) {"
+            "    return undefined;"
+            "  }"
+            "  const result = new Uint8Array(4 + data.byteLength);"
+            "  result.set([region.x, region.y, region.width, region.height]);"
+            "  result.set(new Uint8Array(data), 4);"
+            "  return result.buffer;"
+            "})"));
+    ASSERT_TRUE(transform.isCallable());
+    pRootItem->setTransform(transform);
+    renderingScreens().insert(dummyScreen.identifier, pDummyRender);
+    rootItems().emplace(dummyScreen.identifier, std::move(pRootItem));
+
+    QImage frame(dummyScreen.size, dummyScreen.pixelFormat);
+    frame.fill(Qt::black);
+    QImage changedFrame = frame.copy();
+    changedFrame.setPixel(2, 2, 0xffff);
+    changedFrame.setPixel(18, 18, 0xffff);
+    {
+        ::testing::InSequence sequence;
+        // The first frame is sent completely
+        EXPECT_CALL(*pDummyRender,
+                requestSendingFrameRegions(
+                        _, QList<QByteArray>{transformedRegion(frame, frame.rect())}));
+        // A separate transfer for each changed region
+        EXPECT_CALL(*pDummyRender,
+                requestSendingFrameRegions(_,
+                        QList<QByteArray>{
+                                transformedRegion(changedFrame, QRect(0, 0, 16, 16)),
+                                transformedRegion(changedFrame, QRect(16, 16, 4, 4))}));
+        // Nothing has changed
+        EXPECT_CALL(*pDummyRender, requestSendingFrameRegions(_, QList<QByteArray>{}));
+        // The whole frame is sent again after failing to transform a region
+        EXPECT_CALL(*pDummyRender,
+                requestSendingFrameRegions(
+                        _, QList<QByteArray>{transformedRegion(frame, frame.rect())}));
+    }
+    EXPECT_CALL(*pDummyRender, requestSendingFrameData(_, _)).Times(0);
+    EXPECT_LOG_MSG(QtWarningMsg,
+            "Could not transform rendering buffer. The transform function "
+            "didn't return the expected Array. Stopping rendering on this screen");
+
+    const QDateTime timestamp = QDateTime::currentDateTime();
+    testHandleScreen(dummyScreen, frame, timestamp);
+    testHandleScreen(dummyScreen, changedFrame, timestamp);
+    testHandleScreen(dummyScreen, changedFrame, timestamp);
+
+    EXPECT_TRUE(evaluateAndAssert(QStringLiteral("failing = true;")));
+    testHandleScreen(dummyScreen, frame, timestamp);
+    EXPECT_TRUE(evaluateAndAssert(QStringLiteral("failing = false;")));
+    testHandleScreen(dummyScreen, frame, timestamp);
+
+    ASSERT_ALL_EXPECTED_MSG();
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, screenWillPeriodicallySendCompleteFrames) {
+    LegacyControllerMapping::ScreenInfo dummyScreen{
+            "",                                                    // identifier
+            QSize(20, 20),                                         // size
+            10,                                                    // target_fps
+            1,                                                     // msaa
+            std::chrono::milliseconds(10),                         // splash_off
+            QImage::Format_RGB16,                                  // pixelFormat
+            LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
+            false,                                                 // reversedColor
+            false,                                                 // rawData
+            true,                                                  // partialUpdate
+            true                                                   // skipUnchangedFrames
+    };
+    // Allocate screen on the heap as it need to outlive the this function,
+    // since the engine will take ownership of it
+    std::shared_ptr<MockScreenRender> pDummyRender =
+            std::make_shared<MockScreenRender>(dummyScreen);
+    auto pRootItem = std::make_unique<mixxx::qml::QmlMixxxControllerScreen>();
+    const QJSValue transform = evaluate(QStringLiteral(
+            "(function(data, timestamp, region) {"
+            "  const result = new Uint8Array(4 + data.byteLength);"
+            "  result.set([region.x, region.y, region.width, region.height]);"
+            "  result.set(new Uint8Array(data), 4);"
+            "  return result.buffer;"
+            "})"));
+    ASSERT_TRUE(transform.isCallable());
+    pRootItem->setTransform(transform);
+    renderingScreens().insert(dummyScreen.identifier, pDummyRender);
+    rootItems().emplace(dummyScreen.identifier, std::move(pRootItem));
+
+    QImage frame(dummyScreen.size, dummyScreen.pixelFormat);
+    frame.fill(Qt::black);
+    const QList<QByteArray> completeFrame{transformedRegion(frame, frame.rect())};
+    {
+        ::testing::InSequence sequence;
+        EXPECT_CALL(*pDummyRender, requestSendingFrameRegions(_, completeFrame));
+        EXPECT_CALL(*pDummyRender, requestSendingFrameRegions(_, QList<QByteArray>{}));
+        // The frame that is rendered periodically although the scene is
+        // unchanged restores the screen, e.g. if the device lost its frame
+        // buffer
+        EXPECT_CALL(*pDummyRender, requestSendingFrameRegions(_, completeFrame));
+        EXPECT_CALL(*pDummyRender, requestSendingFrameRegions(_, QList<QByteArray>{}));
+    }
+
+    const QDateTime timestamp = QDateTime::currentDateTime();
+    const auto maxSkippedFramesDuration =
+            ControllerRenderingEngine::kMaxSkippedFramesDuration.count();
+    testHandleScreen(dummyScreen, frame, timestamp);
+    testHandleScreen(dummyScreen, frame, timestamp.addMSecs(maxSkippedFramesDuration / 2));
+    testHandleScreen(dummyScreen, frame, timestamp.addMSecs(maxSkippedFramesDuration));
+    testHandleScreen(dummyScreen, frame, timestamp.addMSecs(maxSkippedFramesDuration + 100));
+}
 #endif
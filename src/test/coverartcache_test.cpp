@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
+#include <QFile>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
+#include "library/coverthumbnailcache.h"
 #include "library/trackcollection.h"
 #include "test/librarytest.h"
 #include "sources/soundsourceproxy.h"
@@ -51,6 +54,12 @@ class CoverArtCacheTest : public LibraryTest, public CoverArtCache {
         EXPECT_EQ(img, res.coverArt.loadedImage.image);
         EXPECT_QSTRING_EQ(info.coverLocation, res.coverArt.coverLocation);
     }
+
+    static void setLastModified(const QString& path, const QDateTime& lastModified) {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+    }
 };
 
 const QString kCoverFileTest = QStringLiteral("cover_test.jpg");
@@ -88,3 +97,105 @@ TEST_F(CoverArtCacheTest, loadCoverFromFileAbsolute) {
             getTestDir().filePath(kCoverLocationTest),
             getTestDir().filePath(kCoverLocationTest));
 }
+
+TEST_F(CoverArtCacheTest, loadCoverFromThumbnailCache) {
+    QTemporaryDir thumbnailDir;
+    ASSERT_TRUE(thumbnailDir.isValid());
+    const CoverThumbnailCache thumbnailCache(thumbnailDir.path());
+
+    QTemporaryDir coverDir;
+    ASSERT_TRUE(coverDir.isValid());
+    const QString coverLocation = coverDir.filePath(kCoverFileTest);
+    ASSERT_TRUE(QFile::copy(getTestDir().filePath(kCoverLocationTest), coverLocation));
+    const QImage img = QImage(coverLocation);
+    ASSERT_FALSE(img.isNull());
+    constexpr int kWidth = 64;
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = coverLocation;
+    info.setImageDigest(img);
+    const QString thumbnailPath = thumbnailCache.filePath(info.imageDigest(), kWidth);
+    EXPECT_FALSE(QFileInfo::exists(thumbnailPath));
+
+    // Loaded from the image file and stored in the cache
+    CoverArtCache::FutureResult res =
+            CoverArtCache::loadCover(TrackPointer(), info, kWidth, &thumbnailCache);
+    EXPECT_EQ(CoverInfo::LoadedImage::Result::Ok, res.coverArt.loadedImage.result);
+    EXPECT_EQ(kWidth, res.coverArt.loadedImage.image.width());
+    EXPECT_QSTRING_EQ(coverLocation, res.coverArt.loadedImage.location);
+    EXPECT_TRUE(QFileInfo::exists(thumbnailPath));
+
+    // The image file is not loaded again
+    res = CoverArtCache::loadCover(TrackPointer(), info, kWidth, &thumbnailCache);
+    EXPECT_EQ(CoverInfo::LoadedImage::Result::Ok, res.coverArt.loadedImage.result);
+    EXPECT_EQ(kWidth, res.coverArt.loadedImage.image.width());
+    EXPECT_QSTRING_EQ(thumbnailPath, res.coverArt.loadedImage.location);
+
+    // Thumbnails are not used if the cover is missing
+    CoverInfo missingInfo = info;
+    missingInfo.coverLocation = coverDir.filePath(QStringLiteral("missing.jpg"));
+    res = CoverArtCache::loadCover(TrackPointer(), missingInfo, kWidth, &thumbnailCache);
+    EXPECT_TRUE(res.coverArt.loadedImage.image.isNull());
+
+    // Replace the cover without updating the digest of the cover info
+    const QImage modifiedImg = img.mirrored();
+    ASSERT_TRUE(modifiedImg.save(coverLocation, "JPG"));
+    setLastModified(coverLocation, QFileInfo(thumbnailPath).lastModified().addSecs(10));
+    CoverInfo modifiedInfo;
+    modifiedInfo.setImageDigest(QImage(coverLocation));
+    ASSERT_NE(info.imageDigest(), modifiedInfo.imageDigest());
+    const QString modifiedThumbnailPath =
+            thumbnailCache.filePath(modifiedInfo.imageDigest(), kWidth);
+
+    // The outdated thumbnail is not used and the thumbnail of the
+    // modified cover is stored with its actual digest
+    res = CoverArtCache::loadCover(TrackPointer(), info, kWidth, &thumbnailCache);
+    EXPECT_EQ(CoverInfo::LoadedImage::Result::Ok, res.coverArt.loadedImage.result);
+    EXPECT_QSTRING_EQ(coverLocation, res.coverArt.loadedImage.location);
+    EXPECT_TRUE(QFileInfo::exists(modifiedThumbnailPath));
+}
+
+TEST_F(CoverArtCacheTest, pruneThumbnailCache) {
+    QTemporaryDir thumbnailDir;
+    ASSERT_TRUE(thumbnailDir.isValid());
+    const CoverThumbnailCache thumbnailCache(thumbnailDir.path());
+    constexpr int kWidth = 64;
+    const QImage img = QImage(getTestDir().filePath(kCoverLocationTest)).scaledToWidth(kWidth);
+    ASSERT_EQ(kWidth, img.width());
+
+    // The same image with different digests, i.e. all files have the same size
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QList<QByteArray> digests = {
+            QByteArrayLiteral("oldest"),
+            QByteArrayLiteral("old"),
+            QByteArrayLiteral("recent")};
+    const QList<QDateTime> lastModified = {
+            now.addDays(-3),
+            now.addDays(-2),
+            now.addSecs(-60)};
+    qint64 totalSize = 0;
+    for (int i = 0; i < digests.size(); ++i) {
+        ASSERT_TRUE(thumbnailCache.save(digests[i], kWidth, img));
+        const QString path = thumbnailCache.filePath(digests[i], kWidth);
+        setLastModified(path, lastModified[i]);
+        totalSize += QFileInfo(path).size();
+    }
+
+    EXPECT_EQ(0, thumbnailCache.prune(totalSize));
+
+    // Using a thumbnail updates its modification time
+    EXPECT_FALSE(thumbnailCache.load(digests[0], kWidth, now.addDays(-4)).isNull());
+    EXPECT_GT(QFileInfo(thumbnailCache.filePath(digests[0], kWidth)).lastModified(),
+            lastModified[2]);
+
+    // Only the least recently used thumbnail is removed
+    EXPECT_EQ(1, thumbnailCache.prune(totalSize - 1));
+    EXPECT_TRUE(QFileInfo::exists(thumbnailCache.filePath(digests[0], kWidth)));
+    EXPECT_FALSE(QFileInfo::exists(thumbnailCache.filePath(digests[1], kWidth)));
+    EXPECT_TRUE(QFileInfo::exists(thumbnailCache.filePath(digests[2], kWidth)));
+
+    EXPECT_EQ(2, thumbnailCache.prune(0));
+    EXPECT_FALSE(QFileInfo::exists(thumbnailCache.filePath(digests[0], kWidth)));
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+#include <thread>
+
 #include "library/dao/settingsdao.h"
 #include "test/mixxxdbtest.h"
+#include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 
 class DbConnectionPoolTest : public MixxxTest {};
@@ -20,3 +24,40 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+class DbConnectionPoolReadOnlyTest : public MixxxDbTest {};
+
+TEST_F(DbConnectionPoolReadOnlyTest, ReadWhileWriting) {
+    QSqlDatabase writer = dbConnection();
+    if (!MixxxDb::initWriteAheadLogging(writer)) {
+        GTEST_SKIP() << "SQLite doesn't support write-ahead logging";
+    }
+    QSqlQuery writerQuery(writer);
+    ASSERT_TRUE(writerQuery.exec(QStringLiteral("CREATE TABLE numbers (value INTEGER)")));
+    ASSERT_TRUE(writerQuery.exec(QStringLiteral("INSERT INTO numbers VALUES (1)")));
+
+    // The write transaction is still pending while reading
+    ASSERT_TRUE(writer.transaction());
+    ASSERT_TRUE(writerQuery.exec(QStringLiteral("INSERT INTO numbers VALUES (2)")));
+
+    int count = -1;
+    bool writeRejected = false;
+    std::thread readerThread([this, &count, &writeRejected] {
+        const mixxx::DbConnectionPooler readOnlyPooler(
+                dbConnectionPooler(), mixxx::DbConnection::AccessMode::ReadOnly);
+        ASSERT_TRUE(readOnlyPooler.isPooling());
+        const QSqlDatabase reader = mixxx::DbConnectionPooled(readOnlyPooler);
+        QSqlQuery readerQuery(reader);
+        if (readerQuery.exec(QStringLiteral("SELECT COUNT(*) FROM numbers")) &&
+                readerQuery.next()) {
+            count = readerQuery.value(0).toInt();
+        }
+        writeRejected = !readerQuery.exec(QStringLiteral("INSERT INTO numbers VALUES (3)"));
+    });
+    readerThread.join();
+
+    // Only the committed row is visible for the reader
+    EXPECT_EQ(1, count);
+    EXPECT_TRUE(writeRejected);
+    EXPECT_TRUE(writer.commit());
+}
@@ -0,0 +1,186 @@
+#include "library/scanner/directorylisting.h"
+
+#ifdef USE_BENCH
+#include <benchmark/benchmark.h>
+#endif
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <memory>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+bool writeFile(const QString& filePath) {
+    QFile file(filePath);
+    return file.open(QIODevice::WriteOnly) && file.write("test") > 0;
+}
+
+class DirectoryListingTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    QString path(const QString& relativePath) const {
+        return m_tempDir.filePath(relativePath);
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(DirectoryListingTest, SortedEntries) {
+    ASSERT_TRUE(writeFile(path("b.mp3")));
+    ASSERT_TRUE(writeFile(path("a.flac")));
+    ASSERT_TRUE(writeFile(path("B.ogg")));
+    ASSERT_TRUE(writeFile(path(".hidden.mp3")));
+    ASSERT_TRUE(QDir(m_tempDir.path()).mkdir("Album 2"));
+    ASSERT_TRUE(QDir(m_tempDir.path()).mkdir("Album 1"));
+    ASSERT_TRUE(QDir(m_tempDir.path()).mkdir(".hidden"));
+
+    DirectoryListing listing;
+    ASSERT_TRUE(listing.open(m_tempDir.path()));
+    listing.read();
+
+    EXPECT_EQ(QStringList({"B.ogg", "a.flac", "b.mp3"}), listing.fileNames());
+    EXPECT_EQ(QStringList({"Album 1", "Album 2"}), listing.subDirNames());
+
+    // Same order as the previous walker that has been used for hashing
+    QDir dir(m_tempDir.path());
+    dir.setSorting(QDir::Name);
+    EXPECT_EQ(dir.entryList(QDir::Files), listing.fileNames());
+    EXPECT_EQ(dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot), listing.subDirNames());
+}
+
+TEST_F(DirectoryListingTest, SymbolicLinks) {
+    ASSERT_TRUE(writeFile(path("track.mp3")));
+    ASSERT_TRUE(QDir(m_tempDir.path()).mkdir("dir"));
+    if (!QFile::link(path("track.mp3"), path("link.mp3"))) {
+        GTEST_SKIP() << "Symbolic links are not supported";
+    }
+    ASSERT_TRUE(QFile::link(path("dir"), path("linkdir")));
+    ASSERT_TRUE(QFile::link(path("missing.mp3"), path("broken.mp3")));
+
+    DirectoryListing listing;
+    ASSERT_TRUE(listing.open(m_tempDir.path()));
+    listing.read();
+
+    EXPECT_EQ(QStringList({"link.mp3", "track.mp3"}), listing.fileNames());
+    EXPECT_EQ(QStringList({"dir", "linkdir"}), listing.subDirNames());
+}
+
+TEST_F(DirectoryListingTest, MissingDirectory) {
+    DirectoryListing listing;
+    EXPECT_FALSE(listing.open(path("missing")));
+    EXPECT_TRUE(listing.fileNames().isEmpty());
+    EXPECT_TRUE(listing.subDirNames().isEmpty());
+}
+
+TEST_F(DirectoryListingTest, EntryPath) {
+    EXPECT_EQ(QStringLiteral("/music/a.mp3"),
+            DirectoryListing::entryPath("/music", "a.mp3"));
+    EXPECT_EQ(QStringLiteral("/a.mp3"),
+            DirectoryListing::entryPath("/", "a.mp3"));
+}
+
+#ifdef USE_BENCH
+constexpr int kFilesPerDirectory = 100;
+constexpr int kDirectoriesPerDirectory = 10;
+
+// Generates a directory tree with the given number of files once and
+// reuses it for all benchmarks.
+QString benchmarkDirectoryTree(int numFiles) {
+    static std::unique_ptr<QTemporaryDir> s_pTempDir;
+    static int s_numFiles = 0;
+    if (s_pTempDir && s_numFiles == numFiles) {
+        return s_pTempDir->path();
+    }
+    s_pTempDir = std::make_unique<QTemporaryDir>();
+    s_numFiles = numFiles;
+    QStringList dirPaths = {s_pTempDir->path()};
+    int numDirs = 1;
+    for (int i = 0; i < numFiles; ++i) {
+        if (i > 0 && i % kFilesPerDirectory == 0) {
+            // Breadth-first to keep the tree shallow
+            const QString parentPath = dirPaths[(numDirs - 1) / kDirectoriesPerDirectory];
+            const QString dirPath = parentPath + QStringLiteral("/dir") + QString::number(numDirs);
+            if (!QDir().mkdir(dirPath)) {
+                return QString();
+            }
+            dirPaths.append(dirPath);
+            ++numDirs;
+        }
+        const QString filePath = dirPaths.last() + QStringLiteral("/track") +
+                QString::number(i) +
+                (i % 10 == 0 ? QStringLiteral(".jpg") : QStringLiteral(".mp3"));
+        if (!writeFile(filePath)) {
+            return QString();
+        }
+    }
+    return s_pTempDir->path();
+}
+
+// The previous walker of RecursiveScanDirectoryTask
+int walkWithQDir(const QString& dirPath) {
+    QDir dir(dirPath);
+    dir.setFilter(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::System);
+    dir.setSorting(QDir::SortFlag::DirsFirst | QDir::SortFlag::Name);
+    int numFiles = 0;
+    const QFileInfoList children = dir.entryInfoList();
+    for (const auto& fileInfo : children) {
+        if (fileInfo.isFile()) {
+            ++numFiles;
+        } else {
+            numFiles += walkWithQDir(fileInfo.filePath());
+        }
+    }
+    return numFiles;
+}
+
+int walkWithDirectoryListing(const QString& dirPath) {
+    DirectoryListing listing;
+    if (!listing.open(dirPath)) {
+        return 0;
+    }
+    listing.read();
+    int numFiles = static_cast<int>(listing.fileNames().size());
+    for (const auto& subDirName : listing.subDirNames()) {
+        numFiles += walkWithDirectoryListing(
+                DirectoryListing::entryPath(dirPath, subDirName));
+    }
+    return numFiles;
+}
+
+void BM_WalkDirectoryTree(benchmark::State& state, bool useDirectoryListing) {
+    const int numFiles = static_cast<int>(state.range(0));
+    const QString rootPath = benchmarkDirectoryTree(numFiles);
+    if (rootPath.isEmpty()) {
+        state.SkipWithError("Failed to generate directory tree");
+        return;
+    }
+    for (auto _ : state) {
+        const int numWalkedFiles = useDirectoryListing
+                ? walkWithDirectoryListing(rootPath)
+                : walkWithQDir(rootPath);
+        if (numWalkedFiles != numFiles) {
+            state.SkipWithError("Unexpected number of files");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numFiles);
+}
+BENCHMARK_CAPTURE(BM_WalkDirectoryTree, QDir, false)
+        ->Arg(500000)
+        ->Iterations(3)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_WalkDirectoryTree, DirectoryListing, true)
+        ->Arg(500000)
+        ->Iterations(3)
+        ->Unit(benchmark::kMillisecond);
+#endif // USE_BENCH
+
+} // namespace
@@ -1,8 +1,13 @@
 #include "track/globaltrackcache.h"
 
+#include <QDir>
+#include <QElapsedTimer>
 #include <QThread>
 #include <QtDebug>
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include "test/mixxxtest.h"
 #include "track/track.h"
@@ -63,6 +68,64 @@ class TrackTitleThread: public QThread {
     std::atomic<bool> m_stop;
 };
 
+// Looks up the tracks that are resolved concurrently by the main thread,
+// either without locking the whole cache or with GlobalTrackCacheLocker.
+class TrackLookupThread : public QThread {
+  public:
+    TrackLookupThread(
+            const std::vector<TrackRef>& trackRefs,
+            bool lockCache)
+            : m_trackRefs(trackRefs),
+              m_lockCache(lockCache),
+              m_stop(false),
+              m_numLookups(0),
+              m_numHits(0) {
+    }
+
+    void stop() {
+        m_stop.store(true);
+    }
+
+    int numLookups() const {
+        return m_numLookups;
+    }
+    int numHits() const {
+        return m_numHits;
+    }
+
+    void run() override {
+        std::size_t i = 0;
+        while (!m_stop.load()) {
+            const TrackRef& trackRef = m_trackRefs[i++ % m_trackRefs.size()];
+            TrackPointer track;
+            if (m_lockCache) {
+                track = (i % 2 == 0)
+                        ? GlobalTrackCacheLocker().lookupTrackById(trackRef.getId())
+                        : GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+            } else {
+                track = (i % 2 == 0)
+                        ? GlobalTrackCache::lookupTrackById(trackRef.getId())
+                        : GlobalTrackCache::lookupTrackByRef(trackRef);
+            }
+            ++m_numLookups;
+            if (track) {
+                ++m_numHits;
+                EXPECT_EQ(trackRef.getId(), track->getId());
+                EXPECT_EQ(trackRef.getLocation(), track->getLocation());
+            }
+            // Dropping the last reference from this thread evicts the
+            // track on the main thread.
+        }
+    }
+
+  private:
+    const std::vector<TrackRef>& m_trackRefs;
+    const bool m_lockCache;
+    std::atomic<bool> m_stop;
+    int m_numLookups;
+    int m_numHits;
+};
+
 void deleteTrack(Track* pTrack) {
     // Delete track objects directly in unit tests with
     // no main event loop
@@ -85,6 +148,71 @@ class GlobalTrackCacheTest: public MixxxTest, public virtual GlobalTrackCacheSav
         GlobalTrackCache::destroyInstance();
     }
 
+    // Resolves and evicts tracks on the main thread while they are looked
+    // up concurrently by multiple threads. Returns the number of lookups
+    // per second as a measure of contention.
+    double resolveAndLookupConcurrently(
+            const std::vector<TrackRef>& trackRefs,
+            bool lockCache) {
+        std::vector<std::unique_ptr<TrackLookupThread>> lookupThreads;
+        for (int i = 0; i < kNumLookupThreads; ++i) {
+            lookupThreads.push_back(
+                    std::make_unique<TrackLookupThread>(trackRefs, lockCache));
+        }
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& pThread : lookupThreads) {
+            pThread->start();
+        }
+
+        // Only a few tracks are kept alive while all others are evicted
+        // and resolved again.
+        std::vector<TrackPointer> recentTracks(trackRefs.size() / 4);
+        for (int i = 0; i < kNumResolveIterations; ++i) {
+            const TrackRef& trackRef = trackRefs[i % trackRefs.size()];
+            TrackPointer track;
+            {
+                auto resolver = GlobalTrackCacheResolver(
+                        mixxx::FileAccess(mixxx::FileInfo(trackRef.getLocation())),
+                        trackRef.getId());
+                track = resolver.getTrack();
+                EXPECT_NE(GlobalTrackCacheLookupResult::ConflictCanonicalLocation,
+                        resolver.getLookupResult());
+            }
+            EXPECT_TRUE(static_cast<bool>(track));
+            recentTracks[i % recentTracks.size()] = std::move(track);
+            // Ensure that track objects are evicted and deleted
+            QCoreApplication::processEvents();
+        }
+
+        for (const auto& pThread : lookupThreads) {
+            pThread->stop();
+        }
+        int numLookups = 0;
+        int numHits = 0;
+        for (const auto& pThread : lookupThreads) {
+            pThread->wait();
+            numLookups += pThread->numLookups();
+            numHits += pThread->numHits();
+        }
+        const qint64 elapsedMillis = std::max<qint64>(timer.elapsed(), 1);
+
+        recentTracks.clear();
+        while (!GlobalTrackCacheLocker().isEmpty()) {
+            QCoreApplication::processEvents();
+        }
+
+        const double lookupsPerSecond = numLookups * 1000.0 / elapsedMillis;
+        qInfo() << (lockCache ? "Locking the cache:" : "Locking a shard:")
+                << numLookups << "lookups," << numHits << "hits in"
+                << elapsedMillis << "ms ="
+                << lookupsPerSecond << "lookups/s";
+        return lookupsPerSecond;
+    }
+
+    static constexpr int kNumLookupThreads = 4;
+    static constexpr int kNumResolveIterations = 20000;
+
     TrackPointer m_recentTrackPtr;
 };
 
@@ -231,3 +359,26 @@ TEST_F(GlobalTrackCacheTest, evictWhileMoving) {
 
     EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
 }
+
+TEST_F(GlobalTrackCacheTest, concurrentLookups) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    const QDir testDataDir(getTestDir().filePath(QStringLiteral("id3-test-data")));
+    const QStringList fileNames = testDataDir.entryList(QDir::Files, QDir::Name);
+    std::vector<TrackRef> trackRefs;
+    for (const auto& fileName : fileNames) {
+        trackRefs.push_back(TrackRef::fromFileInfo(
+                mixxx::FileInfo(testDataDir.filePath(fileName)),
+                TrackId(QVariant(static_cast<int>(trackRefs.size()) + 1))));
+    }
+    ASSERT_GE(trackRefs.size(), 8u);
+
+    const double lockedLookupsPerSecond =
+            resolveAndLookupConcurrently(trackRefs, true);
+    const double shardedLookupsPerSecond =
+            resolveAndLookupConcurrently(trackRefs, false);
+    qInfo() << "Speedup of locking a shard:"
+            << shardedLookupsPerSecond / lockedLookupsPerSecond;
+
+    EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
+}
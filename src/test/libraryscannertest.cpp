@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
 #include "test/librarytest.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "util/fileinfo.h"
+
+using ::testing::UnorderedElementsAre;
 
 class LibraryScannerTest : public LibraryTest {
   protected:
@@ -11,6 +17,20 @@ class LibraryScannerTest : public LibraryTest {
             : m_libraryScanner(dbConnectionPooler(), config()) {
     }
     LibraryScanner m_libraryScanner;
+
+    // Returns an invalid id if the location is not in the library
+    TrackId trackIdForLocation(const QString& location) const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral(
+                "SELECT library.id FROM library INNER JOIN track_locations "
+                "ON library.location=track_locations.id "
+                "WHERE track_locations.location=:location"));
+        query.bindValue(":location", location);
+        if (!query.exec() || !query.next()) {
+            return TrackId();
+        }
+        return TrackId(query.value(0));
+    }
 };
 
 TEST_F(LibraryScannerTest, ScannerRoundtrip) {
@@ -52,3 +72,60 @@ TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     m_libraryScanner.changeScannerState(LibraryScanner::IDLE);
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
 }
+
+TEST_F(LibraryScannerTest, ScanChangedDirectories) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QDir rootDir(tempDir.path());
+    ASSERT_TRUE(rootDir.mkdir("a"));
+    ASSERT_TRUE(rootDir.mkdir("b"));
+    const QString dirA = mixxx::FileInfo(rootDir.filePath("a")).location();
+    const QString dirB = mixxx::FileInfo(rootDir.filePath("b")).location();
+    const QString sourceFile = getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3"));
+    const QString deletedTrack = dirA + QStringLiteral("/deleted.mp3");
+    const QString movedTrack = dirA + QStringLiteral("/moved.mp3");
+    const QString movedTrackTarget = dirB + QStringLiteral("/moved.mp3");
+    const QString addedTrack = dirA + QStringLiteral("/added.mp3");
+    ASSERT_TRUE(QFile::copy(sourceFile, deletedTrack));
+    ASSERT_TRUE(QFile::copy(sourceFile, movedTrack));
+    // The DAOs are usually initialized in the scanner thread
+    const QSqlDatabase database = dbConnection();
+    m_libraryScanner.m_libraryHashDao.initialize(database);
+    m_libraryScanner.m_cueDao.initialize(database);
+    m_libraryScanner.m_trackDao.initialize(database);
+    m_libraryScanner.m_playlistDao.initialize(database);
+    m_libraryScanner.m_analysisDao.initialize(database);
+    m_libraryScanner.m_directoryDao.initialize(database);
+    TrackDAO& trackDao = m_libraryScanner.m_trackDao;
+    LibraryHashDAO& libraryHashDao = m_libraryScanner.m_libraryHashDao;
+
+    // New directories
+    m_libraryScanner.scanChangedDirectories({dirA, dirB});
+    EXPECT_THAT(trackDao.getAllTrackLocations(),
+            UnorderedElementsAre(deletedTrack, movedTrack));
+    EXPECT_TRUE(trackDao.getAllMissingTrackLocations().isEmpty());
+    const mixxx::cache_key_t hashA = libraryHashDao.getDirectoryHash(dirA);
+    EXPECT_TRUE(mixxx::isValidCacheKey(hashA));
+    const TrackId movedTrackId = trackIdForLocation(movedTrack);
+    ASSERT_TRUE(movedTrackId.isValid());
+
+    // Deleted, moved, and added files
+    ASSERT_TRUE(QFile::remove(deletedTrack));
+    ASSERT_TRUE(QFile::rename(movedTrack, movedTrackTarget));
+    ASSERT_TRUE(QFile::copy(sourceFile, addedTrack));
+    m_libraryScanner.scanChangedDirectories({dirA, dirB});
+    EXPECT_THAT(trackDao.getAllTrackLocations(),
+            UnorderedElementsAre(deletedTrack, movedTrackTarget, addedTrack));
+    EXPECT_THAT(trackDao.getAllMissingTrackLocations(),
+            UnorderedElementsAre(deletedTrack));
+    // The moved track keeps its id
+    EXPECT_EQ(movedTrackId, trackIdForLocation(movedTrackTarget));
+    EXPECT_NE(hashA, libraryHashDao.getDirectoryHash(dirA));
+    EXPECT_TRUE(mixxx::isValidCacheKey(libraryHashDao.getDirectoryHash(dirB)));
+
+    // Rediscovered file
+    ASSERT_TRUE(QFile::copy(sourceFile, deletedTrack));
+    m_libraryScanner.scanChangedDirectories({dirA});
+    EXPECT_TRUE(trackDao.getAllMissingTrackLocations().isEmpty());
+}
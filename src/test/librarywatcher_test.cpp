@@ -0,0 +1,92 @@
+#include "library/scanner/librarywatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+constexpr int kTimeoutMillis = 10000;
+
+class LibraryWatcherTest : public MixxxTest {
+  protected:
+    LibraryWatcherTest()
+            : m_rootDir(m_tempDir.path()) {
+        QObject::connect(&m_watcher,
+                &LibraryWatcher::directoriesChanged,
+                [this](const QStringList& dirPaths) {
+                    m_changedDirectories += dirPaths;
+                });
+    }
+
+    void SetUp() override {
+        if (!LibraryWatcher::isSupported()) {
+            GTEST_SKIP() << "Watching directories is not supported on this platform";
+        }
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    QString path(const QString& relativePath) const {
+        return m_rootDir + QChar('/') + relativePath;
+    }
+
+    bool writeFile(const QString& relativePath) const {
+        QFile file(path(relativePath));
+        return file.open(QIODevice::WriteOnly) && file.write("data") > 0;
+    }
+
+    QStringList waitForChangedDirectories() {
+        QElapsedTimer timer;
+        timer.start();
+        while (m_changedDirectories.isEmpty() && timer.elapsed() < kTimeoutMillis) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+        }
+        QStringList changedDirectories = m_changedDirectories;
+        m_changedDirectories.clear();
+        changedDirectories.sort();
+        return changedDirectories;
+    }
+
+    const QTemporaryDir m_tempDir;
+    const QString m_rootDir;
+    LibraryWatcher m_watcher;
+    QStringList m_changedDirectories;
+};
+
+TEST_F(LibraryWatcherTest, JournalChangedFiles) {
+    ASSERT_TRUE(QDir(m_rootDir).mkdir("a"));
+    ASSERT_TRUE(m_watcher.watchDirectoryTree(m_rootDir));
+    EXPECT_EQ(2, m_watcher.numWatchedDirectories());
+
+    ASSERT_TRUE(writeFile("a/1.mp3"));
+    ASSERT_TRUE(writeFile("a/2.mp3"));
+    EXPECT_EQ(QStringList{path("a")}, waitForChangedDirectories());
+
+    ASSERT_TRUE(QFile::rename(path("a/1.mp3"), path("1.mp3")));
+    EXPECT_EQ(QStringList({m_rootDir, path("a")}), waitForChangedDirectories());
+
+    ASSERT_TRUE(QFile::remove(path("1.mp3")));
+    EXPECT_EQ(QStringList{m_rootDir}, waitForChangedDirectories());
+}
+
+TEST_F(LibraryWatcherTest, JournalDirectoryTrees) {
+    ASSERT_TRUE(m_watcher.watchDirectoryTree(m_rootDir));
+
+    // New directories are watched and reported recursively
+    ASSERT_TRUE(QDir(m_rootDir).mkpath("b/c"));
+    ASSERT_TRUE(writeFile("b/c/1.mp3"));
+    EXPECT_EQ(QStringList({path("b"), path("b/c")}), waitForChangedDirectories());
+    EXPECT_EQ(3, m_watcher.numWatchedDirectories());
+
+    ASSERT_TRUE(QDir(path("b")).removeRecursively());
+    EXPECT_EQ(QStringList({path("b"), path("b/c")}), waitForChangedDirectories());
+    EXPECT_EQ(1, m_watcher.numWatchedDirectories());
+}
+
+} // namespace
@@ -3,6 +3,9 @@
 #include <QDir>
 #include <QtDebug>
 
+#include "library/columnartrackindex.h"
+#include "library/columncache.h"
+#include "library/dao/trackschema.h"
 #include "library/searchquery.h"
 #include "library/searchqueryparser.h"
 #include "library/trackset/crate/crate.h"
@@ -922,6 +925,41 @@ TEST_F(SearchQueryParserTest, ShortCrateFilter) {
     EXPECT_TRUE(pQuery->match(pTrackC));
 }
 
+TEST_F(SearchQueryParserTest, ShortCrateFilterIndexed) {
+    m_parser.setSearchColumns({"crate", "artist", "comment"});
+    auto pQuery(m_parser.parseQuery(QStringLiteral("ecrat"), QString()));
+
+    Crate testCrate;
+    testCrate.setName(QStringLiteral("somecrate"));
+    CrateId testCrateId;
+    internalCollection()->insertCrate(testCrate, &testCrateId);
+
+    const TrackId trackAId = addTrackToCollection(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3")));
+    const TrackId trackBId = addTrackToCollection(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-png.mp3")));
+    const TrackId trackCId = addTrackToCollection(getTestDir().filePath(
+            QStringLiteral("id3-test-data/artist.mp3")));
+    internalCollection()->addCrateTracks(testCrateId, {trackAId});
+
+    const ColumnCache columnCache(
+            {LIBRARYTABLE_ID, LIBRARYTABLE_ARTIST, LIBRARYTABLE_COMMENT});
+    const mixxx::StringCollator collator;
+    ColumnarTrackIndex index(columnCache, collator);
+    index.updateRow(trackAId, {trackAId.toVariant(), QVariant(), QVariant()});
+    index.updateRow(trackBId, {trackBId.toVariant(), "artist", QVariant()});
+    index.updateRow(trackCId,
+            {trackCId.toVariant(), QVariant(), "garbage somecrate garbage"});
+
+    // The crate is not a column of the index and the crate tracks
+    // are matched directly
+    std::vector<uint8_t> matches;
+    ASSERT_TRUE(pQuery->matchIndexed(index, &matches));
+    EXPECT_EQ(ColumnarTrackIndex::kRowTrue, matches[index.rowOf(trackAId)]);
+    EXPECT_NE(ColumnarTrackIndex::kRowTrue, matches[index.rowOf(trackBId)]);
+    EXPECT_EQ(ColumnarTrackIndex::kRowTrue, matches[index.rowOf(trackCId)]);
+}
+
 TEST_F(SearchQueryParserTest, CrateFilterEmpty) {
     // Empty should match everything
     auto pQuery(m_parser.parseQuery(QString("crate: "), QString()));
@@ -1188,6 +1226,75 @@ TEST_F(SearchQueryParserTest, QueryIsLessSpecific) {
             QStringLiteral("crate:\"a b c\"")));
 }
 
+TEST_F(SearchQueryParserTest, QueryIsMoreSpecific) {
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("searchm"),
+            QStringLiteral("searchme")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QLatin1String(""),
+            QStringLiteral("A")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("A C"),
+            QStringLiteral("A B C")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("A B "),
+            QStringLiteral("A B -C")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("artist:abba Wat"),
+            QStringLiteral("artist:abba Water")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("A B C"),
+            QStringLiteral("A C")));
+
+    // Negated terms match less when extended
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("-abb"),
+            QStringLiteral("-abba")));
+
+    // Filters may not match a prefix of their argument
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("bpm:>1"),
+            QStringLiteral("bpm:>12")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("=abb"),
+            QStringLiteral("=abba")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("\"a b"),
+            QStringLiteral("\"a b\"")));
+
+    // Plain terms must not become filters when extended
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("art"),
+            QStringLiteral("artist:abba")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("b"),
+            QStringLiteral("bpm:>120")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("abba a"),
+            QStringLiteral("abba a\"")));
+
+    EXPECT_TRUE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("a b"),
+            QStringLiteral("a b bpm:>120")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("abba"),
+            QStringLiteral("abba | queen")));
+
+    EXPECT_FALSE(SearchQueryParser::queryIsMoreSpecific(
+            QStringLiteral("abba OR"),
+            QStringLiteral("abba OR queen")));
+}
+
 TEST_F(SearchQueryParserTest, EmptyOrOperator) {
     auto pQuery = m_parser.parseQuery("|", QString());
 
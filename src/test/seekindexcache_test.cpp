@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "sources/seekindexcache.h"
+#include "test/mixxxtest.h"
+#ifdef __MAD__
+#include "sources/soundsourcemp3.h"
+#include "util/samplebuffer.h"
+#endif
+
+class SeekIndexCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_cacheDir.isValid());
+        ASSERT_TRUE(m_audioDir.isValid());
+        mixxx::SeekIndexCache::setDirectory(m_cacheDir.path());
+    }
+
+    void TearDown() override {
+        mixxx::SeekIndexCache::setDirectory(QString());
+    }
+
+    QString copyTestFile(const QString& fileName) {
+        const QString filePath = m_audioDir.filePath(fileName);
+        EXPECT_TRUE(QFile::copy(
+                getTestDir().filePath(QStringLiteral("id3-test-data/") + fileName),
+                filePath));
+        return filePath;
+    }
+
+    QTemporaryDir m_cacheDir;
+    QTemporaryDir m_audioDir;
+};
+
+TEST_F(SeekIndexCacheTest, saveAndLoad) {
+    const QString filePath = copyTestFile(QStringLiteral("cover-test.wav"));
+    const QByteArray index("seek index");
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), filePath));
+    EXPECT_TRUE(mixxx::SeekIndexCache::save(QStringLiteral("test"), filePath, index));
+    EXPECT_EQ(index, mixxx::SeekIndexCache::load(QStringLiteral("test"), filePath));
+    // Indexes of different kinds are independent
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("other"), filePath));
+}
+
+TEST_F(SeekIndexCacheTest, invalidatedWhenFileModified) {
+    const QString filePath = copyTestFile(QStringLiteral("cover-test.wav"));
+    EXPECT_TRUE(mixxx::SeekIndexCache::save(
+            QStringLiteral("test"), filePath, QByteArray("seek index")));
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(
+            QDateTime::currentDateTime().addSecs(60),
+            QFileDevice::FileModificationTime));
+    file.close();
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), filePath));
+}
+
+TEST_F(SeekIndexCacheTest, disabledWithoutDirectory) {
+    const QString filePath = copyTestFile(QStringLiteral("cover-test.wav"));
+    mixxx::SeekIndexCache::setDirectory(QString());
+    EXPECT_FALSE(mixxx::SeekIndexCache::isEnabled());
+    EXPECT_FALSE(mixxx::SeekIndexCache::save(
+            QStringLiteral("test"), filePath, QByteArray("seek index")));
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), filePath));
+}
+
+TEST_F(SeekIndexCacheTest, pruneLeastRecentlyUsed) {
+    const QString firstFilePath = copyTestFile(QStringLiteral("cover-test.wav"));
+    const QString secondFilePath = copyTestFile(QStringLiteral("cover-test.flac"));
+    const QString thirdFilePath = copyTestFile(QStringLiteral("cover-test.ogg"));
+    const QByteArray index("seek index");
+    for (const auto& filePath : {firstFilePath, secondFilePath, thirdFilePath}) {
+        ASSERT_TRUE(mixxx::SeekIndexCache::save(QStringLiteral("test"), filePath, index));
+    }
+
+    // Age all indexes, then use the second one
+    const QFileInfoList sidecarFileInfos =
+            QDir(m_cacheDir.path()).entryInfoList(QDir::Files);
+    ASSERT_EQ(3, sidecarFileInfos.size());
+    for (const auto& sidecarFileInfo : sidecarFileInfos) {
+        QFile sidecarFile(sidecarFileInfo.filePath());
+        ASSERT_TRUE(sidecarFile.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(sidecarFile.setFileTime(
+                QDateTime::currentDateTime().addDays(-1),
+                QFileDevice::FileModificationTime));
+    }
+    ASSERT_TRUE(mixxx::SeekIndexCache::load(QStringLiteral("test"), secondFilePath));
+
+    EXPECT_EQ(0, mixxx::SeekIndexCache::prune(3 * sidecarFileInfos.first().size()));
+    EXPECT_EQ(2, mixxx::SeekIndexCache::prune(sidecarFileInfos.first().size()));
+    EXPECT_EQ(index, mixxx::SeekIndexCache::load(QStringLiteral("test"), secondFilePath));
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), firstFilePath));
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), thirdFilePath));
+
+    mixxx::SeekIndexCache::clear();
+    EXPECT_FALSE(mixxx::SeekIndexCache::load(QStringLiteral("test"), secondFilePath));
+}
+
+#ifdef __MAD__
+TEST_F(SeekIndexCacheTest, restoreMp3SeekFrames) {
+    const QString filePath = copyTestFile(QStringLiteral("cover-test-vbr.mp3"));
+    const auto url = QUrl::fromLocalFile(filePath);
+    mixxx::AudioSource::OpenParams openParams;
+
+    // The first open scans the file and stores the seek index
+    mixxx::SoundSourceMp3 scanned(url);
+    ASSERT_EQ(mixxx::SoundSource::OpenResult::Succeeded,
+            scanned.open(mixxx::SoundSource::OpenMode::Strict, openParams));
+    ASSERT_TRUE(mixxx::SeekIndexCache::load(QStringLiteral("mp3"), filePath));
+
+    // The second open restores the seek index
+    mixxx::SoundSourceMp3 restored(url);
+    ASSERT_EQ(mixxx::SoundSource::OpenResult::Succeeded,
+            restored.open(mixxx::SoundSource::OpenMode::Strict, openParams));
+    EXPECT_EQ(scanned.getSignalInfo(), restored.getSignalInfo());
+    EXPECT_EQ(scanned.frameIndexRange(), restored.frameIndexRange());
+    EXPECT_EQ(scanned.getBitrate(), restored.getBitrate());
+
+    // Seek into the middle of the file and compare the decoded samples
+    const auto frameRange = mixxx::IndexRange::forward(
+            scanned.frameIndexRange().length() / 2, 1024);
+    mixxx::SampleBuffer scannedBuffer(
+            scanned.getSignalInfo().frames2samples(frameRange.length()));
+    mixxx::SampleBuffer restoredBuffer(
+            restored.getSignalInfo().frames2samples(frameRange.length()));
+    const auto scannedFrames = scanned.readSampleFrames(
+            mixxx::WritableSampleFrames(frameRange,
+                    mixxx::SampleBuffer::WritableSlice(scannedBuffer)));
+    const auto restoredFrames = restored.readSampleFrames(
+            mixxx::WritableSampleFrames(frameRange,
+                    mixxx::SampleBuffer::WritableSlice(restoredBuffer)));
+    ASSERT_EQ(scannedFrames.frameIndexRange(), restoredFrames.frameIndexRange());
+    for (SINT i = 0; i < scannedFrames.readableLength(); ++i) {
+        EXPECT_EQ(scannedFrames.readableData()[i], restoredFrames.readableData()[i]);
+    }
+}
+#endif
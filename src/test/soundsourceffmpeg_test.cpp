@@ -0,0 +1,227 @@
+#include "sources/soundsourceffmpeg.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <iterator>
+#include <memory>
+
+#include "sources/seekindexcache.h"
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+namespace {
+
+// Ogg files provide no seek index, i.e. the packet index is recorded
+const QString kFileName = QStringLiteral("cover-test.ogg");
+
+constexpr SINT kChunkFrameCount = 4096;
+
+// Neither a multiple nor a divisor of the decoded frame sizes, i.e.
+// decoded frames are cut at the boundaries of the output buffers
+const SINT kOutputFrameCounts[] = {1000, 1024, 1152, 333, 4097, 64};
+
+} // anonymous namespace
+
+class SoundSourceFFmpegTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_cacheDir.isValid());
+        ASSERT_TRUE(m_audioDir.isValid());
+        m_filePath = copyTestFile(kFileName);
+        SeekIndexCache::setDirectory(m_cacheDir.path());
+    }
+
+    void TearDown() override {
+        SeekIndexCache::setDirectory(QString());
+    }
+
+    static std::unique_ptr<SoundSourceFFmpeg> openSource(const QString& filePath) {
+        auto pSource = std::make_unique<SoundSourceFFmpeg>(
+                QUrl::fromLocalFile(filePath));
+        if (pSource->open(SoundSource::OpenMode::Strict,
+                    AudioSource::OpenParams()) !=
+                SoundSource::OpenResult::Succeeded) {
+            return nullptr;
+        }
+        return pSource;
+    }
+
+    std::unique_ptr<SoundSourceFFmpeg> openSource() const {
+        return openSource(m_filePath);
+    }
+
+    static std::vector<CSAMPLE> readFrames(
+            SoundSourceFFmpeg* pSource,
+            IndexRange frameRange) {
+        frameRange = intersect(frameRange, pSource->frameIndexRange());
+        std::vector<CSAMPLE> samples(
+                pSource->getSignalInfo().frames2samples(frameRange.length()));
+        const auto readable = pSource->readSampleFrames(
+                WritableSampleFrames(frameRange,
+                        SampleBuffer::WritableSlice(
+                                samples.data(),
+                                static_cast<SINT>(samples.size()))));
+        EXPECT_EQ(frameRange, readable.frameIndexRange());
+        return samples;
+    }
+
+    // Reads the whole file sequentially
+    static void readAllFrames(SoundSourceFFmpeg* pSource) {
+        for (SINT frameIndex = pSource->frameIndexMin();
+                frameIndex < pSource->frameIndexMax();
+                frameIndex += kChunkFrameCount) {
+            readFrames(pSource, IndexRange::forward(frameIndex, kChunkFrameCount));
+        }
+    }
+
+    static QString packetIndexKind(const SoundSourceFFmpeg& source) {
+        return source.packetIndexKind();
+    }
+
+    static bool isRecordingPacketIndex(const SoundSourceFFmpeg& source) {
+        return source.m_packetIndexState ==
+                SoundSourceFFmpeg::PacketIndexState::Recording;
+    }
+
+    static bool isPacketIndexComplete(const SoundSourceFFmpeg& source) {
+        return source.m_packetIndexState ==
+                SoundSourceFFmpeg::PacketIndexState::Complete;
+    }
+
+    static bool isResampling(SoundSourceFFmpeg* pSource) {
+        return pSource->m_pSwrContext != nullptr;
+    }
+
+    static void disableResamplingIntoOutputBuffer(SoundSourceFFmpeg* pSource) {
+        pSource->m_resampleIntoOutputBuffer = false;
+    }
+
+    // Decodes the file both directly into the output buffer and through
+    // the intermediate buffers and compares the samples
+    static void compareResampling(const QString& filePath) {
+        auto pDirect = openSource(filePath);
+        ASSERT_TRUE(pDirect);
+        ASSERT_TRUE(isResampling(pDirect.get()));
+        auto pBuffered = openSource(filePath);
+        ASSERT_TRUE(pBuffered);
+        disableResamplingIntoOutputBuffer(pBuffered.get());
+        ASSERT_EQ(pBuffered->frameIndexRange(), pDirect->frameIndexRange());
+
+        // Sequentially
+        SINT frameIndex = pDirect->frameIndexMin();
+        for (std::size_t i = 0; frameIndex < pDirect->frameIndexMax(); ++i) {
+            const auto frameRange = IndexRange::forward(frameIndex,
+                    kOutputFrameCounts[i % std::size(kOutputFrameCounts)]);
+            ASSERT_EQ(readFrames(pBuffered.get(), frameRange),
+                    readFrames(pDirect.get(), frameRange))
+                    << frameRange;
+            frameIndex = frameRange.end();
+        }
+
+        // After seeking backwards and forwards
+        const SINT frameLength = pDirect->frameIndexRange().length();
+        for (const SINT seekFrameIndex :
+                {frameLength / 3, SINT{4711}, frameLength / 2 + 1, frameLength - 3000}) {
+            frameIndex = pDirect->frameIndexMin() + seekFrameIndex;
+            for (const SINT frameCount : kOutputFrameCounts) {
+                const auto frameRange = IndexRange::forward(frameIndex, frameCount);
+                ASSERT_EQ(readFrames(pBuffered.get(), frameRange),
+                        readFrames(pDirect.get(), frameRange))
+                        << frameRange;
+                frameIndex = frameRange.end();
+            }
+        }
+    }
+
+    void recordPacketIndex() const {
+        auto pSource = openSource();
+        ASSERT_TRUE(pSource);
+        ASSERT_TRUE(isRecordingPacketIndex(*pSource));
+        readAllFrames(pSource.get());
+        ASSERT_TRUE(isPacketIndexComplete(*pSource));
+        ASSERT_TRUE(SeekIndexCache::load(packetIndexKind(*pSource), m_filePath));
+    }
+
+    QString copyTestFile(const QString& fileName) const {
+        const QString filePath = m_audioDir.filePath(fileName);
+        EXPECT_TRUE(QFile::copy(
+                getTestDir().filePath(QStringLiteral("id3-test-data/") + fileName),
+                filePath));
+        return filePath;
+    }
+
+    QTemporaryDir m_cacheDir;
+    QTemporaryDir m_audioDir;
+    QString m_filePath;
+};
+
+TEST_F(SoundSourceFFmpegTest, restorePacketIndex) {
+    recordPacketIndex();
+
+    auto pRestored = openSource();
+    ASSERT_TRUE(pRestored);
+    EXPECT_TRUE(isPacketIndexComplete(*pRestored));
+
+    // Seeking with the restored index must be sample accurate
+    SeekIndexCache::setDirectory(QString());
+    auto pScanned = openSource();
+    ASSERT_TRUE(pScanned);
+    EXPECT_EQ(pScanned->frameIndexRange(), pRestored->frameIndexRange());
+    const SINT frameLength = pScanned->frameIndexRange().length();
+    for (const SINT frameIndex :
+            {frameLength / 2, frameLength / 4, frameLength - 1000, SINT{1000}}) {
+        const auto frameRange = IndexRange::forward(frameIndex, 1000);
+        EXPECT_EQ(readFrames(pScanned.get(), frameRange),
+                readFrames(pRestored.get(), frameRange))
+                << frameIndex;
+    }
+}
+
+TEST_F(SoundSourceFFmpegTest, discardInvalidPacketIndex) {
+    {
+        auto pSource = openSource();
+        ASSERT_TRUE(pSource);
+        ASSERT_TRUE(SeekIndexCache::save(packetIndexKind(*pSource),
+                m_filePath,
+                QByteArrayLiteral("invalid")));
+    }
+
+    // The invalid index is ignored and replaced by a new one
+    auto pSource = openSource();
+    ASSERT_TRUE(pSource);
+    EXPECT_TRUE(isRecordingPacketIndex(*pSource));
+    readAllFrames(pSource.get());
+    EXPECT_TRUE(isPacketIndexComplete(*pSource));
+
+    pSource = openSource();
+    ASSERT_TRUE(pSource);
+    EXPECT_TRUE(isPacketIndexComplete(*pSource));
+}
+
+TEST_F(SoundSourceFFmpegTest, discardStalePacketIndex) {
+    recordPacketIndex();
+
+    QFile file(m_filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(
+            QDateTime::currentDateTime().addSecs(60),
+            QFileDevice::FileModificationTime));
+    file.close();
+
+    auto pSource = openSource();
+    ASSERT_TRUE(pSource);
+    EXPECT_TRUE(isRecordingPacketIndex(*pSource));
+}
+
+TEST_F(SoundSourceFFmpegTest, resampleIntoOutputBuffer) {
+    SeekIndexCache::setDirectory(QString());
+    compareResampling(m_filePath);
+    compareResampling(copyTestFile(QStringLiteral("cover-test-ffmpeg-aac.m4a")));
+}
+
+} // namespace mixxx
@@ -0,0 +1,111 @@
+#include "util/statsmanager.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+Event makeEvent(const QString& tag, Stat::StatType type, qint64 micros, double value = 0.0) {
+    Event event;
+    event.m_tag = tag;
+    event.m_type = type;
+    event.m_time = mixxx::Duration::fromMicros(micros);
+    event.m_value = value;
+    return event;
+}
+
+class StatsManagerTest : public MixxxTest {
+  protected:
+    QByteArray writeTimeline(const QString& fileName) {
+        EXPECT_TRUE(m_timelineDir.isValid());
+        const QString filePath = m_timelineDir.filePath(fileName);
+        // Not in chronological order, the timeline is sorted by time
+        StatsManager::writeTimeline(filePath,
+                {
+                        makeEvent(QStringLiteral("render"), Stat::EVENT_END, 1500),
+                        makeEvent(QStringLiteral("render"), Stat::EVENT_START, 1000),
+                        makeEvent(QStringLiteral("vsync"), Stat::EVENT, 2000),
+                        makeEvent(QStringLiteral("latency"),
+                                Stat::DURATION_NANOSEC,
+                                2500,
+                                1234.5),
+                });
+        QFile timeline(filePath);
+        EXPECT_TRUE(timeline.open(QIODevice::ReadOnly | QIODevice::Text));
+        return timeline.readAll();
+    }
+
+  private:
+    QTemporaryDir m_timelineDir;
+};
+
+TEST_F(StatsManagerTest, writeChromeTrace) {
+    const QJsonDocument trace =
+            QJsonDocument::fromJson(writeTimeline(QStringLiteral("timeline.json")));
+    ASSERT_TRUE(trace.isObject());
+
+    QHash<int, QString> threadNames;
+    QList<QJsonObject> events;
+    const QJsonArray traceEvents = trace.object().value(QStringLiteral("traceEvents")).toArray();
+    for (const auto& value : traceEvents) {
+        const QJsonObject event = value.toObject();
+        EXPECT_EQ(1, event.value(QStringLiteral("pid")).toInt());
+        if (event.value(QStringLiteral("ph")).toString() == QStringLiteral("M")) {
+            threadNames.insert(event.value(QStringLiteral("tid")).toInt(),
+                    event.value(QStringLiteral("args"))
+                            .toObject()
+                            .value(QStringLiteral("name"))
+                            .toString());
+        } else {
+            events.append(event);
+        }
+    }
+    ASSERT_EQ(4, events.size());
+    // Every tag has its own track
+    EXPECT_EQ(3, threadNames.size());
+
+    const auto expectEvent = [&threadNames](const QJsonObject& event,
+                                     const QString& phase,
+                                     const QString& name,
+                                     double timestamp) {
+        EXPECT_QSTRING_EQ(phase, event.value(QStringLiteral("ph")).toString());
+        EXPECT_QSTRING_EQ(name, event.value(QStringLiteral("name")).toString());
+        EXPECT_QSTRING_EQ(name, threadNames.value(event.value(QStringLiteral("tid")).toInt()));
+        EXPECT_DOUBLE_EQ(timestamp, event.value(QStringLiteral("ts")).toDouble());
+    };
+    expectEvent(events[0], QStringLiteral("B"), QStringLiteral("render"), 1000);
+    expectEvent(events[1], QStringLiteral("E"), QStringLiteral("render"), 1500);
+    expectEvent(events[2], QStringLiteral("i"), QStringLiteral("vsync"), 2000);
+    EXPECT_QSTRING_EQ(QStringLiteral("t"), events[2].value(QStringLiteral("s")).toString());
+    expectEvent(events[3], QStringLiteral("C"), QStringLiteral("latency"), 2500);
+    EXPECT_DOUBLE_EQ(1234.5,
+            events[3]
+                    .value(QStringLiteral("args"))
+                    .toObject()
+                    .value(QStringLiteral("value"))
+                    .toDouble());
+}
+
+TEST_F(StatsManagerTest, writeCsvTimeline) {
+    const QList<QByteArray> lines = writeTimeline(QStringLiteral("timeline.csv")).split('\n');
+    ASSERT_EQ(5, lines.size());
+    EXPECT_TRUE(lines.last().isEmpty());
+
+    // time, elapsed, since last start, since last end, type, tag[, value]
+    EXPECT_EQ(QByteArray("1000000,+0ns,+0ns,+0ns,START,render"), lines[0]);
+    EXPECT_EQ(QByteArray("1500000,+500us,+500us,+0ns,END,render"), lines[1]);
+    EXPECT_EQ(QByteArray("2000000,+500us,+0ns,+0ns,EVENT,vsync"), lines[2]);
+    // Only stats that are tracked with Stat::TIMELINE have a value
+    EXPECT_EQ(QByteArray("2500000,+500us,+0ns,+0ns,DURATION_NANOSEC,latency,1234.5"),
+            lines[3]);
+}
+
+} // namespace
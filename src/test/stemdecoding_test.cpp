@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "sources/soundsourceffmpeg.h"
+#include "sources/soundsourcestem.h"
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+
+using namespace mixxx;
+
+namespace {
+
+// Reads consecutive chunks like the CachingReaderWorker does and starts
+// over at the beginning when reaching the end of the file.
+void readChunks(benchmark::State& state, SoundSource* pSource) {
+    const SINT chunkSampleLength = pSource->getSignalInfo().frames2samples(
+            CachingReaderChunk::kFrames);
+    SampleBuffer buffer(chunkSampleLength);
+    SINT frameIndex = pSource->frameIndexMin();
+    for (auto _ : state) {
+        const auto frameIndexRange = intersect(
+                IndexRange::forward(frameIndex, CachingReaderChunk::kFrames),
+                pSource->frameIndexRange());
+        const auto readable = pSource->readSampleFrames(
+                WritableSampleFrames(
+                        frameIndexRange,
+                        SampleBuffer::WritableSlice(
+                                buffer.data(),
+                                pSource->getSignalInfo().frames2samples(
+                                        frameIndexRange.length()))));
+        benchmark::DoNotOptimize(readable);
+        frameIndex = frameIndexRange.end();
+        if (frameIndex >= pSource->frameIndexMax()) {
+            frameIndex = pSource->frameIndexMin();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * CachingReaderChunk::kFrames);
+}
+
+QUrl stemFileUrl() {
+    return QUrl::fromLocalFile(
+            MixxxTest::getOrInitTestDir().filePath("stems/test.stem.mp4"));
+}
+
+// Decodes the main mix of a stem file, i.e. a normal deck
+void BM_ReadChunkMainMix(benchmark::State& state) {
+    SoundSourceFFmpeg source(stemFileUrl());
+    AudioSource::OpenParams config;
+    config.setChannelCount(audio::ChannelCount::stereo());
+    if (source.open(AudioSource::OpenMode::Strict, config) !=
+            AudioSource::OpenResult::Succeeded) {
+        state.SkipWithError("Failed to open stem file");
+        return;
+    }
+    readChunks(state, &source);
+}
+BENCHMARK(BM_ReadChunkMainMix);
+
+// Decodes all stems of a stem file, i.e. a stem deck
+void BM_ReadChunkStem(benchmark::State& state) {
+    SoundSourceSTEM source(stemFileUrl());
+    AudioSource::OpenParams config;
+    config.setChannelCount(audio::ChannelCount::stem());
+    if (source.open(AudioSource::OpenMode::Strict, config) !=
+            AudioSource::OpenResult::Succeeded) {
+        state.SkipWithError("Failed to open stem file");
+        return;
+    }
+    readChunks(state, &source);
+}
+BENCHMARK(BM_ReadChunkStem);
+
+} // namespace
@@ -1,6 +1,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "sources/soundsourceproxy.h"
 #include "test/librarytest.h"
 #include "track/track.h"
 
@@ -56,3 +57,95 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, preparedTrackImport) {
+    // The metadata of new tracks is imported concurrently while scanning
+    // and must result in the same track as importing it when adding the
+    // track to the database.
+    const QString location = getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3"));
+    const auto preparedImport = SoundSourceProxy::prepareTrackImportFromFile(
+            mixxx::FileAccess(mixxx::FileInfo(location)));
+    ASSERT_EQ(mixxx::MetadataSource::ImportResult::Succeeded,
+            preparedImport.importResult);
+
+    TrackPointer pPreparedTrack = Track::newTemporary(location);
+    EXPECT_EQ(SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pPreparedTrack)
+                    .updateTrackFromSource(
+                            SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                            SyncTrackMetadataParams{},
+                            &preparedImport));
+    TrackPointer pParsedTrack = Track::newTemporary(location);
+    EXPECT_EQ(SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pParsedTrack)
+                    .updateTrackFromSource(
+                            SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                            SyncTrackMetadataParams{}));
+
+    EXPECT_EQ(pParsedTrack->getMetadata(), pPreparedTrack->getMetadata());
+    EXPECT_EQ(pParsedTrack->getCoverInfo(), pPreparedTrack->getCoverInfo());
+    EXPECT_EQ(CoverInfo::METADATA, pPreparedTrack->getCoverInfo().type);
+
+    // Ignored if the track has already been synchronized
+    pPreparedTrack->setTitle(QStringLiteral("Edited"));
+    SoundSourceProxy(pPreparedTrack)
+            .updateTrackFromSource(
+                    SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                    SyncTrackMetadataParams{},
+                    &preparedImport);
+    EXPECT_EQ(QStringLiteral("Edited"), pPreparedTrack->getTitle());
+}
+
+TEST_F(TrackDAOTest, updateTrackLocationsInDirectory) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    const QDir dir(QDir::tempPath() + QStringLiteral("/watched"));
+    const mixxx::FileInfo existingFile(dir, QStringLiteral("existing.mp3"));
+    const mixxx::FileInfo deletedFile(dir, QStringLiteral("deleted.mp3"));
+    const mixxx::FileInfo rediscoveredFile(dir, QStringLiteral("rediscovered.mp3"));
+    const mixxx::FileInfo otherFile(
+            QDir(QDir::tempPath() + QStringLiteral("/other")),
+            QStringLiteral("deleted.mp3"));
+
+    internalCollection()->addTrack(
+            Track::newTemporary(mixxx::FileAccess(existingFile)), false);
+    const TrackId deletedId = internalCollection()->addTrack(
+            Track::newTemporary(mixxx::FileAccess(deletedFile)), false);
+    const TrackId rediscoveredId = internalCollection()->addTrack(
+            Track::newTemporary(mixxx::FileAccess(rediscoveredFile)), false);
+    internalCollection()->addTrack(
+            Track::newTemporary(mixxx::FileAccess(otherFile)), false);
+
+    // Mark as missing
+    QSqlQuery query(dbConnection());
+    query.prepare("UPDATE track_locations SET fs_deleted=1 WHERE location=:location");
+    query.bindValue(":location", rediscoveredFile.location());
+    ASSERT_TRUE(query.exec());
+
+    // The files that currently exist in the directory. Other files are
+    // ignored, they are added separately.
+    const QSet<QString> fileLocations = {
+            existingFile.location(),
+            rediscoveredFile.location(),
+            dir.filePath(QStringLiteral("added.mp3")),
+    };
+    QSet<QString> trackLocations;
+    EXPECT_THAT(trackDAO.updateTrackLocationsInDirectory(
+                        existingFile.locationPath(), fileLocations, &trackLocations),
+            UnorderedElementsAre(deletedId, rediscoveredId));
+    EXPECT_THAT(trackLocations,
+            UnorderedElementsAre(existingFile.location(),
+                    deletedFile.location(),
+                    rediscoveredFile.location()));
+    // Tracks in other directories are not affected
+    EXPECT_THAT(trackDAO.getAllMissingTrackLocations(),
+            UnorderedElementsAre(deletedFile.location()));
+
+    // Nothing has changed
+    trackLocations.clear();
+    EXPECT_TRUE(trackDAO.updateTrackLocationsInDirectory(
+                               existingFile.locationPath(), fileLocations, &trackLocations)
+                        .isEmpty());
+    EXPECT_EQ(3, trackLocations.size());
+}
@@ -0,0 +1,278 @@
+#ifdef USE_BENCH
+#include <benchmark/benchmark.h>
+#endif
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+#include <memory>
+
+#include "database/mixxxdb.h"
+#include "library/dao/trackschema.h"
+#include "library/dao/tracksearchindex.h"
+#include "library/searchquery.h"
+#include "test/mixxxdbtest.h"
+#include "util/db/sqltransaction.h"
+
+namespace {
+
+const QString kSearchView = QStringLiteral("track_search_view");
+
+const QStringList kSearchColumns = {
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        TRACKLOCATIONSTABLE_LOCATION,
+};
+
+// A reduced library_cache_view
+bool createSearchView(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    return query.exec(QStringLiteral(
+            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+            "SELECT library.id,library.artist,library.title,track_locations.location "
+            "FROM library "
+            "INNER JOIN track_locations ON library.location = track_locations.id")
+                              .arg(kSearchView));
+}
+
+class TrackInserter {
+  public:
+    explicit TrackInserter(const QSqlDatabase& database)
+            : m_locationInsert(database),
+              m_libraryInsert(database) {
+        m_locationInsert.prepare(QStringLiteral(
+                "INSERT INTO track_locations (id,location,filename,directory) "
+                "VALUES (:id,:location,:filename,'/music')"));
+        m_libraryInsert.prepare(QStringLiteral(
+                "INSERT INTO library (id,artist,title,location) "
+                "VALUES (:id,:artist,:title,:id)"));
+    }
+
+    bool insert(int id,
+            const QString& artist,
+            const QString& title,
+            const QString& fileName) {
+        m_locationInsert.bindValue(QStringLiteral(":id"), id);
+        m_locationInsert.bindValue(QStringLiteral(":location"),
+                QStringLiteral("/music/") + fileName);
+        m_locationInsert.bindValue(QStringLiteral(":filename"), fileName);
+        m_libraryInsert.bindValue(QStringLiteral(":id"), id);
+        m_libraryInsert.bindValue(QStringLiteral(":artist"), artist);
+        m_libraryInsert.bindValue(QStringLiteral(":title"), title);
+        return m_locationInsert.exec() && m_libraryInsert.exec();
+    }
+
+  private:
+    QSqlQuery m_locationInsert;
+    QSqlQuery m_libraryInsert;
+};
+
+QList<int> searchTrackIds(
+        const QSqlDatabase& database,
+        const QString& argument,
+        bool useSearchIndex,
+        bool negate = false) {
+    auto pNode = std::make_unique<TextFilterNode>(database, kSearchColumns, argument);
+    if (useSearchIndex) {
+        pNode->setSearchIndexIdColumn(LIBRARYTABLE_ID);
+    }
+    const QString sql = negate ? NotNode(std::move(pNode)).toSql() : pNode->toSql();
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    QList<int> trackIds;
+    if (!query.exec(QStringLiteral("SELECT id FROM %1 WHERE %2 ORDER BY id")
+                            .arg(kSearchView, sql))) {
+        return trackIds;
+    }
+    while (query.next()) {
+        trackIds.append(query.value(0).toInt());
+    }
+    return trackIds;
+}
+
+class TrackSearchIndexTest : public MixxxDbTest {
+  protected:
+    TrackSearchIndexTest()
+            : MixxxDbTest(true) {
+        const auto database = dbConnection();
+        EXPECT_TRUE(MixxxDb::initDatabaseSchema(database));
+        EXPECT_TRUE(createSearchView(database));
+        TrackInserter inserter(database);
+        inserter.insert(1, "Björk", "Army of Me", "bjork.mp3");
+        inserter.insert(2, "ABBA", "Waterloo", "abba.flac");
+        inserter.insert(3, QString(), "Untitled", "unknown_100%.ogg");
+        inserter.insert(4, "abba", "Mamma Mia", "mamma.mp3");
+        m_searchIndex.initialize(database);
+    }
+
+    /// Creates the index and updates all pending tracks synchronously.
+    bool createIndex() {
+        if (!m_searchIndex.createIfMissing()) {
+            return false;
+        }
+        EXPECT_FALSE(m_searchIndex.isAvailable());
+        EXPECT_TRUE(m_searchIndex.updatePendingTracks());
+        EXPECT_TRUE(m_searchIndex.isAvailable());
+        return true;
+    }
+
+    void expectSameResults(const QString& argument, bool negate = false) {
+        const auto database = dbConnection();
+        EXPECT_EQ(searchTrackIds(database, argument, false, negate),
+                searchTrackIds(database, argument, true, negate))
+                << (negate ? "-" : "") << argument.toStdString();
+    }
+
+    TrackSearchIndex m_searchIndex;
+};
+
+TEST_F(TrackSearchIndexTest, MatchQuery) {
+    EXPECT_EQ(QStringLiteral("{artist title} : (\"bjork\")"),
+            TrackSearchIndex::matchQuery(
+                    {LIBRARYTABLE_ARTIST, LIBRARYTABLE_TITLE}, "%Björk%"));
+    EXPECT_EQ(QStringLiteral("{title} : (\"abc\" AND \"d\"\"ef\")"),
+            TrackSearchIndex::matchQuery({LIBRARYTABLE_TITLE}, "%abc_d\"ef%xy%"));
+    // Too short
+    EXPECT_TRUE(TrackSearchIndex::matchQuery({LIBRARYTABLE_TITLE}, "%ab%").isNull());
+    // Not indexed
+    EXPECT_TRUE(TrackSearchIndex::matchQuery(
+            {LIBRARYTABLE_TITLE, LIBRARYTABLE_KEY}, "%abc%")
+                        .isNull());
+}
+
+TEST_F(TrackSearchIndexTest, SameResultsAsLike) {
+    if (!createIndex()) {
+        GTEST_SKIP() << "SQLite doesn't support FTS5 with the trigram tokenizer";
+    }
+    expectSameResults("bjork");
+    expectSameResults("BJÖRK");
+    expectSameResults("abba");
+    expectSameResults("mamma mia");
+    expectSameResults("a.f");
+    expectSameResults("/music/");
+    expectSameResults("100%.ogg");
+    expectSameResults("army_of");
+    expectSameResults("queen");
+}
+
+TEST_F(TrackSearchIndexTest, SameResultsAsNegatedLike) {
+    if (!createIndex()) {
+        GTEST_SKIP() << "SQLite doesn't support FTS5 with the trigram tokenizer";
+    }
+    // The artist of track 3 is NULL and neither matches nor doesn't match
+    const auto database = dbConnection();
+    EXPECT_EQ(QList<int>({2, 4}), searchTrackIds(database, "army", true, true));
+    expectSameResults("army", true);
+    expectSameResults("abba", true);
+    expectSameResults("untitled", true);
+    expectSameResults("queen", true);
+}
+
+TEST_F(TrackSearchIndexTest, UpdateAndRemove) {
+    if (!createIndex()) {
+        GTEST_SKIP() << "SQLite doesn't support FTS5 with the trigram tokenizer";
+    }
+    const auto database = dbConnection();
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE library SET title='Dancing Queen' WHERE id=2")));
+    EXPECT_EQ(QList<int>{}, searchTrackIds(database, "queen", true));
+    EXPECT_TRUE(m_searchIndex.updateTracks({TrackId(QVariant(2))}));
+    EXPECT_EQ(QList<int>{2}, searchTrackIds(database, "queen", true));
+
+    EXPECT_TRUE(m_searchIndex.removeTracks({TrackId(QVariant(4))}));
+    EXPECT_EQ(QList<int>{2}, searchTrackIds(database, "abba", true));
+
+    // Detected when reconnecting
+    EXPECT_TRUE(m_searchIndex.createIfMissing());
+    EXPECT_TRUE(m_searchIndex.updatePendingTracks());
+    EXPECT_EQ(QList<int>({2, 4}), searchTrackIds(database, "abba", true));
+}
+
+TEST_F(TrackSearchIndexTest, PendingTracks) {
+    if (!createIndex()) {
+        GTEST_SKIP() << "SQLite doesn't support FTS5 with the trigram tokenizer";
+    }
+    // Modifications that bypass the index, e.g. by a previous version
+    const auto database = dbConnection();
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE library SET artist='Queen' WHERE id=3")));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE track_locations SET location='/music/queen.mp3' WHERE id=4")));
+    ASSERT_TRUE(query.exec(QStringLiteral("DELETE FROM library WHERE id=1")));
+    ASSERT_TRUE(TrackInserter(database).insert(5, "Queen", "Bohemian Rhapsody", "queen.ogg"));
+    EXPECT_EQ(QList<int>{}, searchTrackIds(database, "queen", true));
+
+    // Small batches until nothing is pending
+    EXPECT_TRUE(m_searchIndex.createIfMissing());
+    EXPECT_FALSE(m_searchIndex.isAvailable());
+    EXPECT_TRUE(m_searchIndex.updatePendingTracks(4));
+    EXPECT_FALSE(m_searchIndex.isAvailable());
+    EXPECT_TRUE(m_searchIndex.updatePendingTracks(4));
+    EXPECT_TRUE(m_searchIndex.isAvailable());
+    EXPECT_EQ(QList<int>({3, 4, 5}), searchTrackIds(database, "queen", true));
+    expectSameResults("queen");
+    expectSameResults("army");
+    expectSameResults("abba");
+}
+
+#ifdef USE_BENCH
+// Searches a synthetic library with and without the index
+void BM_SearchLibrary(benchmark::State& state, bool useSearchIndex) {
+    const UserSettingsPointer pConfig(new UserSettings(
+            MixxxTest::getOrInitTestDir().filePath("tracksearchindex_bench.cfg")));
+    const MixxxDb mixxxDb(pConfig, true);
+    const mixxx::DbConnectionPooler dbConnectionPooler(mixxxDb.connectionPool());
+    const QSqlDatabase database = mixxx::DbConnectionPooled(mixxxDb.connectionPool());
+    if (!MixxxDb::initDatabaseSchema(database) || !createSearchView(database)) {
+        state.SkipWithError("Failed to initialize database");
+        return;
+    }
+
+    const QStringList words = {"deep", "house", "techno", "night", "love",
+            "dance", "remix", "original", "club", "dub", "vocal", "mix",
+            "summer", "dream", "light", "edit", "sound", "funk", "soul", "disco"};
+    const int numTracks = static_cast<int>(state.range(0));
+    {
+        SqlTransaction transaction(database);
+        TrackInserter inserter(database);
+        for (int i = 1; i <= numTracks; ++i) {
+            const QString artist = words[i % words.size()] + QChar(' ') +
+                    words[(i / 7) % words.size()];
+            const QString title = words[(i / 3) % words.size()] + QChar(' ') +
+                    words[(i / 11) % words.size()] + QChar(' ') +
+                    QString::number(i);
+            inserter.insert(i, artist, title, title + QStringLiteral(".mp3"));
+        }
+        transaction.commit();
+    }
+    TrackSearchIndex searchIndex;
+    searchIndex.initialize(database);
+    if (useSearchIndex) {
+        if (!searchIndex.createIfMissing()) {
+            state.SkipWithError("SQLite doesn't support FTS5 with the trigram tokenizer");
+            return;
+        }
+        while (!searchIndex.isAvailable()) {
+            if (!searchIndex.updatePendingTracks()) {
+                state.SkipWithError("Failed to update the index");
+                return;
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(searchTrackIds(database, "12345", useSearchIndex));
+    }
+}
+BENCHMARK_CAPTURE(BM_SearchLibrary, Like, false)
+        ->Arg(200000)
+        ->Iterations(10)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SearchLibrary, SearchIndex, true)
+        ->Arg(200000)
+        ->Iterations(10)
+        ->Unit(benchmark::kMillisecond);
+#endif // USE_BENCH
+
+} // namespace
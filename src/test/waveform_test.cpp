@@ -0,0 +1,255 @@
+#ifdef USE_BENCH
+#include <benchmark/benchmark.h>
+#endif
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "proto/waveform.pb.h"
+#include "util/math.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kVisualSampleRate = 441;
+
+// Fills the waveform with pseudo-random values and publishes the
+// completion in steps like AnalyzerWaveform.
+void fillWaveform(Waveform* pWaveform, int completionStep) {
+    WaveformData* pData = pWaveform->data();
+    unsigned int value = 1;
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        value = value * 1103515245 + 12345;
+        pData[i].filtered.all = static_cast<unsigned char>(value >> 8);
+        pData[i].filtered.low = static_cast<unsigned char>(value >> 12);
+        pData[i].filtered.mid = static_cast<unsigned char>(value >> 16);
+        pData[i].filtered.high = static_cast<unsigned char>(value >> 20);
+        for (int s = 0; s < mixxx::kMaxSupportedStems; ++s) {
+            pData[i].stems[s] = static_cast<unsigned char>(value >> (4 + s));
+        }
+        if ((i + 1) % completionStep == 0) {
+            pWaveform->setCompletion(i + 1);
+        }
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+}
+
+// The reference implementation that visits all data elements
+void bruteForceMaxima(const Waveform& waveform,
+        int frameStart,
+        int frameStop,
+        WaveformData* pMaxima) {
+    pMaxima[Left] = {};
+    pMaxima[Right] = {};
+    const int indexStop = math_min(frameStop * 2, waveform.getDataSize());
+    for (int i = math_max(frameStart * 2, 0); i < indexStop; ++i) {
+        const WaveformData& data = waveform.get(i);
+        WaveformData* pMax = &pMaxima[i % 2];
+        pMax->filtered.all = math_max(pMax->filtered.all, data.filtered.all);
+        pMax->filtered.low = math_max(pMax->filtered.low, data.filtered.low);
+        pMax->filtered.mid = math_max(pMax->filtered.mid, data.filtered.mid);
+        pMax->filtered.high = math_max(pMax->filtered.high, data.filtered.high);
+        for (int s = 0; s < mixxx::kMaxSupportedStems; ++s) {
+            pMax->stems[s] = math_max(pMax->stems[s], data.stems[s]);
+        }
+    }
+}
+
+void expectSameMaxima(const Waveform& waveform, int frameStart, int frameStop) {
+    WaveformData expected[ChannelCount];
+    bruteForceMaxima(waveform, frameStart, frameStop, expected);
+    WaveformData actual[ChannelCount];
+    waveform.getMaxima(frameStart, frameStop, actual);
+    for (int chn = 0; chn < ChannelCount; ++chn) {
+        EXPECT_EQ(expected[chn].filtered.all, actual[chn].filtered.all)
+                << frameStart << " " << frameStop << " " << chn;
+        EXPECT_EQ(expected[chn].filtered.low, actual[chn].filtered.low);
+        EXPECT_EQ(expected[chn].filtered.mid, actual[chn].filtered.mid);
+        EXPECT_EQ(expected[chn].filtered.high, actual[chn].filtered.high);
+        for (int s = 0; s < mixxx::kMaxSupportedStems; ++s) {
+            EXPECT_EQ(expected[chn].stems[s], actual[chn].stems[s]);
+        }
+    }
+}
+
+// Serializes the waveform in the protobuf format like Mixxx 2.6
+// pre-releases and earlier
+QByteArray toProtobufByteArray(const Waveform& waveform, int stemCount) {
+    mixxx::track::io::Waveform proto;
+    proto.set_visual_sample_rate(kVisualSampleRate);
+    proto.set_audio_visual_ratio(waveform.getAudioVisualRatio());
+    auto* pAll = proto.mutable_signal_all();
+    auto* pLow = proto.mutable_signal_filtered()->mutable_low();
+    auto* pMid = proto.mutable_signal_filtered()->mutable_mid();
+    auto* pHigh = proto.mutable_signal_filtered()->mutable_high();
+    for (int i = 0; i < waveform.getDataSize(); ++i) {
+        const WaveformData& data = waveform.get(i);
+        pAll->add_value(data.filtered.all);
+        pLow->add_value(data.filtered.low);
+        pMid->add_value(data.filtered.mid);
+        pHigh->add_value(data.filtered.high);
+    }
+    for (int s = 0; s < stemCount; ++s) {
+        auto* pStem = proto.add_signal_stems();
+        for (int i = 0; i < waveform.getDataSize(); ++i) {
+            pStem->add_value(waveform.get(i).stems[s]);
+        }
+    }
+    std::string output;
+    proto.SerializeToString(&output);
+    return QByteArray(output.data(), static_cast<int>(output.length()));
+}
+
+void expectSameData(const Waveform& expected, const Waveform& actual, int stemCount) {
+    ASSERT_EQ(expected.getDataSize(), actual.getDataSize());
+    EXPECT_EQ(expected.getAudioVisualRatio(), actual.getAudioVisualRatio());
+    EXPECT_EQ(stemCount > 0, actual.hasStem());
+    EXPECT_EQ(actual.getDataSize(), actual.getCompletion());
+    EXPECT_EQ(Waveform::SaveState::Saved, actual.saveState());
+    for (int i = 0; i < expected.getDataSize(); ++i) {
+        const WaveformData& expectedData = expected.get(i);
+        const WaveformData& actualData = actual.get(i);
+        ASSERT_EQ(expectedData.filtered.all, actualData.filtered.all) << i;
+        ASSERT_EQ(expectedData.filtered.low, actualData.filtered.low) << i;
+        ASSERT_EQ(expectedData.filtered.mid, actualData.filtered.mid) << i;
+        ASSERT_EQ(expectedData.filtered.high, actualData.filtered.high) << i;
+        for (int s = 0; s < stemCount; ++s) {
+            ASSERT_EQ(expectedData.stems[s], actualData.stems[s]) << i;
+        }
+    }
+}
+
+TEST(WaveformTest, ReadBinaryFormat) {
+    constexpr int kStemCount = 4;
+    Waveform waveform(kSampleRate, kSampleRate * 10, kVisualSampleRate, -1, kStemCount);
+    fillWaveform(&waveform, waveform.getDataSize());
+
+    const QByteArray data = waveform.toByteArray();
+    EXPECT_EQ(static_cast<int>(40 + waveform.getDataSize() * sizeof(WaveformData)),
+            data.size());
+    const Waveform restored(data);
+    expectSameData(waveform, restored, kStemCount);
+    EXPECT_EQ(data, restored.toByteArray());
+}
+
+TEST(WaveformTest, RejectTruncatedBinaryFormat) {
+    Waveform waveform(kSampleRate, kSampleRate * 10, kVisualSampleRate, -1, 0);
+    fillWaveform(&waveform, waveform.getDataSize());
+
+    QByteArray data = waveform.toByteArray();
+    data.chop(1);
+    const Waveform restored(data);
+    EXPECT_EQ(0, restored.getDataSize());
+    EXPECT_EQ(Waveform::SaveState::NotSaved, restored.saveState());
+}
+
+TEST(WaveformTest, UpgradeProtobufFormat) {
+    constexpr int kStemCount = 2;
+    Waveform waveform(kSampleRate, kSampleRate * 10, kVisualSampleRate, -1, kStemCount);
+    fillWaveform(&waveform, waveform.getDataSize());
+
+    // Stored in the protobuf format by Mixxx 2.6 pre-releases and earlier
+    const Waveform legacy(toProtobufByteArray(waveform, kStemCount));
+    expectSameData(waveform, legacy, kStemCount);
+
+    // Stored again in the current format
+    const Waveform upgraded(legacy.toByteArray());
+    expectSameData(waveform, upgraded, kStemCount);
+
+    EXPECT_EQ(WaveformFactory::VC_UPGRADE,
+            WaveformFactory::waveformVersionToVersionClass(
+                    WAVEFORM_PROTOBUF_VERSION));
+    EXPECT_EQ(WaveformFactory::VC_UPGRADE,
+            WaveformFactory::waveformSummaryVersionToVersionClass(
+                    WAVEFORMSUMMARY_PROTOBUF_VERSION));
+    EXPECT_EQ(WaveformFactory::VC_USE,
+            WaveformFactory::waveformVersionToVersionClass(
+                    WaveformFactory::currentWaveformVersion()));
+    EXPECT_EQ(WaveformFactory::VC_USE,
+            WaveformFactory::waveformSummaryVersionToVersionClass(
+                    WaveformFactory::currentWaveformSummaryVersion()));
+}
+
+TEST(WaveformTest, MaximaOfCompleteWaveform) {
+    // 3 minutes
+    Waveform waveform(kSampleRate, kSampleRate * 180, kVisualSampleRate, -1, 0);
+    fillWaveform(&waveform, 2);
+    const int frames = waveform.getDataSize() / 2;
+    ASSERT_GT(frames, 0);
+
+    for (int length : {1, 2, 3, 7, 64, 100, 1000, 4096, 12345}) {
+        for (int frameStart : {-3, 0, 1, 5, 511, 1024, frames - length, frames - 1}) {
+            expectSameMaxima(waveform, frameStart, frameStart + length);
+        }
+    }
+    expectSameMaxima(waveform, 0, frames);
+}
+
+TEST(WaveformTest, MaximaWhileAnalyzing) {
+    Waveform waveform(kSampleRate, kSampleRate * 60, kVisualSampleRate, -1, 0);
+    fillWaveform(&waveform, 2);
+    const int frames = waveform.getDataSize() / 2;
+
+    // Only the first part has been summarized
+    Waveform partialWaveform(kSampleRate, kSampleRate * 60, kVisualSampleRate, -1, 0);
+    std::copy(waveform.data(),
+            waveform.data() + waveform.getDataSize(),
+            partialWaveform.data());
+    partialWaveform.setCompletion(1234);
+    for (int frameStart : {0, 100, 600}) {
+        expectSameMaxima(partialWaveform, frameStart, frames);
+    }
+}
+
+#ifdef USE_BENCH
+void BM_WaveformMaxima(benchmark::State& state, bool bruteForce) {
+    // A long track, zoomed out to the whole track on a 4K screen
+    Waveform waveform(kSampleRate, kSampleRate * 600, kVisualSampleRate, -1, 0);
+    fillWaveform(&waveform, waveform.getDataSize());
+    const int frames = waveform.getDataSize() / 2;
+    const int pixels = static_cast<int>(state.range(0));
+    const double framesPerPixel = static_cast<double>(frames) / pixels;
+
+    for (auto _ : state) {
+        WaveformData maxima[ChannelCount];
+        for (int pos = 0; pos < pixels; ++pos) {
+            const int frameStart = static_cast<int>(pos * framesPerPixel);
+            const int frameStop = static_cast<int>((pos + 1) * framesPerPixel);
+            if (bruteForce) {
+                bruteForceMaxima(waveform, frameStart, frameStop, maxima);
+            } else {
+                waveform.getMaxima(frameStart, frameStop, maxima);
+            }
+            benchmark::DoNotOptimize(maxima);
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_WaveformMaxima, BruteForce, true)->Arg(3840);
+BENCHMARK_CAPTURE(BM_WaveformMaxima, Summary, false)->Arg(3840);
+
+void BM_WaveformLoad(benchmark::State& state, bool protobuf) {
+    // Loaded like AnalysisDao::getAnalysesForTrack()
+    Waveform waveform(kSampleRate,
+            kSampleRate * static_cast<int>(state.range(0)),
+            kVisualSampleRate,
+            -1,
+            0);
+    fillWaveform(&waveform, waveform.getDataSize());
+    const QByteArray compressedData = qCompress(protobuf
+                    ? toProtobufByteArray(waveform, 0)
+                    : waveform.toByteArray());
+
+    for (auto _ : state) {
+        Waveform restored(qUncompress(compressedData));
+        benchmark::DoNotOptimize(restored.data());
+    }
+    state.counters["compressedBytes"] = compressedData.size();
+}
+// 5 minutes
+BENCHMARK_CAPTURE(BM_WaveformLoad, Protobuf, true)->Arg(300);
+BENCHMARK_CAPTURE(BM_WaveformLoad, Binary, false)->Arg(300);
+#endif // USE_BENCH
+
+} // namespace
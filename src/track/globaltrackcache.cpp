@@ -1,6 +1,7 @@
 #include "track/globaltrackcache.h"
 
 #include <QCoreApplication>
+#include <vector>
 
 #include "moc_globaltrackcache.cpp"
 #include "track/track.h"
@@ -10,8 +11,6 @@
 
 namespace {
 
-constexpr std::size_t kUnorderedCollectionMinCapacity = 1024;
-
 const mixxx::Logger kLogger("GlobalTrackCache");
 
 //static
@@ -299,12 +298,65 @@ void GlobalTrackCache::evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cach
     }
 }
 
+//static
+TrackPointer GlobalTrackCache::lookupTrackById(
+        const TrackId& trackId) {
+    DEBUG_ASSERT(s_pInstance);
+    const auto entryPtr = s_pInstance->m_tracksById.find(trackId);
+    if (!entryPtr) {
+        // Cache miss
+        return {};
+    }
+    TrackPointer trackPtr = entryPtr->lockIfCompleted();
+    if (trackPtr) {
+        // Cache hit
+        return trackPtr;
+    }
+    // The track is either still loading or about to be evicted
+    return GlobalTrackCacheLocker().lookupTrackById(trackId);
+}
+
+//static
+TrackPointer GlobalTrackCache::lookupTrackByRef(
+        const TrackRef& trackRef) {
+    DEBUG_ASSERT(s_pInstance);
+    if (trackRef.hasId()) {
+        const auto entryPtr = s_pInstance->m_tracksById.find(trackRef.getId());
+        if (entryPtr) {
+            TrackPointer trackPtr = entryPtr->lockIfCompleted();
+            if (trackPtr) {
+                return trackPtr;
+            }
+            return GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+        }
+    }
+    if (trackRef.hasCanonicalLocation()) {
+        const auto entryPtr = s_pInstance->m_tracksByCanonicalLocation.find(
+                trackRef.getCanonicalLocation());
+        if (entryPtr) {
+            TrackPointer trackPtr = entryPtr->lockIfCompleted();
+            if (!trackPtr) {
+                return GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+            }
+            // Multiple tracks may reference the same physical file on disk
+            const auto cachedTrackRef = createTrackRef(*trackPtr);
+            if (trackRef.getLocation() == cachedTrackRef.getLocation()) {
+                return trackPtr;
+            }
+            kLogger.warning()
+                    << "Found a different track for the same canonical location:"
+                    << "requested =" << trackRef
+                    << "cached =" << cachedTrackRef;
+        }
+    }
+    return {};
+}
+
 GlobalTrackCache::GlobalTrackCache(
         GlobalTrackCacheSaver* pSaver,
         deleteTrackFn_t deleteTrackFn)
         : m_pSaver(pSaver),
-          m_deleteTrackFn(deleteTrackFn),
-          m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun) {
+          m_deleteTrackFn(deleteTrackFn) {
     DEBUG_ASSERT(m_pSaver);
     qRegisterMetaType<GlobalTrackCacheEntryPointer>("GlobalTrackCacheEntryPointer");
 }
@@ -319,13 +371,19 @@ void GlobalTrackCache::relocateTracks(
         kLogger.debug()
                 << "Relocating tracks";
     }
-    TracksByCanonicalLocation relocatedTracksByCanonicalLocation;
-    for (auto&&
-            i = m_tracksByCanonicalLocation.begin();
-            i != m_tracksByCanonicalLocation.end();
-            ++i) {
-        const QString oldCanonicalLocation = i->first;
-        Track* plainPtr = i->second->getPlainPtr();
+    // Relocating tracks requires database queries and might emit
+    // signals. The shards of the index must not be locked meanwhile.
+    std::vector<std::pair<QString, GlobalTrackCacheEntryPointer>> cachedEntries;
+    m_tracksByCanonicalLocation.forEach(
+            [&cachedEntries](const QString& canonicalLocation,
+                    const GlobalTrackCacheEntryPointer& entryPtr) {
+                cachedEntries.emplace_back(canonicalLocation, entryPtr);
+            });
+    // Only the entries of relocated tracks are replaced. All other
+    // entries remain accessible while relocating.
+    std::vector<std::pair<QString, GlobalTrackCacheEntryPointer>> relocatedEntries;
+    for (const auto& [oldCanonicalLocation, entryPtr] : cachedEntries) {
+        Track* plainPtr = entryPtr->getPlainPtr();
         const mixxx::FileInfo fileInfo = plainPtr->getFileInfo();
         TrackRef trackRef = TrackRef::fromFileInfo(fileInfo, plainPtr->getId());
         if (!trackRef.hasCanonicalLocation() && trackRef.hasId() && pRelocator) {
@@ -343,12 +401,12 @@ void GlobalTrackCache::relocateTracks(
                     << "Failed to relocate track"
                     << oldCanonicalLocation
                     << trackRef;
+            m_tracksByCanonicalLocation.erase(oldCanonicalLocation);
             continue;
         }
         QString newCanonicalLocation = trackRef.getCanonicalLocation();
         if (oldCanonicalLocation == newCanonicalLocation) {
-            // Copy the entry unmodified into the new map
-            relocatedTracksByCanonicalLocation.insert(*i);
+            // Keep the entry unmodified
             continue;
         }
         if (debugLogEnabled()) {
@@ -357,11 +415,12 @@ void GlobalTrackCache::relocateTracks(
                     << "from" << oldCanonicalLocation
                     << "to" << newCanonicalLocation;
         }
-        relocatedTracksByCanonicalLocation.insert(std::make_pair(
-                std::move(newCanonicalLocation),
-                i->second));
+        m_tracksByCanonicalLocation.erase(oldCanonicalLocation);
+        relocatedEntries.emplace_back(std::move(newCanonicalLocation), entryPtr);
+    }
+    for (auto& [newCanonicalLocation, entryPtr] : relocatedEntries) {
+        m_tracksByCanonicalLocation.insert(newCanonicalLocation, std::move(entryPtr));
     }
-    m_tracksByCanonicalLocation = std::move(relocatedTracksByCanonicalLocation);
 }
 
 void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
@@ -397,19 +456,28 @@ void GlobalTrackCache::deactivate() {
             << m_tracksByCanonicalLocation.size()
             << "tracks from cache";
 
-    while (!m_tracksById.empty()) {
-        auto i = m_tracksById.begin();
-        Track* plainPtr= i->second->getPlainPtr();
-        saveEvictedTrack(plainPtr);
-        m_tracksByCanonicalLocation.erase(plainPtr->getFileInfo().canonicalLocation());
-        m_tracksById.erase(i);
-    }
-
-    while (!m_tracksByCanonicalLocation.empty()) {
-        auto i = m_tracksByCanonicalLocation.begin();
-        Track* plainPtr= i->second->getPlainPtr();
-        saveEvictedTrack(plainPtr);
-        m_tracksByCanonicalLocation.erase(i);
+    // The shards of the index must not be locked while saving tracks
+    std::vector<GlobalTrackCacheEntryPointer> evictedEntries;
+    evictedEntries.reserve(m_tracksById.size());
+    m_tracksById.forEach(
+            [&evictedEntries](const TrackId&,
+                    const GlobalTrackCacheEntryPointer& entryPtr) {
+                evictedEntries.push_back(entryPtr);
+            });
+    m_tracksById.clear();
+    for (const auto& entryPtr : evictedEntries) {
+        m_tracksByCanonicalLocation.erase(
+                entryPtr->getPlainPtr()->getFileInfo().canonicalLocation());
+    }
+    m_tracksByCanonicalLocation.forEach(
+            [&evictedEntries](const QString&,
+                    const GlobalTrackCacheEntryPointer& entryPtr) {
+                evictedEntries.push_back(entryPtr);
+            });
+    m_tracksByCanonicalLocation.clear();
+
+    for (const auto& entryPtr : evictedEntries) {
+        saveEvictedTrack(entryPtr->getPlainPtr());
     }
 
     // Verify that all cached tracks have been evicted
@@ -443,16 +511,16 @@ TrackPointer GlobalTrackCache::lookupById(
     }
 
     TrackPointer trackPtr;
-    const auto trackById(m_tracksById.find(trackId));
-    if (m_tracksById.end() != trackById) {
+    const auto entryPtr = m_tracksById.find(trackId);
+    if (entryPtr) {
         // Cache hit
         if (traceLogEnabled()) {
             kLogger.trace()
                     << "Cache hit for"
                     << trackId
-                    << trackById->second->getPlainPtr();
+                    << entryPtr->getPlainPtr();
         }
-        trackPtr = revive(trackById->second);
+        trackPtr = revive(entryPtr);
         DEBUG_ASSERT(trackPtr);
     } else {
         // Cache miss
@@ -501,17 +569,16 @@ TrackPointer GlobalTrackCache::lookupByCanonicalLocation(
     }
 
     TrackPointer trackPtr;
-    const auto trackByCanonicalLocation(
-            m_tracksByCanonicalLocation.find(canonicalLocation));
-    if (m_tracksByCanonicalLocation.end() != trackByCanonicalLocation) {
+    const auto entryPtr = m_tracksByCanonicalLocation.find(canonicalLocation);
+    if (entryPtr) {
         // Cache hit
         if (traceLogEnabled()) {
             kLogger.trace()
                     << "Cache hit for"
                     << canonicalLocation
-                    << trackByCanonicalLocation->second->getPlainPtr();
+                    << entryPtr->getPlainPtr();
         }
-        trackPtr = revive(trackByCanonicalLocation->second);
+        trackPtr = revive(entryPtr);
         DEBUG_ASSERT(trackPtr);
     } else {
         // Cache miss
@@ -526,9 +593,11 @@ TrackPointer GlobalTrackCache::lookupByCanonicalLocation(
 
 QSet<TrackId> GlobalTrackCache::getCachedTrackIds() const {
     QSet<TrackId> trackIds;
-    for (const auto& entry : m_tracksById) {
-        trackIds << entry.first;
-    }
+    m_tracksById.forEach(
+            [&trackIds](const TrackId& trackId,
+                    const GlobalTrackCacheEntryPointer&) {
+                trackIds << trackId;
+            });
     return trackIds;
 }
 
@@ -670,21 +739,23 @@ void GlobalTrackCache::resolve(
                 << deletingPtr.get();
     }
 
+    // The new entry is not accessible without locking the cache
+    // until it has been completed, see discardIncompleteTrack().
     if (trackRef.hasId()) {
         // Insert item by id
-        DEBUG_ASSERT(m_tracksById.find(
-                trackRef.getId()) == m_tracksById.end());
-        m_tracksById.insert(std::make_pair(
+        const bool inserted = m_tracksById.insert(
                 trackRef.getId(),
-                cacheEntryPtr));
+                cacheEntryPtr);
+        Q_UNUSED(inserted); // only used in DEBUG_ASSERT
+        DEBUG_ASSERT(inserted);
     }
     if (trackRef.hasCanonicalLocation()) {
         // Insert item by track location
-        DEBUG_ASSERT(m_tracksByCanonicalLocation.find(
-                trackRef.getCanonicalLocation()) == m_tracksByCanonicalLocation.end());
-        m_tracksByCanonicalLocation.insert(std::make_pair(
+        const bool inserted = m_tracksByCanonicalLocation.insert(
                 trackRef.getCanonicalLocation(),
-                cacheEntryPtr));
+                cacheEntryPtr);
+        Q_UNUSED(inserted); // only used in DEBUG_ASSERT
+        DEBUG_ASSERT(inserted);
     }
 
     // Track objects live together with the cache on the main thread
@@ -779,19 +850,28 @@ TrackRef GlobalTrackCache::initTrackId(
     discardIncompleteTrack();
 
     // Insert item by id
-    DEBUG_ASSERT(m_tracksById.find(trackId) == m_tracksById.end());
-    m_tracksById.insert(std::make_pair(
+    const bool inserted = m_tracksById.insert(
             trackId,
-            pDel->getCacheEntryPointer()));
+            pDel->getCacheEntryPointer());
+    Q_UNUSED(inserted); // only used in DEBUG_ASSERT
+    DEBUG_ASSERT(inserted);
 
     strongPtr->initId(trackId);
     DEBUG_ASSERT(createTrackRef(*strongPtr) == trackRefWithId);
-    DEBUG_ASSERT(m_tracksById.find(trackId) != m_tracksById.end());
+    DEBUG_ASSERT(m_tracksById.find(trackId));
 
     return trackRefWithId;
 }
 
 void GlobalTrackCache::discardIncompleteTrack() {
+    if (m_incompleteTrack) {
+        // Temporary tracks are not cached and use a different deleter
+        const EvictAndSaveFunctor* pDel =
+                std::get_deleter<EvictAndSaveFunctor>(m_incompleteTrack);
+        if (pDel) {
+            pDel->getCacheEntryPointer()->complete();
+        }
+    }
     m_incompleteTrack = nullptr;
     m_isTrackCompleted.wakeAll();
 }
@@ -799,11 +879,11 @@ void GlobalTrackCache::discardIncompleteTrack() {
 void GlobalTrackCache::purgeTrackId(TrackId trackId) {
     DEBUG_ASSERT(trackId.isValid());
 
-    const auto trackById(m_tracksById.find(trackId));
-    if (m_tracksById.end() != trackById) {
-        Track* track = trackById->second->getPlainPtr();
+    const auto entryPtr = m_tracksById.find(trackId);
+    if (entryPtr) {
+        Track* track = entryPtr->getPlainPtr();
         track->resetId();
-        m_tracksById.erase(trackById);
+        m_tracksById.erase(trackId);
     }
 }
 
@@ -870,10 +950,10 @@ bool GlobalTrackCache::tryEvict(Track* plainPtr) {
                 << plainPtr;
     }
     if (trackRef.hasId()) {
-        const auto trackById = m_tracksById.find(trackRef.getId());
-        if (trackById != m_tracksById.end()) {
-            if (trackById->second->getPlainPtr() == plainPtr) {
-                m_tracksById.erase(trackById);
+        const auto entryPtr = m_tracksById.find(trackRef.getId());
+        if (entryPtr) {
+            if (entryPtr->getPlainPtr() == plainPtr) {
+                m_tracksById.erase(trackRef.getId());
                 evicted = true;
             } else {
                 notEvicted = true;
@@ -881,12 +961,12 @@ bool GlobalTrackCache::tryEvict(Track* plainPtr) {
         }
     }
     if (trackRef.hasCanonicalLocation()) {
-        const auto trackByCanonicalLocation(
-                m_tracksByCanonicalLocation.find(trackRef.getCanonicalLocation()));
-        if (m_tracksByCanonicalLocation.end() != trackByCanonicalLocation) {
-            if (trackByCanonicalLocation->second->getPlainPtr() == plainPtr) {
+        const auto entryPtr = m_tracksByCanonicalLocation.find(
+                trackRef.getCanonicalLocation());
+        if (entryPtr) {
+            if (entryPtr->getPlainPtr() == plainPtr) {
                 m_tracksByCanonicalLocation.erase(
-                        trackByCanonicalLocation);
+                        trackRef.getCanonicalLocation());
                 evicted = true;
             } else {
                 notEvicted = true;
@@ -900,15 +980,16 @@ bool GlobalTrackCache::tryEvict(Track* plainPtr) {
 }
 
 bool GlobalTrackCache::isCached(Track* plainPtr) const {
-    for (auto&& entry: m_tracksById) {
-        if (entry.second->getPlainPtr() == plainPtr) {
-            return true;
-        }
-    }
-    for (auto&& entry: m_tracksByCanonicalLocation) {
-        if (entry.second->getPlainPtr() == plainPtr) {
-              return true;
-        }
-    }
-    return false;
+    bool cached = false;
+    m_tracksById.forEach(
+            [plainPtr, &cached](const TrackId&,
+                    const GlobalTrackCacheEntryPointer& entryPtr) {
+                cached = cached || entryPtr->getPlainPtr() == plainPtr;
+            });
+    m_tracksByCanonicalLocation.forEach(
+            [plainPtr, &cached](const QString&,
+                    const GlobalTrackCacheEntryPointer& entryPtr) {
+                cached = cached || entryPtr->getPlainPtr() == plainPtr;
+            });
+    return cached;
 }
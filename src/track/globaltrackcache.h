@@ -1,8 +1,9 @@
 #pragma once
 
+#include <QHash>
+#include <QMutex>
 #include <QWaitCondition>
-#include <map>
-#include <unordered_map>
+#include <array>
 
 #include "track/track_decl.h"
 #include "track/trackref.h"
@@ -55,17 +56,25 @@ class GlobalTrackCacheEntry final {
 
     explicit GlobalTrackCacheEntry(
             std::unique_ptr<Track, TrackDeleter> deletingPtr)
-        : m_deletingPtr(std::move(deletingPtr)) {
+        : m_deletingPtr(std::move(deletingPtr)),
+          m_completed(false) {
     }
     GlobalTrackCacheEntry(const GlobalTrackCacheEntry& other) = delete;
-    GlobalTrackCacheEntry(GlobalTrackCacheEntry&&) = default;
 
     void init(TrackWeakPointer savingWeakPtr) {
+        const auto locker = lockMutex(&m_mutex);
         // Uninitialized or expired
         DEBUG_ASSERT(!m_savingWeakPtr.lock());
         m_savingWeakPtr = std::move(savingWeakPtr);
     }
 
+    /// Marks the track as completely loaded. Until then the track
+    /// is only accessible while the cache is locked.
+    void complete() {
+        const auto locker = lockMutex(&m_mutex);
+        m_completed = true;
+    }
+
     Track* getPlainPtr() const {
         return m_deletingPtr.get();
     }
@@ -77,13 +86,109 @@ class GlobalTrackCacheEntry final {
         return m_savingWeakPtr.expired();
     }
 
+    /// Returns the track if it is completely loaded and still alive.
+    /// Could be invoked without locking the cache.
+    TrackPointer lockIfCompleted() const {
+        const auto locker = lockMutex(&m_mutex);
+        if (!m_completed) {
+            return {};
+        }
+        return m_savingWeakPtr.lock();
+    }
+
   private:
     std::unique_ptr<Track, TrackDeleter> m_deletingPtr;
+
+    // Guards modifications while the entry is accessed without
+    // locking the cache.
+    mutable QMutex m_mutex;
     TrackWeakPointer m_savingWeakPtr;
+    bool m_completed;
 };
 
 typedef std::shared_ptr<GlobalTrackCacheEntry> GlobalTrackCacheEntryPointer;
 
+/// An index of cache entries that is striped into shards with separate
+/// locks. Modifications are only permitted while the cache is locked.
+/// Lookups only need to lock a single shard and could be performed
+/// concurrently without locking the cache.
+template<typename Key>
+class GlobalTrackCacheIndex final {
+  public:
+    GlobalTrackCacheEntryPointer find(const Key& key) const {
+        const Shard& shard = shardOf(key);
+        const auto locker = lockMutex(&shard.mutex);
+        return shard.entries.value(key);
+    }
+
+    /// Inserts the entry unless the key is already indexed, like
+    /// std::map::insert().
+    bool insert(const Key& key, GlobalTrackCacheEntryPointer entryPtr) {
+        Shard& shard = shardOf(key);
+        const auto locker = lockMutex(&shard.mutex);
+        if (shard.entries.contains(key)) {
+            return false;
+        }
+        shard.entries.insert(key, std::move(entryPtr));
+        return true;
+    }
+
+    bool erase(const Key& key) {
+        Shard& shard = shardOf(key);
+        const auto locker = lockMutex(&shard.mutex);
+        return shard.entries.remove(key) > 0;
+    }
+
+    void clear() {
+        for (auto& shard : m_shards) {
+            const auto locker = lockMutex(&shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+    /// Invokes fn(key, entryPtr) for all entries. The shards are locked
+    /// while iterating, i.e. fn must not access the index.
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (const auto& shard : m_shards) {
+            const auto locker = lockMutex(&shard.mutex);
+            for (auto i = shard.entries.constBegin(); i != shard.entries.constEnd(); ++i) {
+                fn(i.key(), i.value());
+            }
+        }
+    }
+
+    std::size_t size() const {
+        std::size_t size = 0;
+        for (const auto& shard : m_shards) {
+            const auto locker = lockMutex(&shard.mutex);
+            size += static_cast<std::size_t>(shard.entries.size());
+        }
+        return size;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+
+  private:
+    // Lookups of multiple threads rarely collide on the same shard.
+    static constexpr std::size_t kNumShards = 16;
+
+    struct Shard {
+        mutable QMutex mutex;
+        QHash<Key, GlobalTrackCacheEntryPointer> entries;
+    };
+
+    Shard& shardOf(const Key& key) {
+        return m_shards[qHash(key) % kNumShards];
+    }
+    const Shard& shardOf(const Key& key) const {
+        return m_shards[qHash(key) % kNumShards];
+    }
+
+    std::array<Shard, kNumShards> m_shards;
+};
+
 class GlobalTrackCacheLocker {
 public:
     GlobalTrackCacheLocker();
@@ -212,6 +317,17 @@ class GlobalTrackCache : public QObject {
     // See also: GlobalTrackCacheLocker::deactivateCache()
     static void destroyInstance();
 
+    /// Lookup an existing Track object in the cache without locking the
+    /// whole cache like GlobalTrackCacheLocker. Only the common case of
+    /// a track that is alive and completely loaded is handled directly.
+    /// Otherwise the lookup is delegated to GlobalTrackCacheLocker, e.g.
+    /// to wait until the track has been loaded or to revive a track that
+    /// is about to be evicted.
+    static TrackPointer lookupTrackById(
+            const TrackId& trackId);
+    static TrackPointer lookupTrackByRef(
+            const TrackRef& trackRef);
+
     // Deleter callbacks for the smart-pointer
     static void evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cacheEntryPtr);
 
@@ -286,10 +402,10 @@ class GlobalTrackCache : public QObject {
     QWaitCondition m_isTrackCompleted;
 
     // This caches the unsaved Tracks by ID
-    typedef std::unordered_map<TrackId, GlobalTrackCacheEntryPointer, TrackId::hash_fun_t> TracksById;
+    typedef GlobalTrackCacheIndex<TrackId> TracksById;
     TracksById m_tracksById;
 
     // This caches the unsaved Tracks by location
-    typedef std::map<QString, GlobalTrackCacheEntryPointer> TracksByCanonicalLocation;
+    typedef GlobalTrackCacheIndex<QString> TracksByCanonicalLocation;
     TracksByCanonicalLocation m_tracksByCanonicalLocation;
 };
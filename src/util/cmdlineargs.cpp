@@ -227,7 +227,9 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
 
     const QCommandLineOption timelinePath(QStringLiteral("timeline-path"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
-                                      "Path the debug statistics time line is written to")
+                                      "Path the debug statistics time line is "
+                                      "written to. Written as Chrome trace "
+                                      "JSON if the path ends with .json")
                             : QString(),
             QStringLiteral("path"));
     QCommandLineOption timelinePathDeprecated(
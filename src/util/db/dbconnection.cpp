@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlQuery>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -311,18 +312,38 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
     return true;
 }
 
+bool initReadOnlyAccess(const QSqlDatabase& database) {
+#ifdef __SQLITE3__
+    // Unlike SQLITE_OPEN_READONLY this also works for shared in-memory
+    // databases that are used for testing.
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA query_only=ON"))) {
+        kLogger.warning()
+                << "Failed to restrict database connection to read-only access"
+                << query.lastError();
+        return false;
+    }
+#else
+    Q_UNUSED(database);
+#endif // __SQLITE3__
+    return true;
+}
+
 } // anonymous namespace
 
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_sqlDatabase(createDatabase(params, connectionName)),
+      m_accessMode(AccessMode::ReadWrite) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
-        const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+        const QString& connectionName,
+        AccessMode accessMode)
+    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)),
+      m_accessMode(accessMode) {
 }
 
 DbConnection::~DbConnection() {
@@ -350,6 +371,11 @@ bool DbConnection::open() {
         m_sqlDatabase.close();
         return false; // abort
     }
+    if (m_accessMode == AccessMode::ReadOnly &&
+            !initReadOnlyAccess(m_sqlDatabase)) {
+        m_sqlDatabase.close();
+        return false; // abort
+    }
     return true;
 }
 
@@ -399,6 +425,17 @@ void DbConnection::makeStringLatinLow(QString* string) {
     makeLatinLow(string->data(), string->length());
 }
 
+//static
+int DbConnection::likeCompareLatinLowConverted(
+        const QString& pattern,
+        const QString& string,
+        QChar esc) {
+    return likeCompareInner(
+            pattern.constData(), pattern.length(),
+            string.constData(), string.length(),
+            esc);
+}
+
 QDebug operator<<(QDebug debug, const DbConnection& connection) {
     return debug
             << connection.name()
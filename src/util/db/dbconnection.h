@@ -22,6 +22,20 @@ class DbConnection final {
 
     static void makeStringLatinLow(QString* string);
 
+    // Same as likeCompareLatinLow() for a pattern and a string that
+    // have both already been converted by makeStringLatinLow().
+    static int likeCompareLatinLowConverted(
+            const QString& pattern,
+            const QString& string,
+            QChar esc = QChar());
+
+    enum class AccessMode {
+        ReadWrite,
+        // Rejects all modifications of the database. Intended for
+        // queries in worker threads that must never block writers.
+        ReadOnly,
+    };
+
     struct Params {
         QString type;
         QString connectOptions;
@@ -37,13 +51,18 @@ class DbConnection final {
             const QString& connectionName);
     DbConnection(
             const DbConnection& prototype,
-            const QString& connectionName);
+            const QString& connectionName,
+            AccessMode accessMode = AccessMode::ReadWrite);
     ~DbConnection();
 
     QString name() const {
         return m_sqlDatabase.connectionName();
     }
 
+    AccessMode accessMode() const {
+        return m_accessMode;
+    }
+
     bool open();
     void close();
 
@@ -63,6 +82,7 @@ class DbConnection final {
 
     QSqlDatabase m_sqlDatabase;
     mixxx::StringCollator m_collator;
+    AccessMode m_accessMode;
 };
 
 } // namespace mixxx
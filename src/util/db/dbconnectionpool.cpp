@@ -11,7 +11,8 @@ const Logger kLogger("DbConnectionPool");
 
 } // anonymous namespace
 
-bool DbConnectionPool::createThreadLocalConnection() {
+bool DbConnectionPool::createThreadLocalConnection(
+        DbConnection::AccessMode accessMode) {
     VERIFY_OR_DEBUG_ASSERT(!m_threadLocalConnections.hasLocalData()) {
         DEBUG_ASSERT(m_threadLocalConnections.localData());
         kLogger.critical()
@@ -25,7 +26,8 @@ bool DbConnectionPool::createThreadLocalConnection() {
             QString("%1-%2").arg(
                     m_prototypeConnection.name(),
                     QString::number(connectionIndex));
-    auto pConnection = std::make_unique<DbConnection>(m_prototypeConnection, indexedConnectionName);
+    auto pConnection = std::make_unique<DbConnection>(
+            m_prototypeConnection, indexedConnectionName, accessMode);
     if (!pConnection->open()) {
         kLogger.critical()
                 << "Failed to open thread-local database connection"
@@ -33,7 +33,13 @@ class DbConnectionPool final {
     // Prefer to use DbConnectionPooler instead of the
     // following functions. Only if there is no appropriate
     // scoping possible then use these functions directly.
-    bool createThreadLocalConnection();
+    //
+    // Worker threads that only need to read from the database should
+    // request a read-only connection. If the database is in WAL mode
+    // these readers never block and are never blocked by writers in
+    // other threads.
+    bool createThreadLocalConnection(
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite);
     void destroyThreadLocalConnection();
 
   private:
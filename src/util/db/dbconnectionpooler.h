@@ -17,7 +17,8 @@ namespace mixxx {
 class DbConnectionPooler final {
   public:
     explicit DbConnectionPooler(
-            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr());
+            DbConnectionPoolPtr pDbConnectionPool = DbConnectionPoolPtr(),
+            DbConnection::AccessMode accessMode = DbConnection::AccessMode::ReadWrite);
     DbConnectionPooler(const DbConnectionPooler&) = delete;
     DbConnectionPooler(DbConnectionPooler&&) = default;
     ~DbConnectionPooler();
@@ -9,7 +9,8 @@
 class Event {
   public:
     Event()
-            : m_type(Stat::UNSPECIFIED) {
+            : m_type(Stat::UNSPECIFIED),
+              m_value(0.0) {
     }
 
     typedef Stat::StatType EventType;
@@ -17,6 +18,8 @@ class Event {
     QString m_tag;
     EventType m_type;
     mixxx::Duration m_time;
+    // The reported value of stats that are tracked with Stat::TIMELINE
+    double m_value;
 
     static bool event(const QString& tag, Event::EventType type = Stat::EVENT) {
         return Stat::track(tag, type, Stat::experimentFlags(Stat::COUNT), 0.0);
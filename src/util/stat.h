@@ -75,6 +75,9 @@ class Stat {
         STATS_EXPERIMENT  = 0x0800,
         // Used for marking stats recorded in BASE mode.
         STATS_BASE        = 0x1000,
+        // Record every report in the timeline, if enabled.
+        // O(1) in time, O(n) in space where n is the # of reports.
+        TIMELINE          = 0x2000,
     };
     Q_DECLARE_FLAGS(ComputeFlags, ComputeTypes);
 
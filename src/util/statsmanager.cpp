@@ -1,6 +1,10 @@
 #include "util/statsmanager.h"
 
 #include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaType>
 #include <QTextStream>
 #include <QtDebug>
@@ -73,7 +77,7 @@ StatsManager::~StatsManager() {
     qDebug() << "=====================================";
 
     if (CmdlineArgs::Instance().getTimelineEnabled()) {
-        writeTimeline(CmdlineArgs::Instance().getTimelinePath());
+        writeTimeline(CmdlineArgs::Instance().getTimelinePath(), std::move(m_events));
     }
 }
 
@@ -103,7 +107,67 @@ QString humanizeNanos(qint64 nanos) {
     return QString("%1ns").arg(QString::number(nanos));
 }
 
-void StatsManager::writeTimeline(const QString& filename) {
+bool isEventType(Stat::StatType type) {
+    return type == Stat::EVENT ||
+            type == Stat::EVENT_START ||
+            type == Stat::EVENT_END;
+}
+
+// Writes the events in the Trace Event Format that can be opened with
+// chrome://tracing or https://ui.perfetto.dev
+void writeChromeTrace(QIODevice* pDevice, const QList<Event>& events) {
+    QJsonArray traceEvents;
+    // Each tag gets its own track, so start/end pairs of different tags
+    // don't need to be nested.
+    QHash<QString, int> tidsByTag;
+    for (const Event& event : events) {
+        int tid = tidsByTag.value(event.m_tag, -1);
+        if (tid < 0) {
+            tid = static_cast<int>(tidsByTag.size()) + 1;
+            tidsByTag.insert(event.m_tag, tid);
+            traceEvents.append(QJsonObject{
+                    {QStringLiteral("name"), QStringLiteral("thread_name")},
+                    {QStringLiteral("ph"), QStringLiteral("M")},
+                    {QStringLiteral("pid"), 1},
+                    {QStringLiteral("tid"), tid},
+                    {QStringLiteral("args"),
+                            QJsonObject{{QStringLiteral("name"), event.m_tag}}},
+            });
+        }
+        QJsonObject traceEvent{
+                {QStringLiteral("name"), event.m_tag},
+                {QStringLiteral("ts"), event.m_time.toDoubleMicros()},
+                {QStringLiteral("pid"), 1},
+                {QStringLiteral("tid"), tid},
+        };
+        switch (event.m_type) {
+        case Stat::EVENT_START:
+            traceEvent.insert(QStringLiteral("ph"), QStringLiteral("B"));
+            break;
+        case Stat::EVENT_END:
+            traceEvent.insert(QStringLiteral("ph"), QStringLiteral("E"));
+            break;
+        case Stat::EVENT:
+            traceEvent.insert(QStringLiteral("ph"), QStringLiteral("i"));
+            traceEvent.insert(QStringLiteral("s"), QStringLiteral("t"));
+            break;
+        default:
+            traceEvent.insert(QStringLiteral("ph"), QStringLiteral("C"));
+            traceEvent.insert(QStringLiteral("args"),
+                    QJsonObject{{QStringLiteral("value"), event.m_value}});
+            break;
+        }
+        traceEvents.append(traceEvent);
+    }
+    const QJsonObject trace{
+            {QStringLiteral("traceEvents"), traceEvents},
+            {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")},
+    };
+    pDevice->write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+}
+
+// static
+void StatsManager::writeTimeline(const QString& filename, QList<Event> events) {
     QFile timeline(filename);
     if (!timeline.open(QIODevice::WriteOnly | QIODevice::Text)) {
         qDebug() << "Could not open timeline file for writing:"
@@ -111,21 +175,27 @@ void StatsManager::writeTimeline(const QString& filename) {
         return;
     }
 
-    if (m_events.isEmpty()) {
+    if (events.isEmpty()) {
         qDebug() << "No events recorded.";
         return;
     }
 
     // Sort by time.
-    std::sort(m_events.begin(), m_events.end(), OrderByTime());
+    std::sort(events.begin(), events.end(), OrderByTime());
 
-    mixxx::Duration last_time = m_events[0].m_time;
+    if (filename.endsWith(QStringLiteral(".json"), Qt::CaseInsensitive)) {
+        writeChromeTrace(&timeline, events);
+        timeline.close();
+        return;
+    }
+
+    mixxx::Duration last_time = events[0].m_time;
 
     QMap<QString, qint64> startTimes;
     QMap<QString, qint64> endTimes;
 
     QTextStream out(&timeline);
-    foreach (const Event& event, m_events) {
+    foreach (const Event& event, events) {
         qint64 last_start = startTimes.value(event.m_tag, -1);
         qint64 last_end = endTimes.value(event.m_tag, -1);
 
@@ -155,7 +225,11 @@ void StatsManager::writeTimeline(const QString& filename) {
             << "+" << humanizeNanos(duration_since_last_start) << ","
             << "+" << humanizeNanos(duration_since_last_end) << ","
             << Stat::statTypeToString(event.m_type) << ","
-            << event.m_tag << "\n";
+            << event.m_tag;
+        if (!isEventType(event.m_type)) {
+            out << "," << event.m_value;
+        }
+        out << "\n";
         last_time = event.m_time;
     }
 
@@ -224,13 +298,13 @@ void StatsManager::processIncomingStatReports() {
             }
 
             if (CmdlineArgs::Instance().getTimelineEnabled() &&
-                    (report.type == Stat::EVENT ||
-                     report.type == Stat::EVENT_START ||
-                     report.type == Stat::EVENT_END)) {
+                    (isEventType(report.type) ||
+                            (report.compute & Stat::TIMELINE))) {
                 Event event;
                 event.m_tag = tag;
                 event.m_type = report.type;
                 event.m_time = mixxx::Duration::fromNanos(report.time);
+                event.m_value = report.value;
                 m_events.append(event);
             }
         }
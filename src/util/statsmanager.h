@@ -67,6 +67,10 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
         m_statsPipeCondition.wakeAll();
     }
 
+    // Writes the events in the Trace Event Format if the filename ends
+    // with .json and as CSV otherwise. Only public for testing.
+    static void writeTimeline(const QString& filename, QList<Event> events);
+
   signals:
     void statUpdated(const Stat& stat);
 
@@ -77,7 +81,6 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     void processIncomingStatReports();
     StatsPipe* getStatsPipeForThread();
     void onStatsPipeDestroyed(StatsPipe* pPipe);
-    void writeTimeline(const QString& filename);
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
@@ -29,6 +29,12 @@ class StringCollator {
         return m_collator.compare(s1, s2);
     }
 
+    /// Precompute the key for comparing a string repeatedly
+    /// with the same result as compare().
+    QCollatorSortKey sortKey(const QString& s) const {
+        return m_collator.sortKey(s);
+    }
+
   private:
     QCollator m_collator;
 };
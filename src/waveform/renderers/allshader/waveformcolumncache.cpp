@@ -0,0 +1,69 @@
+#include "waveform/renderers/allshader/waveformcolumncache.h"
+
+#include <cmath>
+#include <limits>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// Never a valid column index
+constexpr int kInvalidColumn = std::numeric_limits<int>::min();
+
+} // anonymous namespace
+
+namespace allshader {
+
+WaveformColumnCache::WaveformColumnCache()
+        : m_visualFramesPerColumn(0.0),
+          m_completion(-1) {
+}
+
+void WaveformColumnCache::update(const ConstWaveformPointer& pWaveform,
+        double visualFramesPerColumn,
+        int columnCount) {
+    const int completion = pWaveform ? pWaveform->getCompletion() : -1;
+    if (pWaveform == m_pWaveform &&
+            visualFramesPerColumn == m_visualFramesPerColumn &&
+            completion == m_completion &&
+            static_cast<std::size_t>(columnCount) == m_columns.size()) {
+        return;
+    }
+    m_pWaveform = pWaveform;
+    m_visualFramesPerColumn = visualFramesPerColumn;
+    m_completion = completion;
+    m_columns.assign(math_max(columnCount, 0), Column{kInvalidColumn, {}});
+}
+
+void WaveformColumnCache::reset() {
+    m_pWaveform.clear();
+    m_visualFramesPerColumn = 0.0;
+    m_completion = -1;
+    m_columns.clear();
+}
+
+const WaveformData* WaveformColumnCache::maxima(int column) {
+    DEBUG_ASSERT(m_pWaveform);
+    DEBUG_ASSERT(!m_columns.empty());
+    const int size = static_cast<int>(m_columns.size());
+    // The visible columns occupy distinct slots
+    int slot = column % size;
+    if (slot < 0) {
+        slot += size;
+    }
+    Column& entry = m_columns[slot];
+    if (entry.index != column) {
+        const double xVisualFrame = column * m_visualFramesPerColumn;
+        const double maxSamplingRange = m_visualFramesPerColumn / 2.0;
+        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
+        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
+        m_pWaveform->getMaxima(visualFrameStart,
+                math_max(visualFrameStop, visualFrameStart + 1),
+                entry.maxima);
+        entry.index = column;
+    }
+    return entry.maxima;
+}
+
+} // namespace allshader
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "waveform/waveform.h"
+
+namespace allshader {
+class WaveformColumnCache;
+} // namespace allshader
+
+/// Caches the maxima of the visual frames of the pixel columns of a
+/// renderer across frames.
+///
+/// Columns are identified by their index in the grid of visual frames
+/// that is aligned to the zoom, i.e. the column of a visual frame does
+/// not change while scrolling. The columns are stored in a ring buffer
+/// with one slot per visible column. When the view has only moved by a
+/// few pixels since the previous frame, only the newly exposed columns
+/// need to be looked up in the waveform.
+class allshader::WaveformColumnCache {
+  public:
+    WaveformColumnCache();
+
+    /// Prepares the cache for a frame with columnCount visible columns.
+    /// All columns are discarded if the waveform, its completion or the
+    /// number of visual frames per column has changed.
+    void update(const ConstWaveformPointer& pWaveform,
+            double visualFramesPerColumn,
+            int columnCount);
+
+    /// Discards all columns and releases the waveform, e.g. when
+    /// another track is loaded.
+    void reset();
+
+    /// Returns the maxima of the left and right channel of a column,
+    /// see Waveform::getMaxima(). Only valid until the next invocation.
+    const WaveformData* maxima(int column);
+
+  private:
+    struct Column {
+        int index;
+        WaveformData maxima[ChannelCount];
+    };
+
+    ConstWaveformPointer m_pWaveform;
+    double m_visualFramesPerColumn;
+    int m_completion;
+    std::vector<Column> m_columns;
+};
@@ -23,6 +23,11 @@ WaveformRendererFiltered::WaveformRendererFiltered(
 void WaveformRendererFiltered::onSetup(const QDomNode&) {
 }
 
+void WaveformRendererFiltered::onSetTrack() {
+    // Don't keep the waveform of the previous track alive
+    m_columnCache.reset();
+}
+
 void WaveformRendererFiltered::preprocess() {
     if (!preprocessInner()) {
         if (geometry().vertexCount() != 0) {
@@ -88,9 +93,9 @@ bool WaveformRendererFiltered::preprocessInner() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
+    // The column of the first pixel in the grid of visual frames
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    m_columnCache.update(waveform, visualIncrementPerPixel, pixelLength);
 
     const int numVerticesPerLine = 6; // 2 triangles
 
@@ -140,33 +145,20 @@ bool WaveformRendererFiltered::preprocessInner() {
                     numVerticesPerLine * (1 + pixelLength)},
             {geometry().vertexDataAs<Geometry::RGBColoredPoint2D>() +
                     numVerticesPerLine * (1 + pixelLength * 2)}};
-    const double maxSamplingRange = visualIncrementPerPixel / 2.0;
 
     for (int pos = 0; pos < pixelLength; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
+        // Maxima per channel, only looked up for newly exposed columns
+        const WaveformData* maxima = m_columnCache.maxima(firstColumn + pos);
 
         const float fpos = static_cast<float>(pos) * invDevicePixelRatio;
 
         // 3 bands, 2 channels
         float max[3][2]{};
-        uchar u8max[3][2]{};
         for (int chn = 0; chn < 2; chn++) {
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8max[0][chn] = math_max(u8max[0][chn], waveformData.filtered.low);
-                u8max[1][chn] = math_max(u8max[1][chn], waveformData.filtered.mid);
-                u8max[2][chn] = math_max(u8max[2][chn], waveformData.filtered.high);
-            }
             // Cast to float
-            max[0][chn] = static_cast<float>(u8max[0][chn]);
-            max[1][chn] = static_cast<float>(u8max[1][chn]);
-            max[2][chn] = static_cast<float>(u8max[2][chn]);
+            max[0][chn] = static_cast<float>(maxima[chn].filtered.low);
+            max[1][chn] = static_cast<float>(maxima[chn].filtered.mid);
+            max[2][chn] = static_cast<float>(maxima[chn].filtered.high);
         }
 
         // TODO: this can be optimized by using one geometrynode per band
@@ -184,8 +176,6 @@ bool WaveformRendererFiltered::preprocessInner() {
                             halfBreadth + heightFactor * max[bandIndex][1]},
                     {rgb[bandIndex]});
         }
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved ==
@@ -2,6 +2,7 @@
 
 #include "rendergraph/geometrynode.h"
 #include "util/class.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 namespace allshader {
@@ -17,12 +18,15 @@ class allshader::WaveformRendererFiltered final
 
     // Pure virtual from WaveformRendererSignalBase, not used
     void onSetup(const QDomNode& node) override;
+    void onSetTrack() override;
 
     // Virtuals for rendergraph::Node
     void preprocess() override;
 
   private:
     const bool m_bRgbStacked;
+    WaveformColumnCache m_columnCache;
+
     bool preprocessInner();
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererFiltered);
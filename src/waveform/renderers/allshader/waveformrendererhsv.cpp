@@ -21,6 +21,11 @@ WaveformRendererHSV::WaveformRendererHSV(WaveformWidgetRenderer* waveformWidget)
 void WaveformRendererHSV::onSetup(const QDomNode&) {
 }
 
+void WaveformRendererHSV::onSetTrack() {
+    // Don't keep the waveform of the previous track alive
+    m_columnCache.reset();
+}
+
 void WaveformRendererHSV::preprocess() {
     if (!preprocessInner()) {
         if (geometry().vertexCount() != 0) {
@@ -88,9 +93,9 @@ bool WaveformRendererHSV::preprocessInner() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
+    // The column of the first pixel in the grid of visual frames
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    m_columnCache.update(waveform, visualIncrementPerPixel, pixelLength);
 
     const int numVerticesPerLine = 6; // 2 triangles
 
@@ -109,15 +114,9 @@ bool WaveformRendererHSV::preprocessInner() {
                     static_cast<float>(m_axesColor_g),
                     static_cast<float>(m_axesColor_b)});
 
-    const double maxSamplingRange = visualIncrementPerPixel / 2.0;
-
     for (int pos = 0; pos < pixelLength; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
+        // Maxima per channel, only looked up for newly exposed columns
+        const WaveformData* maxima = m_columnCache.maxima(firstColumn + pos);
 
         const float fpos = static_cast<float>(pos) * invDevicePixelRatio;
 
@@ -128,26 +127,11 @@ bool WaveformRendererHSV::preprocessInner() {
         float maxAll[2]{};
 
         for (int chn = 0; chn < 2; chn++) {
-            // Find the max values for low, mid, high and all in the waveform data
-            uchar u8maxLow{};
-            uchar u8maxMid{};
-            uchar u8maxHigh{};
-            uchar u8maxAll{};
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxLow = math_max(u8maxLow, waveformData.filtered.low);
-                u8maxMid = math_max(u8maxMid, waveformData.filtered.mid);
-                u8maxHigh = math_max(u8maxHigh, waveformData.filtered.high);
-                u8maxAll = math_max(u8maxAll, waveformData.filtered.all);
-            }
-
             // Cast to float
-            maxLow[chn] = static_cast<float>(u8maxLow);
-            maxMid[chn] = static_cast<float>(u8maxMid);
-            maxHigh[chn] = static_cast<float>(u8maxHigh);
-            maxAll[chn] = static_cast<float>(u8maxAll);
+            maxLow[chn] = static_cast<float>(maxima[chn].filtered.low);
+            maxMid[chn] = static_cast<float>(maxima[chn].filtered.mid);
+            maxHigh[chn] = static_cast<float>(maxima[chn].filtered.high);
+            maxAll[chn] = static_cast<float>(maxima[chn].filtered.all);
         }
 
         float total{};
@@ -182,8 +166,6 @@ bool WaveformRendererHSV::preprocessInner() {
                 {static_cast<float>(color.redF()),
                         static_cast<float>(color.greenF()),
                         static_cast<float>(color.blueF())});
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved == vertexUpdater.index());
@@ -47,6 +47,11 @@ void WaveformRendererRGB::setHighColor(const QColor& highColor) {
 void WaveformRendererRGB::onSetup(const QDomNode&) {
 }
 
+void WaveformRendererRGB::onSetTrack() {
+    // Don't keep the waveform of the previous track alive
+    m_columnCache.reset();
+}
+
 void WaveformRendererRGB::preprocess() {
     if (!preprocessInner()) {
         if (geometry().vertexCount() != 0) {
@@ -127,9 +132,9 @@ bool WaveformRendererRGB::preprocessInner() {
     const float mid_b = static_cast<float>(m_rgbMidColor_b);
     const float high_b = static_cast<float>(m_rgbHighColor_b);
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
+    // The column of the first pixel in the grid of visual frames
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    m_columnCache.update(waveform, visualIncrementPerPixel, pixelLength);
 
     const int numVerticesPerLine = 6; // 2 triangles
 
@@ -150,15 +155,9 @@ bool WaveformRendererRGB::preprocessInner() {
                     static_cast<float>(m_axesColor_g),
                     static_cast<float>(m_axesColor_b)});
 
-    const double maxSamplingRange = visualIncrementPerPixel / 2.0;
-
     for (int pos = 0; pos < pixelLength; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
+        // Maxima per channel, only looked up for newly exposed columns
+        const WaveformData* maxima = m_columnCache.maxima(firstColumn + pos);
 
         const float fpos = static_cast<float>(pos) * invDevicePixelRatio;
 
@@ -173,15 +172,12 @@ bool WaveformRendererRGB::preprocessInner() {
             // In case we don't render individual color per channel, we use only
             // the first field of the arrays to perform signal max
             int signalChn = splitLeftRight ? chn : 0;
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxLow[signalChn] = math_max(u8maxLow[signalChn], waveformData.filtered.low);
-                u8maxMid[signalChn] = math_max(u8maxMid[signalChn], waveformData.filtered.mid);
-                u8maxHigh[signalChn] = math_max(u8maxHigh[signalChn], waveformData.filtered.high);
-                u8maxAllChn[chn] = math_max(u8maxAllChn[chn], waveformData.filtered.all);
-            }
+            const WaveformData& waveformData = maxima[chn];
+
+            u8maxLow[signalChn] = math_max(u8maxLow[signalChn], waveformData.filtered.low);
+            u8maxMid[signalChn] = math_max(u8maxMid[signalChn], waveformData.filtered.mid);
+            u8maxHigh[signalChn] = math_max(u8maxHigh[signalChn], waveformData.filtered.high);
+            u8maxAllChn[chn] = waveformData.filtered.all;
         }
         float maxAllChn[2]{static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
 
@@ -264,8 +260,6 @@ bool WaveformRendererRGB::preprocessInner() {
                                 blue});
             }
         }
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved == vertexUpdater.index());
@@ -2,6 +2,7 @@
 
 #include "rendergraph/geometrynode.h"
 #include "util/class.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 namespace allshader {
@@ -19,6 +20,7 @@ class allshader::WaveformRendererRGB final
 
     // Pure virtual from WaveformRendererSignalBase, not used
     void onSetup(const QDomNode& node) override;
+    void onSetTrack() override;
 
     bool supportsSlip() const override {
         return true;
@@ -37,6 +39,8 @@ class allshader::WaveformRendererRGB final
     bool m_isSlipRenderer;
     WaveformRendererSignalBase::Options m_options;
 
+    WaveformColumnCache m_columnCache;
+
     bool preprocessInner();
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererRGB);
@@ -21,6 +21,11 @@ WaveformRendererSimple::WaveformRendererSimple(
 void WaveformRendererSimple::onSetup(const QDomNode&) {
 }
 
+void WaveformRendererSimple::onSetTrack() {
+    // Don't keep the waveform of the previous track alive
+    m_columnCache.reset();
+}
+
 void WaveformRendererSimple::preprocess() {
     if (!preprocessInner()) {
         if (geometry().vertexCount() != 0) {
@@ -90,9 +95,9 @@ bool WaveformRendererSimple::preprocessInner() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
+    // The column of the first pixel in the grid of visual frames
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    m_columnCache.update(waveform, visualIncrementPerPixel, pixelLength);
 
     const int numVerticesPerLine = 6; // 2 triangles
 
@@ -111,33 +116,19 @@ bool WaveformRendererSimple::preprocessInner() {
                     static_cast<float>(m_axesColor_g),
                     static_cast<float>(m_axesColor_b)});
 
-    const double maxSamplingRange = visualIncrementPerPixel / 2.0;
-
     const QVector3D signalColor{static_cast<float>(m_signalColor_r),
             static_cast<float>(m_signalColor_g),
             static_cast<float>(m_signalColor_b)};
 
     for (int pos = 0; pos < pixelLength; ++pos) {
-        const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-        const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-        const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-        const int visualIndexStop =
-                std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
+        // Maxima per channel, only looked up for newly exposed columns
+        const WaveformData* maxima = m_columnCache.maxima(firstColumn + pos);
 
         const float fpos = static_cast<float>(pos) * invDevicePixelRatio;
 
         // - Per channel
-        uchar u8maxAllChn[2]{};
-        for (int chn = 0; chn < 2; chn++) {
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxAllChn[chn] = math_max(u8maxAllChn[chn], waveformData.filtered.all);
-            }
-        }
-        float maxAllChn[2]{static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
+        float maxAllChn[2]{static_cast<float>(maxima[Left].filtered.all),
+                static_cast<float>(maxima[Right].filtered.all)};
 
         // TODO: use two geometrynodes, with uniform material,
         // one for the axis, one for the signal
@@ -149,8 +140,6 @@ bool WaveformRendererSimple::preprocessInner() {
                 {fpos + halfPixelSize,
                         halfBreadth + heightFactor * maxAllChn[0]},
                 signalColor);
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved == vertexUpdater.index());
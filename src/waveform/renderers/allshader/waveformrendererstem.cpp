@@ -42,6 +42,11 @@ WaveformRendererStem::WaveformRendererStem(
 void WaveformRendererStem::onSetup(const QDomNode&) {
 }
 
+void WaveformRendererStem::onSetTrack() {
+    // Don't keep the waveform of the previous track alive
+    m_columnCache.reset();
+}
+
 bool WaveformRendererStem::init() {
     for (int stemIdx = 0; stemIdx < mixxx::kMaxSupportedStems; stemIdx++) {
         QString stemGroup = EngineDeck::getGroupForStem(m_waveformRenderer->getGroup(), stemIdx);
@@ -129,9 +134,9 @@ bool WaveformRendererStem::preprocessInner() {
 
     const float heightFactor = allGain * halfBreadth / m_maxValue;
 
-    // Effective visual frame for x
-    double xVisualFrame = qRound(firstVisualFrame / visualIncrementPerPixel) *
-            visualIncrementPerPixel;
+    // The column of the first pixel in the grid of visual frames
+    const int firstColumn = qRound(firstVisualFrame / visualIncrementPerPixel);
+    m_columnCache.update(waveform, visualIncrementPerPixel, stripLength);
 
     const int numVerticesPerLine = 6; // 2 triangles
 
@@ -149,9 +154,10 @@ bool WaveformRendererStem::preprocessInner() {
                     m_isSlipRenderer ? halfBreadth : halfBreadth + 0.5f},
             {0.f, 0.f, 0.f, 0.f});
 
-    const double maxSamplingRange = visualIncrementPerPixel / 2.0;
-
     for (int visualIdx = 0; visualIdx < stripLength; visualIdx++) {
+        // Maxima per channel, only looked up for newly exposed columns
+        const WaveformData* maxima = m_columnCache.maxima(firstColumn + visualIdx);
+
         for (int stemIdx = 0; stemIdx < mixxx::kMaxSupportedStems; stemIdx++) {
             // Stem is drawn twice with different opacity level, this allow to
             // see the maximum signal by transparency
@@ -161,26 +167,11 @@ bool WaveformRendererStem::preprocessInner() {
                       color_g = stemColor.greenF(),
                       color_b = stemColor.blueF(),
                       color_a = stemColor.alphaF() * (layerIdx ? 0.75f : 0.15f);
-                const int visualFrameStart = std::lround(xVisualFrame - maxSamplingRange);
-                const int visualFrameStop = std::lround(xVisualFrame + maxSamplingRange);
-
-                const int visualIndexStart = std::max(visualFrameStart * 2, 0);
-                const int visualIndexStop =
-                        std::min(std::max(visualFrameStop, visualFrameStart + 1) * 2, dataSize - 1);
-
                 const float fVisualIdx = static_cast<float>(visualIdx) * invDevicePixelRatio;
 
-                // Find the max values for current eq in the waveform data.
-                // - Max of left and right
-                uchar u8max{};
-                for (int chn = 0; chn < 2; chn++) {
-                    // data is interleaved left / right
-                    for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                        const WaveformData& waveformData = data[i];
-
-                        u8max = math_max(u8max, waveformData.stems[stemIdx]);
-                    }
-                }
+                // Max of left and right
+                const uchar u8max = math_max(
+                        maxima[Left].stems[stemIdx], maxima[Right].stems[stemIdx]);
 
                 // Cast to float
                 float max = static_cast<float>(u8max);
@@ -208,8 +199,6 @@ bool WaveformRendererStem::preprocessInner() {
                         {color_r, color_g, color_b, color_a});
             }
         }
-
-        xVisualFrame += visualIncrementPerPixel;
     }
 
     DEBUG_ASSERT(reserved == vertexUpdater.index());
@@ -5,6 +5,7 @@
 #include "control/pollingcontrolproxy.h"
 #include "rendergraph/geometrynode.h"
 #include "util/class.h"
+#include "waveform/renderers/allshader/waveformcolumncache.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
 
 class QOpenGLTexture;
@@ -23,6 +24,7 @@ class allshader::WaveformRendererStem final
 
     // Pure virtual from WaveformRendererSignalBase, not used
     void onSetup(const QDomNode& node) override;
+    void onSetTrack() override;
 
     bool init() override;
 
@@ -45,6 +47,8 @@ class allshader::WaveformRendererStem final
     std::vector<std::unique_ptr<PollingControlProxy>> m_pStemGain;
     std::vector<std::unique_ptr<PollingControlProxy>> m_pStemMute;
 
+    WaveformColumnCache m_columnCache;
+
     bool preprocessInner();
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererStem);
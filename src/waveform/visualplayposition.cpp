@@ -3,8 +3,18 @@
 #include "moc_visualplayposition.cpp"
 #include "util/cmdlineargs.h"
 #include "util/math.h"
+#include "util/statsmanager.h"
+#include "util/timer.h"
 #include "waveform/isynctimeprovider.h"
 
+namespace {
+
+// Every report is recorded in the timeline to find the origin of jitter
+constexpr Stat::ComputeFlags kFrameTimingComputeFlags =
+        kDefaultComputeFlags | Stat::TIMELINE;
+
+} // anonymous namespace
+
 //static
 QMap<QString, QWeakPointer<VisualPlayPosition>> VisualPlayPosition::m_listVisualPlayPosition;
 PerformanceTimer VisualPlayPosition::m_timeInfoTime;
@@ -13,7 +23,13 @@ double VisualPlayPosition::m_dCallbackEntryToDacSecs = 0;
 VisualPlayPosition::VisualPlayPosition(const QString& key)
         : m_valid{false},
           m_key{key},
-          m_noTransport{false} {
+          m_noTransport{false},
+          m_callbackToDisplayStatKey{
+                  QStringLiteral("VisualPlayPosition %1 callback to display")
+                          .arg(key)},
+          m_interpolationErrorStatKey{
+                  QStringLiteral("VisualPlayPosition %1 interpolation error")
+                          .arg(key)} {
 }
 
 VisualPlayPosition::~VisualPlayPosition() {
@@ -51,16 +67,56 @@ void VisualPlayPosition::set(
     data.m_tempoTrackSeconds = tempoTrackSeconds;
     data.m_audioBufferMicroS = audioBufferMicroS;
 
+    if (StatsManager::s_bStatsManagerEnabled && m_valid.load()) {
+        trackInterpolationError(m_data.getValue(), data);
+    }
+
     // Atomic write
     m_data.setValue(data);
     m_valid.store(true);
 }
 
+void VisualPlayPosition::trackInterpolationError(
+        const VisualPlayPositionData& previous,
+        const VisualPlayPositionData& data) const {
+    if (previous.m_audioBufferMicroS == 0.0 ||
+            previous.m_positionStep == 0.0 ||
+            previous.m_playRate == 0.0) {
+        return;
+    }
+    const double elapsedMicros =
+            data.m_referenceTime.difference(previous.m_referenceTime).toDoubleMicros();
+    if (elapsedMicros <= 0.0) {
+        return;
+    }
+    // The position that would have been interpolated from the previous
+    // buffer for the callback of this buffer, like in getAtNextVSync()
+    const double predictedPlayPos = previous.m_playPos +
+            previous.m_positionStep * elapsedMicros /
+                    previous.m_audioBufferMicroS * previous.m_playRate;
+    // The deviation in real time, positive if the waveforms were ahead
+    const double errorMicros = (predictedPlayPos - data.m_playPos) /
+            (previous.m_positionStep * previous.m_playRate) *
+            previous.m_audioBufferMicroS;
+    if (std::abs(errorMicros) > previous.m_audioBufferMicroS) {
+        // Caused by seeking, looping or a changed rate, not by jitter
+        return;
+    }
+    Stat::track(m_interpolationErrorStatKey,
+            Stat::DURATION_NANOSEC,
+            Stat::experimentFlags(kFrameTimingComputeFlags),
+            errorMicros * 1000);
+}
+
 double VisualPlayPosition::calcOffsetAtNextVSync(
         VSyncTimeProvider* pSyncTimeProvider, const VisualPlayPositionData& data) {
     if (data.m_audioBufferMicroS != 0.0) {
         int refToVSync = pSyncTimeProvider->fromTimerToNextSync(data.m_referenceTime).count();
         int syncIntervalTimeMicros = pSyncTimeProvider->getSyncInterval().count();
+        Stat::track(m_callbackToDisplayStatKey,
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kFrameTimingComputeFlags),
+                refToVSync * 1000.0);
         // The positive offset is limited to the audio buffer + 2 x waveform sync interval
         // This should be sufficient to compensate jitter, but does not continue
         // in case of underflows.
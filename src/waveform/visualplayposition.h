@@ -94,11 +94,17 @@ class VisualPlayPosition : public QObject {
   private:
     double calcOffsetAtNextVSync(VSyncTimeProvider* pSyncTimeProvider,
             const VisualPlayPositionData& data);
+    void trackInterpolationError(const VisualPlayPositionData& previous,
+            const VisualPlayPositionData& data) const;
     ControlValueAtomic<VisualPlayPositionData> m_data;
     std::atomic<bool> m_valid;
     QString m_key;
     bool m_noTransport;
 
+    // Frame timing stats, only tracked in developer mode
+    const QString m_callbackToDisplayStatKey;
+    const QString m_interpolationErrorStatKey;
+
     static QMap<QString, QWeakPointer<VisualPlayPosition>> m_listVisualPlayPosition;
     // Time info from the Sound device, updated just after audio callback is called
     static double m_dCallbackEntryToDacSecs;
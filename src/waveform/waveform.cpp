@@ -1,10 +1,16 @@
 #include "waveform/waveform.h"
 
 #include <QtDebug>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 #include "analyzer/constants.h"
 #include "engine/engine.h"
 #include "proto/waveform.pb.h"
+#include "util/assert.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
@@ -18,6 +24,57 @@ int computeTextureStride(int size) {
     return stride;
 }
 
+namespace {
+
+// The binary format starts with a fixed-size header. All numbers are
+// stored in little-endian byte order. The data elements are stored in
+// their in-memory layout and can be copied as a whole.
+constexpr char kBinaryFormatMagic[4] = {'M', 'X', 'W', 'F'};
+constexpr quint32 kBinaryFormatVersion = 1;
+constexpr int kBinaryHeaderSize = 40;
+
+static_assert(sizeof(WaveformData) == 4 + mixxx::kMaxSupportedStems,
+        "WaveformData must not contain padding");
+static_assert(std::is_trivially_copyable_v<WaveformData>);
+
+void appendUInt32(QByteArray* pData, quint32 value) {
+    const quint32 littleEndian = qToLittleEndian(value);
+    pData->append(reinterpret_cast<const char*>(&littleEndian), sizeof(littleEndian));
+}
+
+void appendDouble(QByteArray* pData, double value) {
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const quint64 littleEndian = qToLittleEndian(bits);
+    pData->append(reinterpret_cast<const char*>(&littleEndian), sizeof(littleEndian));
+}
+
+quint32 readUInt32(const char** ppData) {
+    const quint32 value = qFromLittleEndian<quint32>(*ppData);
+    *ppData += sizeof(value);
+    return value;
+}
+
+double readDouble(const char** ppData) {
+    const quint64 bits = qFromLittleEndian<quint64>(*ppData);
+    *ppData += sizeof(bits);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline void storeMaxima(WaveformData* pMaxima, const WaveformData& data) {
+    pMaxima->filtered.low = std::max(pMaxima->filtered.low, data.filtered.low);
+    pMaxima->filtered.mid = std::max(pMaxima->filtered.mid, data.filtered.mid);
+    pMaxima->filtered.high = std::max(pMaxima->filtered.high, data.filtered.high);
+    pMaxima->filtered.all = std::max(pMaxima->filtered.all, data.filtered.all);
+    for (int i = 0; i < mixxx::kMaxSupportedStems; ++i) {
+        pMaxima->stems[i] = std::max(pMaxima->stems[i], data.stems[i]);
+    }
+}
+
+} // anonymous namespace
+
 Waveform::Waveform(const QByteArray& data)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
@@ -25,6 +82,7 @@ Waveform::Waveform(const QByteArray& data)
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
+          m_summarizedFrames(0),
           m_completion(-1) {
     readByteArray(data);
 }
@@ -41,6 +99,7 @@ Waveform::Waveform(
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(1024),
+          m_summarizedFrames(0),
           m_completion(-1),
           m_stemCount(stemCount) {
     int numberOfVisualSamples = 0;
@@ -76,86 +135,98 @@ Waveform::Waveform(
 Waveform::~Waveform() {
 }
 
-QByteArray Waveform::toByteArray() const {
-    io::Waveform waveform;
-    waveform.set_visual_sample_rate(m_visualSampleRate);
-    waveform.set_audio_visual_ratio(m_audioVisualRatio);
-
-    io::Waveform::Signal* all = waveform.mutable_signal_all();
-    io::Waveform::FilteredSignal* filtered = waveform.mutable_signal_filtered();
-
-    QList<io::Waveform::Signal*> stems;
-    for (int i = 0; i < m_stemCount; i++) {
-        stems.append(waveform.add_signal_stems());
-    }
-    // TODO(rryan) get the actual cutoff values from analyzerwaveform.cpp so
-    // that if they change we don't have to remember to update these.
-
-    // Frequency cutoffs for butterworth filters:
-    // filtered->set_low_cutoff_frequency(200);
-    // filtered->set_mid_low_cutoff_frequency(200);
-    // filtered->set_mid_high_cutoff_frequency(2000);
-    // filtered->set_high_cutoff_frequency(2000);
-
-    // Frequency cutoff for bessel_lowpass4
-    filtered->set_low_cutoff_frequency(600);
-    // Frequency cutoff for bessel_bandpass
-    filtered->set_mid_low_cutoff_frequency(600);
-    filtered->set_mid_high_cutoff_frequency(4000);
-    // Frequency cutoff for bessel_highpass4
-    filtered->set_high_cutoff_frequency(4000);
-
-    io::Waveform::Signal* low = filtered->mutable_low();
-    io::Waveform::Signal* mid = filtered->mutable_mid();
-    io::Waveform::Signal* high = filtered->mutable_high();
-
-    // TODO(vrince) set max/min for each signal
-    all->set_units(io::Waveform::RMS);
-    all->set_channels(mixxx::kEngineChannelOutputCount);
-    low->set_units(io::Waveform::RMS);
-    low->set_channels(mixxx::kEngineChannelOutputCount);
-    mid->set_units(io::Waveform::RMS);
-    mid->set_channels(mixxx::kEngineChannelOutputCount);
-    high->set_units(io::Waveform::RMS);
-    high->set_channels(mixxx::kEngineChannelOutputCount);
-
-    int dataSize = getDataSize();
-    for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
-        all->add_value(datum.filtered.all);
-        low->add_value(datum.filtered.low);
-        mid->add_value(datum.filtered.mid);
-        high->add_value(datum.filtered.high);
-    }
-
-    int stemIdx = 0;
-    for (auto& stem : stems) {
-        stem->set_units(io::Waveform::RMS);
-        stem->set_channels(mixxx::kEngineChannelOutputCount);
-        for (int i = 0; i < dataSize; ++i) {
-            const WaveformData& datum = m_data.at(i);
-            stem->add_value(datum.stems[stemIdx]);
-        }
-        stemIdx++;
-    }
+void Waveform::setCompletion(int completion) {
+    updateSummary(completion);
+    m_completion.storeRelease(completion);
+}
 
-    qDebug() << "Writing waveform from byte array:"
+QByteArray Waveform::toByteArray() const {
+    const int dataSize = getDataSize();
+    const int dataBytes = dataSize * static_cast<int>(sizeof(WaveformData));
+    QByteArray data;
+    data.reserve(kBinaryHeaderSize + dataBytes);
+    data.append(kBinaryFormatMagic, sizeof(kBinaryFormatMagic));
+    appendUInt32(&data, kBinaryFormatVersion);
+    appendUInt32(&data, sizeof(WaveformData));
+    appendUInt32(&data, dataSize);
+    appendUInt32(&data, m_stemCount);
+    // Reserved, aligns the following fields
+    appendUInt32(&data, 0);
+    appendDouble(&data, m_visualSampleRate);
+    appendDouble(&data, m_audioVisualRatio);
+    DEBUG_ASSERT(data.size() == kBinaryHeaderSize);
+    data.append(reinterpret_cast<const char*>(m_data.data()), dataBytes);
+
+    qDebug() << "Writing waveform to byte array:"
              << "dataSize" << dataSize
              << "stemCount" << m_stemCount
-             << "allSignalSize" << all->value_size()
-             << "visualSampleRate" << waveform.visual_sample_rate()
-             << "audioVisualRatio" << waveform.audio_visual_ratio();
-
-    std::string output;
-    waveform.SerializeToString(&output);
-    return QByteArray(output.data(), static_cast<int>(output.length()));
+             << "visualSampleRate" << m_visualSampleRate
+             << "audioVisualRatio" << m_audioVisualRatio;
+    return data;
 }
 
 void Waveform::readByteArray(const QByteArray& data) {
     if (data.isNull()) {
         return;
     }
+    if (data.startsWith(QByteArray::fromRawData(
+                kBinaryFormatMagic, sizeof(kBinaryFormatMagic)))) {
+        readBinaryByteArray(data);
+    } else {
+        // Stored in the protobuf format by Mixxx 2.6 pre-releases and earlier
+        readProtobufByteArray(data);
+    }
+}
+
+void Waveform::readBinaryByteArray(const QByteArray& data) {
+    if (data.size() < kBinaryHeaderSize) {
+        qDebug() << "ERROR: Waveform header is truncated:" << data.size() << "bytes";
+        return;
+    }
+    const char* pHeader = data.constData() + sizeof(kBinaryFormatMagic);
+    const quint32 formatVersion = readUInt32(&pHeader);
+    const quint32 elementSize = readUInt32(&pHeader);
+    const quint32 dataSize = readUInt32(&pHeader);
+    const quint32 stemCount = readUInt32(&pHeader);
+    readUInt32(&pHeader); // reserved
+    const double visualSampleRate = readDouble(&pHeader);
+    const double audioVisualRatio = readDouble(&pHeader);
+    DEBUG_ASSERT(pHeader == data.constData() + kBinaryHeaderSize);
+
+    if (formatVersion != kBinaryFormatVersion || elementSize != sizeof(WaveformData)) {
+        qDebug() << "ERROR: Unsupported waveform format version" << formatVersion
+                 << "with element size" << elementSize;
+        return;
+    }
+    if (stemCount > static_cast<quint32>(mixxx::kMaxSupportedStems) ||
+            static_cast<qint64>(dataSize) * elementSize !=
+                    data.size() - kBinaryHeaderSize) {
+        qDebug() << "ERROR: Waveform data does not match header."
+                 << "dataSize" << dataSize
+                 << "stemCount" << stemCount
+                 << "bytes" << data.size();
+        return;
+    }
+
+    qDebug() << "Reading waveform from byte array:"
+             << "dataSize" << dataSize
+             << "stemCount" << stemCount
+             << "visualSampleRate" << visualSampleRate
+             << "audioVisualRatio" << audioVisualRatio;
+
+    resize(static_cast<int>(dataSize));
+    m_visualSampleRate = visualSampleRate;
+    m_audioVisualRatio = audioVisualRatio;
+    m_stemCount = static_cast<int>(stemCount);
+    std::memcpy(m_data.data(),
+            data.constData() + kBinaryHeaderSize,
+            dataSize * sizeof(WaveformData));
+
+    setCompletion(static_cast<int>(dataSize));
+    m_saveState = SaveState::Saved;
+}
 
+void Waveform::readProtobufByteArray(const QByteArray& data) {
     io::Waveform waveform;
 
     if (!waveform.ParseFromArray(data.constData(), data.size())) {
@@ -234,7 +305,7 @@ void Waveform::readByteArray(const QByteArray& data) {
         }
     }
 
-    m_completion = dataSize;
+    setCompletion(dataSize);
     m_saveState = SaveState::Saved;
 }
 
@@ -242,15 +313,78 @@ void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    allocateSummary();
 }
 
 void Waveform::assign(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, {});
+    allocateSummary();
     m_saveState = SaveState::SavePending;
 }
 
+void Waveform::allocateSummary() {
+    const int frames = m_dataSize / ChannelCount;
+    m_summaryLevelOffsets.clear();
+    int summarySize = 0;
+    for (int level = 1; (frames >> level) > 0; ++level) {
+        m_summaryLevelOffsets.push_back(summarySize);
+        summarySize += (frames >> level) * ChannelCount;
+    }
+    m_summary.assign(summarySize, {});
+    m_summarizedFrames = 0;
+}
+
+void Waveform::updateSummary(int completion) {
+    const int frames = math_min(completion, m_dataSize) / ChannelCount;
+    if (frames <= m_summarizedFrames) {
+        return;
+    }
+    const WaveformData* pLowerLevel = m_data.data();
+    for (std::size_t i = 0; i < m_summaryLevelOffsets.size(); ++i) {
+        const int level = static_cast<int>(i) + 1;
+        WaveformData* pLevel = &m_summary[m_summaryLevelOffsets[i]];
+        // Only blocks that are complete now and haven't been complete before
+        const int blockStop = frames >> level;
+        for (int block = m_summarizedFrames >> level; block < blockStop; ++block) {
+            for (int chn = 0; chn < ChannelCount; ++chn) {
+                WaveformData maxima = pLowerLevel[block * 2 * ChannelCount + chn];
+                storeMaxima(&maxima, pLowerLevel[(block * 2 + 1) * ChannelCount + chn]);
+                pLevel[block * ChannelCount + chn] = maxima;
+            }
+        }
+        pLowerLevel = pLevel;
+    }
+    m_summarizedFrames = frames;
+}
+
+void Waveform::getMaxima(int frameStart, int frameStop, WaveformData* pMaxima) const {
+    pMaxima[Left] = {};
+    pMaxima[Right] = {};
+    frameStop = math_min(frameStop, m_dataSize / ChannelCount);
+    // Blocks that are not complete yet have not been summarized
+    const int summarizedStop = math_min(frameStop, getCompletion() / ChannelCount);
+    const int numLevels = static_cast<int>(m_summaryLevelOffsets.size());
+    int frame = math_max(frameStart, 0);
+    while (frame < frameStop) {
+        // The largest aligned block that starts at this frame
+        int level = 0;
+        while (level < numLevels &&
+                (frame & ((2 << level) - 1)) == 0 &&
+                frame + (2 << level) <= summarizedStop) {
+            ++level;
+        }
+        const WaveformData* pBlock = level == 0
+                ? &m_data[frame * ChannelCount]
+                : &m_summary[m_summaryLevelOffsets[level - 1] +
+                          (frame >> level) * ChannelCount];
+        storeMaxima(&pMaxima[Left], pBlock[Left]);
+        storeMaxima(&pMaxima[Right], pBlock[Right]);
+        frame += 1 << level;
+    }
+}
+
 void Waveform::dump() const {
     qDebug() << "Waveform" << this
              << "size(" + QString::number(getDataSize()) + ")"
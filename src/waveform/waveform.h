@@ -79,6 +79,9 @@ class Waveform {
         m_description = description;
     }
 
+    // Serializes the waveform in a versioned binary format with a small
+    // header followed by the data elements in their in-memory layout.
+    // The legacy protobuf format is still accepted when reading.
     QByteArray toByteArray() const;
 
     SaveState saveState() const {
@@ -102,9 +105,9 @@ class Waveform {
     int getCompletion() const {
         return m_completion.loadAcquire();
     }
-    void setCompletion(int completion) {
-        m_completion = completion;
-    }
+    // Also extends the summary levels up to the new completion before
+    // publishing it. Must only be invoked by the single writer.
+    void setCompletion(int completion);
 
     // We do not lock the mutex since m_textureStride is not changed after
     // the constructor runs.
@@ -137,12 +140,25 @@ class Waveform {
         return m_stemCount > 0;
     }
 
+    // Stores the maxima of all signals within the visual frames
+    // [frameStart, frameStop), i.e. pairs of left and right data
+    // elements, per channel in pMaxima[Left] and pMaxima[Right].
+    //
+    // Instead of visiting every data element the summary levels are
+    // used. Only O(log(frameStop - frameStart)) elements need to be
+    // visited, which keeps the cost per pixel constant when zoomed out.
+    void getMaxima(int frameStart, int frameStop, WaveformData* pMaxima) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readBinaryByteArray(const QByteArray& data);
+    void readProtobufByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size);
+    void allocateSummary();
+    void updateSummary(int completion);
 
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
@@ -178,6 +194,19 @@ class Waveform {
     // stride is N. Not allowed to change after the constructor runs.
     int m_textureStride;
 
+    // A pyramid of the maxima of m_data. Level n >= 1 contains the maxima
+    // of blocks of 2^n visual frames, interleaved left / right like m_data.
+    // Incomplete blocks at the end are omitted. The size is not allowed
+    // to change after the constructor runs. Blocks are only written before
+    // the completion that covers them is published.
+    std::vector<WaveformData> m_summary;
+    // The index of the first element of each level in m_summary,
+    // starting with level 1.
+    std::vector<int> m_summaryLevelOffsets;
+    // The number of visual frames that have been summarized. Only
+    // accessed by the writer.
+    int m_summarizedFrames;
+
     // For performance, completion is shared as a QAtomicInt and does not lock
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
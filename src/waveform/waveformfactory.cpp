@@ -18,6 +18,12 @@ WaveformFactory::VersionClass WaveformFactory::waveformVersionToVersionClass(con
         return VC_USE;
     }
 
+    if (version == WAVEFORM_PROTOBUF_VERSION) {
+        // Same values in the protobuf format used up to the Mixxx 2.6
+        // pre-releases
+        return VC_UPGRADE;
+    }
+
     if (version == WAVEFORM_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug #7776
         return VC_REMOVE;
@@ -52,6 +58,12 @@ WaveformFactory::VersionClass WaveformFactory::waveformSummaryVersionToVersionCl
         return VC_USE;
     }
 
+    if (version == WAVEFORMSUMMARY_PROTOBUF_VERSION) {
+        // Same values in the protobuf format used up to the Mixxx 2.6
+        // pre-releases
+        return VC_UPGRADE;
+    }
+
     if (version == WAVEFORMSUMMARY_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug #7776
         return VC_REMOVE;
@@ -35,20 +35,37 @@ class Waveform;
 #define WAVEFORMSUMMARY_6_VERSION "WaveformSummary-6.1"
 #define WAVEFORM_6_DESCRIPTION "Waveform 6.1"
 #define WAVEFORMSUMMARY_6_DESCRIPTION "WaveformSummary 6.1"
+#endif
+
+// Used from Mixxx 2.6 with the binary format of Waveform::toByteArray()
+// instead of protobuf. The values are the same as in 5.0 and 6.1, which
+// are upgraded by converting the format when loading them.
+#define WAVEFORM_5_1_VERSION "Waveform-5.1"
+#define WAVEFORMSUMMARY_5_1_VERSION "WaveformSummary-5.1"
+#define WAVEFORM_5_1_DESCRIPTION "Waveform 5.1"
+#define WAVEFORMSUMMARY_5_1_DESCRIPTION "WaveformSummary 5.1"
+#ifdef __STEM__
+#define WAVEFORM_6_2_VERSION "Waveform-6.2"
+#define WAVEFORM_6_2_DESCRIPTION "Waveform 6.2"
 
-#define WAVEFORM_CURRENT_VERSION WAVEFORM_6_VERSION
-#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_6_DESCRIPTION
+#define WAVEFORM_CURRENT_VERSION WAVEFORM_6_2_VERSION
+#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_6_2_DESCRIPTION
+#define WAVEFORM_PROTOBUF_VERSION WAVEFORM_6_VERSION
 #else
-#define WAVEFORM_CURRENT_VERSION WAVEFORM_5_VERSION
-#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_5_DESCRIPTION
+#define WAVEFORM_CURRENT_VERSION WAVEFORM_5_1_VERSION
+#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_5_1_DESCRIPTION
+#define WAVEFORM_PROTOBUF_VERSION WAVEFORM_5_VERSION
 #endif
-#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_5_VERSION
-#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_5_DESCRIPTION
+#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_5_1_VERSION
+#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_5_1_DESCRIPTION
+#define WAVEFORMSUMMARY_PROTOBUF_VERSION WAVEFORMSUMMARY_5_VERSION
 
 class WaveformFactory {
   public:
     enum VersionClass {
         VC_USE,
+        // Use and store again in the current format
+        VC_UPGRADE,
         VC_KEEP,
         VC_REMOVE
     };
@@ -10,14 +10,18 @@
 #include <QGLShaderProgram>
 #endif
 
+#include <QFuture>
 #include <QOpenGLFunctions>
 #include <QRegularExpression>
 #include <QStringList>
+#include <QThread>
 #include <QWidget>
 #include <QWindow>
+#include <QtConcurrentRun>
 
 #include "moc_waveformwidgetfactory.cpp"
 #include "util/cmdlineargs.h"
+#include "util/event.h"
 #include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
@@ -59,6 +63,15 @@ bool shouldRenderWaveform(WaveformWidgetAbstract* pWaveformWidget) {
 }
 
 const QRegularExpression openGLVersionRegex(QStringLiteral("^(\\d+)\\.(\\d+).*$"));
+
+// Usually no more than 4 decks are visible
+constexpr int kMaxRenderPrepThreads = 4;
+
+constexpr Stat::ComputeFlags kFrameTimeComputeFlags =
+        kDefaultComputeFlags | Stat::HISTOGRAM | Stat::TIMELINE;
+
+const QString kRenderStatKey = QStringLiteral("WaveformWidgetFactory::render() GUI thread");
+const QString kPrepareRenderStatKey = QStringLiteral("WaveformWidgetFactory::prepareRender()");
 }  // anonymous namespace
 
 ///////////////////////////////////////////
@@ -82,7 +95,10 @@ WaveformWidgetHolder::WaveformWidgetHolder(WaveformWidgetAbstract* waveformWidge
     : m_waveformWidget(waveformWidget),
       m_waveformViewer(waveformViewer),
       m_skinNodeCache(node.cloneNode()),
-      m_skinContextCache(&parentContext) {
+      m_skinContextCache(&parentContext),
+      m_missedVSyncStatKey(
+              QStringLiteral("WaveformWidgetFactory %1 missed vsync")
+                      .arg(waveformViewer->getGroup())) {
 }
 
 ///////////////////////////////////////////
@@ -120,6 +136,9 @@ WaveformWidgetFactory::WaveformWidgetFactory()
     m_visualGain[Mid] = 1.0;
     m_visualGain[High] = 1.0;
 
+    m_renderPrepThreadPool.setMaxThreadCount(
+            math_clamp(QThread::idealThreadCount() - 1, 1, kMaxRenderPrepThreads));
+
 #ifdef MIXXX_USE_QOPENGL
     WGLWidget* widget = SharedGLContext::getWidget();
     if (widget) {
@@ -730,9 +749,18 @@ void WaveformWidgetFactory::renderSelf() {
 
     if (!m_skipRender) {
         if (m_type) {   // no regular updates for an empty waveform
+            Timer frameTimer(kRenderStatKey, kFrameTimeComputeFlags);
+            frameTimer.start();
+            PerformanceTimer frameStart;
+            frameStart.start();
+            // The frame is displayed with the next vsync, unless rendering
+            // takes longer
+            const auto untilVSync = m_vsyncThread->fromTimerToNextSync(frameStart);
             // next rendered frame is displayed after next buffer swap and than after VSync
             QVarLengthArray<bool, 10> shouldRenderWaveforms(
                     static_cast<int>(m_waveformWidgetHolders.size()));
+            QVarLengthArray<QFuture<void>, 10> renderPreparations(
+                    static_cast<int>(m_waveformWidgetHolders.size()));
             for (decltype(m_waveformWidgetHolders)::size_type i = 0;
                     i < m_waveformWidgetHolders.size();
                     i++) {
@@ -746,6 +774,15 @@ void WaveformWidgetFactory::renderSelf() {
                 }
                 // Calculate play position for the new Frame in following run
                 pWaveformWidget->preRender(m_vsyncThread);
+                // Generate the geometry off the GUI thread, concurrently
+                // with the pre-rendering and rendering of the other widgets
+                renderPreparations[static_cast<int>(i)] = QtConcurrent::run(
+                        &m_renderPrepThreadPool, [pWaveformWidget]() {
+                            Timer timer(kPrepareRenderStatKey, kFrameTimeComputeFlags);
+                            timer.start();
+                            pWaveformWidget->prepareRender();
+                            timer.elapsed(true);
+                        });
             }
             //qDebug() << "prerender" << m_vsyncThread->elapsed();
 
@@ -759,9 +796,14 @@ void WaveformWidgetFactory::renderSelf() {
                 if (!shouldRenderWaveforms[static_cast<int>(i)]) {
                     continue;
                 }
+                renderPreparations[static_cast<int>(i)].waitForFinished();
                 pWaveformWidget->render();
+                if (frameStart.elapsed().toIntegerMicros() > untilVSync.count()) {
+                    Event::event(m_waveformWidgetHolders[i].m_missedVSyncStatKey);
+                }
                 //qDebug() << "render" << i << m_vsyncThread->elapsed();
             }
+            frameTimer.elapsed(true);
         }
 
         // WSpinnys are also double-buffered WGLWidgets, like all the waveform
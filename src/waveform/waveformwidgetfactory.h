@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QSurfaceFormat>
+#include <QThreadPool>
 #include <QVector>
 #include <vector>
 
@@ -98,6 +99,7 @@ class WaveformWidgetHolder {
     WWaveformViewer* m_waveformViewer;
     QDomNode m_skinNodeCache;
     SkinContext m_skinContextCache;
+    QString m_missedVSyncStatKey;
 
     friend class WaveformWidgetFactory;
 };
@@ -299,6 +301,8 @@ class WaveformWidgetFactory : public QObject,
     int m_beatGridAlpha;
 
     VSyncThread* m_vsyncThread;
+    // Runs WaveformWidgetAbstract::prepareRender() off the GUI thread
+    QThreadPool m_renderPrepThreadPool;
     GuiTick* m_pGuiTick;  // not owned
     VisualsManager* m_pVisualsManager;  // not owned
 
@@ -28,7 +28,8 @@ WaveformWidget::WaveformWidget(QWidget* parent,
         WaveformRendererSignalBase::Options options)
         : WGLWidget(parent),
           WaveformWidgetAbstract(group),
-          m_pWaveformRendererSignal(nullptr) {
+          m_pWaveformRendererSignal(nullptr),
+          m_renderPrepared(false) {
     auto pTopNode = std::make_unique<rendergraph::Node>();
     auto pOpacityNode = std::make_unique<rendergraph::OpacityNode>();
 
@@ -45,7 +46,7 @@ WaveformWidget::WaveformWidget(QWidget* parent,
     // The following two renderers work in tandem: if the rendered waveform is
     // for a stem track, WaveformRendererSignalBase will skip rendering and let
     // WaveformRendererStem do the rendering, and vice-versa.
-    pOpacityNode->appendChildNode(addRendererNode<WaveformRendererStem>());
+    takeOverPreprocess(pOpacityNode->appendChildNode(addRendererNode<WaveformRendererStem>()));
 #endif
     std::unique_ptr<WaveformRendererSignalBase> pWaveformRendererSignal = addWaveformSignalRenderer(
             type, options, ::WaveformRendererAbstract::Play);
@@ -53,7 +54,8 @@ WaveformWidget::WaveformWidget(QWidget* parent,
     if (pWaveformRendererSignal) {
         auto* pNode = dynamic_cast<rendergraph::BaseNode*>(pWaveformRendererSignal.release());
         DEBUG_ASSERT(pNode);
-        pOpacityNode->appendChildNode(std::unique_ptr<rendergraph::BaseNode>(pNode));
+        takeOverPreprocess(pOpacityNode->appendChildNode(
+                std::unique_ptr<rendergraph::BaseNode>(pNode)));
     }
     pOpacityNode->appendChildNode(addRendererNode<WaveformRenderBeat>());
     m_pWaveformRenderMark = pOpacityNode->appendChildNode(addRendererNode<WaveformRenderMark>());
@@ -67,15 +69,16 @@ WaveformWidget::WaveformWidget(QWidget* parent,
                 addRendererNode<WaveformRendererPreroll>(
                         ::WaveformRendererAbstract::Slip));
 #ifdef __STEM__
-        pOpacityNode->appendChildNode(
+        takeOverPreprocess(pOpacityNode->appendChildNode(
                 addRendererNode<WaveformRendererStem>(
-                        ::WaveformRendererAbstract::Slip));
+                        ::WaveformRendererAbstract::Slip)));
 #endif
         std::unique_ptr<WaveformRendererSignalBase> pSlipNode = addWaveformSignalRenderer(
                 type, options, ::WaveformRendererAbstract::Slip);
         auto* pNode = dynamic_cast<rendergraph::BaseNode*>(pSlipNode.release());
         DEBUG_ASSERT(pNode);
-        pOpacityNode->appendChildNode(std::unique_ptr<rendergraph::BaseNode>(pNode));
+        takeOverPreprocess(pOpacityNode->appendChildNode(
+                std::unique_ptr<rendergraph::BaseNode>(pNode)));
         pOpacityNode->appendChildNode(
                 addRendererNode<WaveformRenderBeat>(
                         ::WaveformRendererAbstract::Slip));
@@ -99,6 +102,18 @@ WaveformWidget::~WaveformWidget() {
     doneCurrent();
 }
 
+void WaveformWidget::takeOverPreprocess(rendergraph::BaseNode* pNode) {
+    // Only the signal renderers, which don't access widgets or OpenGL
+    // while preprocessing. Must be invoked before the engine is created.
+    DEBUG_ASSERT(!m_pEngine);
+    if (!pNode->usePreprocess()) {
+        // e.g. WaveformRendererTextured
+        return;
+    }
+    pNode->setUsePreprocess(false);
+    m_pSignalNodes.push_back(pNode);
+}
+
 std::unique_ptr<WaveformRendererSignalBase>
 WaveformWidget::addWaveformSignalRenderer(WaveformWidgetType::Type type,
         WaveformRendererSignalBase::Options options,
@@ -146,6 +161,17 @@ mixxx::Duration WaveformWidget::render() {
     return mixxx::Duration();
 }
 
+void WaveformWidget::prepareRender() {
+    preprocessSignals();
+    m_renderPrepared = true;
+}
+
+void WaveformWidget::preprocessSignals() {
+    for (auto* pNode : m_pSignalNodes) {
+        pNode->preprocess();
+    }
+}
+
 void WaveformWidget::paintGL() {
     // opacity of 0.f effectively skips the subtree rendering
     m_pOpacityNode->setOpacity(shouldOnlyDrawBackground() ? 0.f : 1.f);
@@ -153,6 +179,10 @@ void WaveformWidget::paintGL() {
     m_pWaveformRenderMark->update();
     m_pWaveformRenderMarkRange->update();
 
+    if (!m_renderPrepared) {
+        preprocessSignals();
+    }
+    m_renderPrepared = false;
     m_pEngine->preprocess();
     m_pEngine->render();
 }
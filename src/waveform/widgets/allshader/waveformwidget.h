@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "rendergraph/engine.h"
 #include "rendergraph/opacitynode.h"
 #include "waveform/renderers/allshader/waveformrenderersignalbase.h"
@@ -29,7 +31,8 @@ class allshader::WaveformWidget final : public ::WGLWidget,
 
     void resizeRenderer(int width, int height, float devicePixelRatio) override;
 
-    // override for WaveformWidgetAbstract
+    // overrides for WaveformWidgetAbstract
+    void prepareRender() override;
     mixxx::Duration render() override;
 
     // overrides for WGLWidget
@@ -59,6 +62,11 @@ class allshader::WaveformWidget final : public ::WGLWidget,
         return std::unique_ptr<T_Renderer>(pRenderer);
     }
 
+    /// Excludes the node from the preprocessing by the engine. It is
+    /// preprocessed by prepareRender() on a worker thread instead.
+    void takeOverPreprocess(rendergraph::BaseNode* pNode);
+    void preprocessSignals();
+
     std::unique_ptr<allshader::WaveformRendererSignalBase> addWaveformSignalRenderer(
             WaveformWidgetType::Type type,
             WaveformRendererSignalBase::Options options,
@@ -70,6 +78,9 @@ class allshader::WaveformWidget final : public ::WGLWidget,
     WaveformRenderMark* m_pWaveformRenderMark;
     WaveformRenderMarkRange* m_pWaveformRenderMarkRange;
     WaveformRendererSignalBase* m_pWaveformRendererSignal;
+    // The nodes that are preprocessed by prepareRender()
+    std::vector<rendergraph::BaseNode*> m_pSignalNodes;
+    bool m_renderPrepared;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformWidget);
 };
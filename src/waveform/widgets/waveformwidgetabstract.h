@@ -35,6 +35,12 @@ class WaveformWidgetAbstract : public WaveformWidgetRenderer {
     void release();
 
     virtual void preRender(VSyncThread* vsyncThread);
+    /// Prepares the next render() after preRender(), e.g. by generating
+    /// geometry. Invoked on a worker thread and must neither access the
+    /// widget nor any graphics API. The factory waits until it has
+    /// finished before invoking render().
+    virtual void prepareRender() {
+    }
     virtual mixxx::Duration render();
     virtual void resize(int width, int height);
 